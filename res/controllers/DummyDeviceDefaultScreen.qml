@@ -39,8 +39,8 @@ Mixxx.ControllerScreen {
         loader.sourceComponent = splash
     }
 
-    // function transformFrame(input: ArrayBuffer, timestamp: date) {
-    transformFrame: function(input, timestamp) {
+    // function transformFrame(input: ArrayBuffer, timestamp: date, changedAreas: Array) {
+    transformFrame: function(input, timestamp, changedAreas) {
         return new ArrayBuffer(0);
     }
 
@@ -26,8 +26,6 @@ Mixxx.ControllerScreen {
 
     readonly property bool isStockTheme: theme == "stock"
 
-    property var lastFrame: null
-
     init: function(_controllerName, isDebug) {
         console.log(`Screen ${root.screenId} has started with theme ${root.theme}`)
         root.state = "Live"
@@ -38,60 +36,19 @@ Mixxx.ControllerScreen {
         root.state = "Stop"
     }
 
-    transformFrame: function(input, timestamp) {
-        let updated = new Uint8Array(320*240);
-        updated.fill(0)
-
+    transformFrame: function(input, timestamp, changedAreas) {
         let updatedPixelCount = 0;
         let updated_zones = [];
 
-        if (!root.lastFrame) {
-            root.lastFrame = new ArrayBuffer(input.byteLength);
-            updatedPixelCount = input.byteLength / 2;
+        for (const area of changedAreas) {
+            updatedPixelCount += area.width * area.height;
             updated_zones.push({
-                    x: 0,
-                    y: 0,
-                    width: 320,
-                    height: 240,
+                    x: area.x,
+                    y: area.y,
+                    width: area.width,
+                    height: area.height,
             })
-        } else {
-            const view_input = new Uint8Array(input);
-            const view_last = new Uint8Array(root.lastFrame);
-
-            for (let i = 0; i < 320 * 240; i++) {
-            }
-
-            let current_rect = null;
-
-            for (let y = 0; y < 240; y++) {
-                let line_changed = false;
-                for (let x = 0; x < 320; x++) {
-                    let i = y * 320 + x;
-                    if (view_input[2 * i] != view_last[2 * i] || view_input[2 * i + 1] != view_last[2 * i + 1]) {
-                        line_changed = true;
-                        updatedPixelCount++;
-                        break;
-                    }
-                }
-                if (current_rect !== null && line_changed) {
-                    current_rect.height++;
-                } else if (current_rect !== null) {
-                    updated_zones.push(current_rect);
-                    current_rect = null;
-                } else if (current_rect === null && line_changed) {
-                    current_rect = {
-                        x: 0,
-                        y,
-                        width: 320,
-                        height: 1,
-                    };
-                }
-            }
-            if (current_rect !== null) {
-                updated_zones.push(current_rect);
-            }
         }
-        new Uint8Array(root.lastFrame).set(new Uint8Array(input));
 
         if (!updatedPixelCount) {
             return new ArrayBuffer(0);
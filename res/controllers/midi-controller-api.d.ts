@@ -1,4 +1,12 @@
-type MidiInputHandler = (channel: number, control: number, value: number, status: number, group: string) => void;
+/**
+ * Script function of a script binding in the mapping XML
+ *
+ * @param values For bindings with the `<coalesce/>` option, all values received since the previous call.
+ *               `value` is the latest of them. Relative controls like jog wheels must decode each of these
+ *               values into a signed delta, e.g. from 7-bit two's complement (`value - 0x80` for values
+ *               from 0x40) or from an offset of 0x40 (`value - 0x40`), before summing them up.
+ */
+type MidiInputHandler = (channel: number, control: number, value: number, status: number, group: string, values?: number[]) => void;
 
 declare interface MidiInputHandlerController {
     disconnect(): boolean;
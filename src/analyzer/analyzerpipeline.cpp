@@ -0,0 +1,89 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <algorithm>
+
+#include "analyzer/constants.h"
+#include "util/assert.h"
+#include "util/math.h"
+
+AnalyzerTask::AnalyzerTask(AnalyzerWithState* pAnalyzer)
+        : QRunnable(),
+          m_completedSema(0),
+          m_pAnalyzer(pAnalyzer),
+          m_pIn(nullptr),
+          m_count(0) {
+    DEBUG_ASSERT(m_pAnalyzer);
+    setAutoDelete(false);
+}
+
+void AnalyzerTask::set(const CSAMPLE* pIn, SINT count) {
+    DEBUG_ASSERT(m_completedSema.available() == 0);
+    m_pIn = pIn;
+    m_count = count;
+}
+
+void AnalyzerTask::waitReady() {
+    m_completedSema.acquire();
+}
+
+void AnalyzerTask::run() {
+    VERIFY_OR_DEBUG_ASSERT(m_completedSema.available() == 0 && m_pIn) {
+        m_completedSema.release();
+        return;
+    };
+    m_pAnalyzer->processSamples(m_pIn, static_cast<int>(m_count));
+    m_completedSema.release();
+}
+
+AnalyzerPipeline::AnalyzerPipeline(
+        std::vector<AnalyzerWithState>* pAnalyzers,
+        QThread::Priority threadPriority)
+        : m_buffers{mixxx::SampleBuffer(mixxx::kAnalysisSamplesPerChunk),
+                  mixxx::SampleBuffer(mixxx::kAnalysisSamplesPerChunk)},
+          m_nextBufferIndex(0),
+          m_busy(false) {
+    DEBUG_ASSERT(pAnalyzers);
+    m_tasks.reserve(pAnalyzers->size());
+    for (auto& analyzer : *pAnalyzers) {
+        m_tasks.push_back(std::make_unique<AnalyzerTask>(&analyzer));
+    }
+    m_pool.setObjectName(QStringLiteral("AnalyzerPipeline"));
+    m_pool.setThreadPriority(threadPriority);
+    m_pool.setMaxThreadCount(static_cast<int>(m_tasks.size()));
+}
+
+AnalyzerPipeline::~AnalyzerPipeline() {
+    waitReady();
+    m_pool.waitForDone();
+}
+
+void AnalyzerPipeline::processSamples(const CSAMPLE* pIn, SINT count) {
+    waitReady();
+    auto& buffer = m_buffers[m_nextBufferIndex];
+    VERIFY_OR_DEBUG_ASSERT(pIn >= buffer.data() &&
+            pIn + count <= buffer.data() + buffer.size()) {
+        // The analyzers must not read from a buffer that might be
+        // overwritten while decoding the next chunk.
+        DEBUG_ASSERT(count <= buffer.size());
+        std::copy(pIn, pIn + math_min(count, buffer.size()), buffer.data());
+        pIn = buffer.data();
+    }
+    for (const auto& pTask : m_tasks) {
+        pTask->set(pIn, count);
+        if (!m_pool.tryStart(pTask.get())) {
+            pTask->run();
+        }
+    }
+    m_busy = true;
+    m_nextBufferIndex = 1 - m_nextBufferIndex;
+}
+
+void AnalyzerPipeline::waitReady() {
+    if (!m_busy) {
+        return;
+    }
+    for (const auto& pTask : m_tasks) {
+        pTask->waitReady();
+    }
+    m_busy = false;
+}
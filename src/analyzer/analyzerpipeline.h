@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <memory>
+#include <vector>
+
+#include "analyzer/analyzer.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+/// AnalyzerTask feeds a single chunk of decoded audio data into
+/// one analyzer. It is either run by a thread of the pool owned by
+/// AnalyzerPipeline or inline, if no thread is available.
+class AnalyzerTask : public QRunnable {
+  public:
+    explicit AnalyzerTask(AnalyzerWithState* pAnalyzer);
+
+    /// The samples must remain valid and unmodified till
+    /// waitReady() has returned.
+    void set(const CSAMPLE* pIn, SINT count);
+
+    /// Wait for the current task to complete.
+    void waitReady();
+
+    void run() override;
+
+  private:
+    // Whether or not the scheduled job has completed
+    QSemaphore m_completedSema;
+
+    AnalyzerWithState* const m_pAnalyzer;
+    const CSAMPLE* m_pIn;
+    SINT m_count;
+};
+
+/// AnalyzerPipeline decouples decoding from analyzing. The analyzer thread
+/// decodes the next chunk of audio data into one buffer, while all analyzers
+/// concurrently process the previous chunk from the other, read-only buffer.
+/// Each analyzer still receives the chunks in order, one at a time.
+///
+/// The analysis of a track is then bound by the slowest analyzer instead of
+/// the sum of all analyzers and the decoder.
+class AnalyzerPipeline {
+  public:
+    AnalyzerPipeline(
+            std::vector<AnalyzerWithState>* pAnalyzers,
+            QThread::Priority threadPriority);
+    ~AnalyzerPipeline();
+
+    /// The buffer for decoding the next chunk. It is not accessed by
+    /// any analyzer until the chunk is passed to processSamples().
+    mixxx::SampleBuffer& nextBuffer() {
+        return m_buffers[m_nextBufferIndex];
+    }
+
+    /// Waits until all analyzers have processed the previous chunk and
+    /// then dispatches the given chunk to all analyzers without waiting
+    /// for the results.
+    void processSamples(const CSAMPLE* pIn, SINT count);
+
+    /// Waits until all analyzers have processed all dispatched chunks.
+    /// Must be called before finishing or cancelling the analysis.
+    void waitReady();
+
+  private:
+    QThreadPool m_pool;
+    std::vector<std::unique_ptr<AnalyzerTask>> m_tasks;
+    mixxx::SampleBuffer m_buffers[2];
+    int m_nextBufferIndex;
+    bool m_busy;
+};
@@ -6,6 +6,7 @@
 #include "analyzer/analyzerebur128.h"
 #include "analyzer/analyzergain.h"
 #include "analyzer/analyzerkey.h"
+#include "analyzer/analyzerpipeline.h"
 #include "analyzer/analyzersilence.h"
 #include "analyzer/analyzerwaveform.h"
 #include "analyzer/constants.h"
@@ -34,6 +35,10 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+// Decode and analyze concurrently, see AnalyzerPipeline.
+const ConfigKey kPipelinedAnalysisConfigKey =
+        ConfigKey(QStringLiteral("[Library]"), QStringLiteral("pipelined_analysis"));
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -87,6 +92,8 @@ AnalyzerThread::AnalyzerThread(
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
 
+AnalyzerThread::~AnalyzerThread() = default;
+
 void AnalyzerThread::doRun() {
     std::unique_ptr<AnalysisDao> pAnalysisDao;
     // The thread-local database connection  must not be closed
@@ -118,6 +125,14 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
 
+    if (m_pConfig->getValue(kPipelinedAnalysisConfigKey, false)) {
+        // The pool threads inherit the priority of this thread, i.e. batch
+        // analysis in the background is still done with low priority.
+        m_pPipeline = std::make_unique<AnalyzerPipeline>(
+                &m_analyzers, QThread::currentThread()->priority());
+        kLogger.debug() << "Decoding and analyzing concurrently";
+    }
+
     m_lastBusyProgressEmittedTimer.start();
 
     mixxx::AudioSource::OpenParams openParams;
@@ -160,6 +175,11 @@ void AnalyzerThread::doRun() {
         if (processTrack) {
             const auto analysisResult = analyzeAudioSource(audioSource);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
+            if (m_pPipeline) {
+                // All chunks must have been processed before finishing
+                // or cancelling the analysis.
+                m_pPipeline->waitReady();
+            }
             if (analysisResult == AnalysisResult::Finished) {
                 // The analysis has been finished, and is either complete without
                 // any errors or partial if it has been aborted due to a corrupt
@@ -187,6 +207,8 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(!m_currentTrack);
     DEBUG_ASSERT(isStopping());
 
+    // The pipeline references the analyzers
+    m_pPipeline.reset();
     m_analyzers.clear();
 
     kLogger.debug() << "Exiting worker thread";
@@ -250,11 +272,13 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
         // Request the next chunk of audio data
+        mixxx::SampleBuffer& sampleBuffer =
+                m_pPipeline ? m_pPipeline->nextBuffer() : m_sampleBuffer;
         const auto readableSampleFrames =
                 audioSource->readSampleFrames(
                         mixxx::WritableSampleFrames(
                                 chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+                                mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange().isSubrangeOf(chunkFrameRange));
 
@@ -299,10 +323,18 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
         // 2nd: step: Analyze chunk of decoded audio data
         if (!readableSampleFrames.frameIndexRange().empty()) {
-            for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
+            if (m_pPipeline) {
+                // Continue with decoding the next chunk while the
+                // analyzers process this chunk in the background.
+                m_pPipeline->processSamples(
                         readableSampleFrames.readableData(),
                         readableSampleFrames.readableLength());
+            } else {
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processSamples(
+                            readableSampleFrames.readableData(),
+                            readableSampleFrames.readableLength());
+                }
             }
         }
 
@@ -17,6 +17,8 @@
 #include "util/samplebuffer.h"
 #include "util/workerthread.h"
 
+class AnalyzerPipeline;
+
 enum AnalyzerModeFlags {
     None = 0x00,
     WithBeats = 0x01,
@@ -66,7 +68,7 @@ class AnalyzerThread : public WorkerThread {
             mixxx::DbConnectionPoolPtr dbConnectionPool,
             UserSettingsPointer pConfig,
             AnalyzerModeFlags modeFlags);
-    ~AnalyzerThread() override = default;
+    ~AnalyzerThread() override;
 
     int id() const {
         return m_id;
@@ -120,6 +122,9 @@ class AnalyzerThread : public WorkerThread {
 
     mixxx::SampleBuffer m_sampleBuffer;
 
+    // Only used if decoding and analyzing is pipelined
+    std::unique_ptr<AnalyzerPipeline> m_pPipeline;
+
     std::optional<AnalyzerTrack> m_currentTrack;
 
     AnalyzerThreadState m_emittedState;
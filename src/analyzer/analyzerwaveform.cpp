@@ -324,6 +324,7 @@ void AnalyzerWaveform::storeResults(TrackPointer pTrack) {
     if (m_waveform) {
         m_waveform->setSaveState(Waveform::SaveState::SavePending);
         m_waveform->setCompletion(m_waveform->getDataSize());
+        m_waveform->buildDecimatedLevels();
         m_waveform->setVersion(WaveformFactory::currentWaveformVersion());
         m_waveform->setDescription(WaveformFactory::currentWaveformDescription());
     }
@@ -1,5 +1,7 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <algorithm>
+
 #include "analyzer/analyzerscheduledtrack.h"
 #include "analyzer/analyzertrack.h"
 #include "moc_trackanalysisscheduler.cpp"
@@ -57,7 +59,8 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
           // The first signal should always be emitted
-          m_lastProgressEmittedAt(Clock::now() - kProgressInhibitDuration) {
+          m_lastProgressEmittedAt(Clock::now() - kProgressInhibitDuration),
+          m_analysisStartedAt(Clock::now()) {
     DEBUG_ASSERT(m_pEnvironment);
     VERIFY_OR_DEBUG_ASSERT(numWorkerThreads > 0) {
             kLogger.warning()
@@ -95,9 +98,39 @@ TrackAnalysisScheduler::~TrackAnalysisScheduler() {
 }
 
 void TrackAnalysisScheduler::emitProgressOrFinished() {
+    const auto now = Clock::now();
+    DEBUG_ASSERT(m_pendingTrackIds.size() <=
+            static_cast<size_t>(m_dequeuedTracksCount));
+    const int finishedTracksCount =
+            m_dequeuedTracksCount - static_cast<int>(m_pendingTrackIds.size());
+
+    // Throughput and busy workers since the first track has been dequeued
+    double tracksPerMinute = 0.0;
+    double workerBusyRatio = 0.0;
+    const std::chrono::duration<double> elapsed = now - m_analysisStartedAt;
+    if (m_dequeuedTracksCount > 0 && elapsed.count() > 0.0 && !m_workers.empty()) {
+        tracksPerMinute = finishedTracksCount * 60.0 / elapsed.count();
+        Clock::duration busyDuration = Clock::duration::zero();
+        for (const auto& worker : m_workers) {
+            busyDuration += worker.busyDuration(now);
+        }
+        workerBusyRatio = std::chrono::duration<double>(busyDuration).count() /
+                (elapsed.count() * m_workers.size());
+    }
+
     // The finished() signal is emitted regardless of when the last
     // signal has been emitted
     if (allTracksFinished()) {
+        if (m_dequeuedTracksCount > 0) {
+            kLogger.info()
+                    << "Finished analysis of"
+                    << finishedTracksCount
+                    << "tracks:"
+                    << tracksPerMinute
+                    << "tracks/min,"
+                    << workerBusyRatio * 100
+                    << "% worker busy";
+        }
         m_currentTrackProgress = kAnalyzerProgressUnknown;
         m_currentTrackNumber = 0;
         m_dequeuedTracksCount = 0;
@@ -105,18 +138,12 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
         return;
     }
 
-    const auto now = Clock::now();
     if (now < (m_lastProgressEmittedAt + kProgressInhibitDuration)) {
         // Inhibit signal
         return;
     }
     m_lastProgressEmittedAt = now;
 
-    DEBUG_ASSERT(m_pendingTrackIds.size() <=
-            static_cast<size_t>(m_dequeuedTracksCount));
-    const int finishedTracksCount =
-            m_dequeuedTracksCount - static_cast<int>(m_pendingTrackIds.size());
-
     AnalyzerProgress workerProgressSum = 0;
     int workerProgressCount = 0;
     for (const auto& worker: m_workers) {
@@ -176,7 +203,9 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
     emit progress(
             m_currentTrackProgress,
             m_currentTrackNumber,
-            totalTracksCount);
+            totalTracksCount,
+            tracksPerMinute,
+            workerBusyRatio);
 }
 
 void TrackAnalysisScheduler::onWorkerThreadProgress(
@@ -221,6 +250,7 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
             m_pendingTrackIds.erase(trackId);
             worker.onAnalyzerProgress(analyzerProgress);
+            worker.onTrackDone(Clock::now());
             emit trackProgress(trackId, analyzerProgress);
         }
         break;
@@ -258,9 +288,54 @@ int TrackAnalysisScheduler::scheduleTracks(const QList<AnalyzerScheduledTrack>&
             ++scheduledCount;
         }
     }
+    if (scheduledCount > 0) {
+        sortQueuedTracksByEstimatedCost();
+    }
     return scheduledCount;
 }
 
+void TrackAnalysisScheduler::sortQueuedTracksByEstimatedCost() {
+    QSet<TrackId> trackIdsWithoutDuration;
+    for (const auto& track : m_queuedTracks) {
+        if (!m_queuedTrackDurations.contains(track.getTrackId())) {
+            trackIdsWithoutDuration.insert(track.getTrackId());
+        }
+    }
+    const auto loadedDurations =
+            m_pEnvironment->loadTrackDurationsSeconds(trackIdsWithoutDuration);
+    for (auto it = loadedDurations.constBegin(); it != loadedDurations.constEnd(); ++it) {
+        m_queuedTrackDurations.insert(it.key(), it.value());
+    }
+    if (m_queuedTrackDurations.isEmpty()) {
+        // Nothing known about the tracks, keep the order
+        return;
+    }
+
+    // Tracks with an unknown duration are assumed to be of average length
+    double durationSum = 0.0;
+    for (const double duration : std::as_const(m_queuedTrackDurations)) {
+        durationSum += duration;
+    }
+    const double averageDuration = durationSum / m_queuedTrackDurations.size();
+
+    // All tracks are analyzed by the same analyzers, so the estimated cost
+    // of each track is proportional to its duration. Analyzing the longest
+    // tracks first keeps all workers busy until the end, instead of leaving
+    // them idle while the last worker is still busy with a long mix that has
+    // been dequeued last.
+    // Single tracks are not split into segments for multiple workers. Only
+    // the results of some analyzers like waveform, silence, and gain could
+    // be merged, while beats and key need the whole track. A long mix still
+    // occupies one worker for its whole duration.
+    std::stable_sort(m_queuedTracks.begin(),
+            m_queuedTracks.end(),
+            [this, averageDuration](const AnalyzerScheduledTrack& lhs,
+                    const AnalyzerScheduledTrack& rhs) {
+                return m_queuedTrackDurations.value(lhs.getTrackId(), averageDuration) >
+                        m_queuedTrackDurations.value(rhs.getTrackId(), averageDuration);
+            });
+}
+
 void TrackAnalysisScheduler::suspend() {
     kLogger.debug() << "Suspending";
     for (auto& worker: m_workers) {
@@ -288,7 +363,17 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                 AnalyzerTrack nextTrack(nextTrackPtr, nextScheduledTrack.getOptions());
                 if (m_pendingTrackIds.insert(nextTrackId).second) {
                     if (worker->submitNextTrack(std::move(nextTrack))) {
+                        const auto now = Clock::now();
+                        if (m_dequeuedTracksCount == 0) {
+                            // A new analysis has been started
+                            m_analysisStartedAt = now;
+                            for (auto& w : m_workers) {
+                                w.resetBusyDuration();
+                            }
+                        }
+                        worker->onTrackSubmitted(now);
                         m_queuedTracks.pop_front();
+                        m_queuedTrackDurations.remove(nextTrackId);
                         ++m_dequeuedTracksCount;
                         return true;
                     } else {
@@ -319,6 +404,7 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     << nextTrackId;
         }
         // Skip this track
+        m_queuedTrackDurations.remove(nextTrackId);
         m_queuedTracks.pop_front();
         ++m_dequeuedTracksCount;
     }
@@ -333,6 +419,7 @@ void TrackAnalysisScheduler::stop() {
     // The worker threads are still running at this point
     // and m_workers must not be modified!
     m_queuedTracks.clear();
+    m_queuedTrackDurations.clear();
     m_pendingTrackIds.clear();
     DEBUG_ASSERT((allTracksFinished()));
 }
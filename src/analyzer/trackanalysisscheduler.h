@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <deque>
 #include <memory>
 #include <set>
@@ -20,6 +22,14 @@ class TrackAnalysisSchedulerEnvironment {
     virtual ~TrackAnalysisSchedulerEnvironment() = default;
 
     virtual TrackPointer loadTrackById(TrackId trackId) const = 0;
+
+    /// Returns the durations of the given tracks in seconds, if known.
+    /// Used for estimating the costs of analyzing tracks.
+    virtual QHash<TrackId, double> loadTrackDurationsSeconds(
+            const QSet<TrackId>& trackIds) const {
+        Q_UNUSED(trackIds);
+        return {};
+    }
 };
 
 class TrackAnalysisScheduler : public QObject {
@@ -66,14 +76,23 @@ class TrackAnalysisScheduler : public QObject {
   signals:
     // Progress for individual tracks is passed-through from the workers
     void trackProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
-    // Current average progress for all scheduled tracks and from all workers
-    void progress(AnalyzerProgress currentTrackProgress, int currentTrackNumber, int totalTracksCount);
+    // Current average progress for all scheduled tracks and from all workers.
+    // The throughput is measured in finished tracks per minute. The busy
+    // ratio is the fraction of wall-clock time the workers have been busy
+    // with a track since the analysis has been started, not their CPU time.
+    void progress(AnalyzerProgress currentTrackProgress,
+            int currentTrackNumber,
+            int totalTracksCount,
+            double tracksPerMinute,
+            double workerBusyRatio);
     void finished();
 
   private slots:
     void onWorkerThreadProgress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress analyzerProgress);
 
   private:
+    typedef std::chrono::steady_clock Clock;
+
     // Owns an analyzer thread and buffers the most recent progress update
     // received from this thread during analysis. It does not need to be
     // thread-safe, because all functions are invoked from the host thread
@@ -82,7 +101,9 @@ class TrackAnalysisScheduler : public QObject {
       public:
         explicit Worker(AnalyzerThread::Pointer thread = AnalyzerThread::NullPointer())
             : m_thread(std::move(thread)),
-              m_analyzerProgress(kAnalyzerProgressUnknown) {
+              m_analyzerProgress(kAnalyzerProgressUnknown),
+              m_busy(false),
+              m_busyDuration(Clock::duration::zero()) {
         }
         Worker(const Worker&) = delete;
         Worker(Worker&&) = default;
@@ -132,14 +153,44 @@ class TrackAnalysisScheduler : public QObject {
             DEBUG_ASSERT(m_thread);
             m_thread.reset();
             m_analyzerProgress = kAnalyzerProgressUnknown;
+            onTrackDone(Clock::now());
+        }
+
+        void onTrackSubmitted(Clock::time_point now) {
+            if (!m_busy) {
+                m_busy = true;
+                m_busySince = now;
+            }
+        }
+
+        void onTrackDone(Clock::time_point now) {
+            if (m_busy) {
+                m_busy = false;
+                m_busyDuration += now - m_busySince;
+            }
+        }
+
+        Clock::duration busyDuration(Clock::time_point now) const {
+            if (m_busy) {
+                return m_busyDuration + (now - m_busySince);
+            }
+            return m_busyDuration;
+        }
+
+        void resetBusyDuration() {
+            m_busyDuration = Clock::duration::zero();
         }
 
       private:
         AnalyzerThread::Pointer m_thread;
         AnalyzerProgress m_analyzerProgress;
+        bool m_busy;
+        Clock::time_point m_busySince;
+        Clock::duration m_busyDuration;
     };
 
     bool submitNextTrack(Worker* worker);
+    void sortQueuedTracksByEstimatedCost();
     void emitProgressOrFinished();
 
     bool allTracksFinished() const {
@@ -153,6 +204,9 @@ class TrackAnalysisScheduler : public QObject {
 
     std::deque<AnalyzerScheduledTrack> m_queuedTracks;
 
+    // The durations of queued tracks in seconds, if known
+    QHash<TrackId, double> m_queuedTrackDurations;
+
     // Tracks that have already been submitted to workers
     // and not yet reported back as finished.
     std::set<TrackId> m_pendingTrackIds;
@@ -163,6 +217,7 @@ class TrackAnalysisScheduler : public QObject {
 
     int m_dequeuedTracksCount;
 
-    typedef std::chrono::steady_clock Clock;
     Clock::time_point m_lastProgressEmittedAt;
+
+    Clock::time_point m_analysisStartedAt;
 };
@@ -1,5 +1,7 @@
 #include "control/control.h"
 
+#include <atomic>
+
 #include "control/controlobject.h"
 #include "moc_control.cpp"
 #include "util/mutex.h"
@@ -39,6 +41,59 @@ QHash<ConfigKey, ConfigKey> s_qCOAliasHash
 
 /// is used instead of a nullptr, helps to omit null checks everywhere
 QWeakPointer<ControlDoublePrivate> s_pDefaultCO;
+
+/// Incremented when the controls are taken from s_qCOHash while they are
+/// still alive, which invalidates the lookup caches of all threads.
+std::atomic<int> s_qCOHashGeneration{0};
+
+/// Incremented when a control is deleted, which lets the lookup caches
+/// of all threads prune their expired entries.
+std::atomic<int> s_qCOHashRemovals{0};
+
+/// Thread-local copy of the s_qCOHash entries that have been looked up by
+/// a thread. Repeated lookups, e.g. from controller scripts, don't need
+/// to lock s_qCOHashMutex and thereby don't contend with other threads
+/// that create or look up controls. Entries of deleted controls expire
+/// with their weak pointer and are pruned on the next lookup.
+struct ControlLookupCache {
+    int generation = 0;
+    int removals = 0;
+    QHash<ConfigKey, QWeakPointer<ControlDoublePrivate>> controls;
+
+    void update() {
+        const int currentGeneration = s_qCOHashGeneration.load(std::memory_order_acquire);
+        if (generation != currentGeneration) {
+            controls.clear();
+            generation = currentGeneration;
+        }
+        const int currentRemovals = s_qCOHashRemovals.load(std::memory_order_relaxed);
+        if (removals != currentRemovals) {
+            auto it = controls.begin();
+            while (it != controls.end()) {
+                if (it.value().isNull()) {
+                    it = controls.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            removals = currentRemovals;
+        }
+    }
+};
+
+thread_local ControlLookupCache t_controlLookupCache;
+
+void warnIfDeprecatedKey(const ConfigKey& key, const ControlDoublePrivate& control) {
+    const auto& actualKey = control.getKey();
+    if (actualKey != key) {
+        qWarning()
+                << "ControlObject accessed via deprecated key"
+                << key.group << key.item
+                << "- use"
+                << actualKey.group << actualKey.item
+                << "instead";
+    }
+}
 } // namespace
 
 // TODO: re-evaluate whether this is needed.
@@ -84,6 +139,7 @@ ControlDoublePrivate::~ControlDoublePrivate() {
     //qDebug() << "ControlDoublePrivate::s_qCOHash.remove(" << m_key.group << "," << m_key.item << ")";
     s_qCOHash.remove(m_key);
     s_qCOHashMutex.unlock();
+    s_qCOHashRemovals.fetch_add(1, std::memory_order_relaxed);
 
     if (m_bPersistInConfiguration) {
         UserSettingsPointer pConfig = s_pUserConfig;
@@ -142,6 +198,20 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
         return nullptr;
     }
 
+    ControlLookupCache& lookupCache = t_controlLookupCache;
+    if (!pCreatorCO) {
+        lookupCache.update();
+        const auto it = lookupCache.controls.constFind(key);
+        if (it != lookupCache.controls.constEnd()) {
+            auto pControl = it.value().lock();
+            if (pControl) {
+                warnIfDeprecatedKey(key, *pControl);
+                return pControl;
+            }
+            lookupCache.controls.erase(it);
+        }
+    }
+
     // Scope for MMutexLocker.
     {
         const MMutexLocker locker(&s_qCOHashMutex);
@@ -149,15 +219,7 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
         if (it != s_qCOHash.constEnd()) {
             auto pControl = it.value().lock();
             if (pControl) {
-                auto actualKey = pControl->getKey();
-                if (actualKey != key) {
-                    qWarning()
-                            << "ControlObject accessed via deprecated key"
-                            << key.group << key.item
-                            << "- use"
-                            << actualKey.group << actualKey.item
-                            << "instead";
-                }
+                warnIfDeprecatedKey(key, *pControl);
 
                 // Control object already exists
                 if (pCreatorCO) {
@@ -168,6 +230,7 @@ QSharedPointer<ControlDoublePrivate> ControlDoublePrivate::getControl(
                     DEBUG_ASSERT(!"pCreatorCO != nullptr, ControlObject already created");
                     return nullptr;
                 }
+                lookupCache.controls.insert(key, it.value());
                 return pControl;
             } else {
                 // The weak pointer has become invalid and can be cleaned up
@@ -244,6 +307,7 @@ QList<QSharedPointer<ControlDoublePrivate>> ControlDoublePrivate::takeAllInstanc
         }
     }
     s_qCOHash.clear();
+    s_qCOHashGeneration.fetch_add(1, std::memory_order_release);
     return result;
 }
 
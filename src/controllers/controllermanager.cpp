@@ -16,6 +16,10 @@
 #include "util/thread_affinity.h"
 #include "util/time.h"
 
+#ifdef __ALSAMIDI__
+#include "controllers/midi/alsaseqenumerator.h"
+#endif
+
 #ifdef __PORTMIDI__
 #include "controllers/midi/portmidienumerator.h"
 #endif
@@ -156,9 +160,17 @@ void ControllerManager::slotInitialize() {
 
     // Instantiate all enumerators. Enumerators can take a long time to
     // construct since they interact with host MIDI APIs.
+#ifdef __ALSAMIDI__
+    if (isAlsaSequencerEnabled(m_pConfig)) {
+        // PortMidi would list the same devices, but can only be polled
+        m_enumerators.append(new AlsaSeqEnumerator(m_pConfig));
+    } else
+#endif
+    {
 #ifdef __PORTMIDI__
-    m_enumerators.append(new PortMidiEnumerator(m_pConfig));
+        m_enumerators.append(new PortMidiEnumerator(m_pConfig));
 #endif
+    }
 #ifdef __HSS1394__
     m_enumerators.append(new Hss1394Enumerator());
 #endif
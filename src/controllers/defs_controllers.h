@@ -27,8 +27,24 @@ inline QString userMappingsPath(UserSettingsPointer pConfig) {
 #define BULK_MAPPING_EXTENSION ".bulk.xml"
 #define XML_SCHEMA_VERSION "1"
 
-#ifdef __PORTMIDI__
+#if defined(__PORTMIDI__) || defined(__ALSAMIDI__)
 const auto kMidiThroughPortPrefix = QLatin1String("MIDI Through Port");
 const ConfigKey kMidiThroughCfgKey =
         ConfigKey(QStringLiteral("[Controller]"), QStringLiteral("midi_through_enabled"));
 #endif
+
+#ifdef __ALSAMIDI__
+// Use the ALSA sequencer instead of PortMidi for MIDI controllers
+const ConfigKey kAlsaSequencerCfgKey =
+        ConfigKey(QStringLiteral("[Controller]"), QStringLiteral("alsa_sequencer_enabled"));
+
+inline bool isAlsaSequencerEnabled(UserSettingsPointer pConfig) {
+#ifdef __PORTMIDI__
+    return pConfig->getValue(kAlsaSequencerCfgKey, false);
+#else
+    // The only MIDI backend
+    Q_UNUSED(pConfig);
+    return true;
+#endif
+}
+#endif
@@ -33,6 +33,7 @@ const QList<MidiOption> kMidiOptions = {
         MidiOption::Script,
         MidiOption::FourteenBitMSB,
         MidiOption::FourteenBitLSB,
+        MidiOption::Coalesce,
 };
 
 } // namespace
@@ -122,6 +123,10 @@ void MidiOptionsDelegate::setEditorData(QWidget* editor,
         }
         auto opt = static_cast<MidiOption>(pItem->data().toInt());
         pItem->setCheckState(options.testFlag(opt) ? Qt::Checked : Qt::Unchecked);
+        if (opt == MidiOption::Coalesce) {
+            // Only the calls of script functions are coalesced
+            pItem->setEnabled(options.testFlag(MidiOption::Script));
+        }
     }
 
     // Show popup immediately, as with the other editors, no 'edit' click
@@ -147,6 +152,10 @@ void MidiOptionsDelegate::setModelData(QWidget* editor,
         options.setFlag(static_cast<MidiOption>(pItem->data().toUInt()),
                 pItem->checkState() == Qt::Checked);
     }
+    if (!options.testFlag(MidiOption::Script)) {
+        // Would be ignored by MidiController
+        options.setFlag(MidiOption::Coalesce, false);
+    }
     model->setData(index, QVariant::fromValue(options), Qt::EditRole);
 }
 
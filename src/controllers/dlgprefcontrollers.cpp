@@ -44,7 +44,7 @@ DlgPrefControllers::DlgPrefControllers(DlgPreferences* pPreferences,
             this,
             &DlgPrefControllers::rescanControllers);
 
-#ifdef __PORTMIDI__
+#if defined(__PORTMIDI__) || defined(__ALSAMIDI__)
     checkBox_midithrough->setChecked(m_pConfig->getValue(kMidiThroughCfgKey, false));
     connect(checkBox_midithrough,
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
@@ -70,6 +70,25 @@ DlgPrefControllers::DlgPrefControllers(DlgPreferences* pPreferences,
     txt_midithrough->hide();
 #endif
 
+#if defined(__ALSAMIDI__) && defined(__PORTMIDI__)
+    checkBox_alsasequencer->setChecked(m_pConfig->getValue(kAlsaSequencerCfgKey, false));
+    connect(checkBox_alsasequencer,
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+            &QCheckBox::checkStateChanged,
+#else
+            &QCheckBox::stateChanged,
+#endif
+            this,
+            &DlgPrefControllers::slotAlsaSequencerChanged);
+    txt_alsasequencer->setText(tr(
+            "MIDI controllers are read by the ALSA sequencer as soon as they send "
+            "a message instead of being polled through PortMidi.\n"
+            "You need to restart Mixxx in order to apply it."));
+#else
+    checkBox_alsasequencer->hide();
+    txt_alsasequencer->hide();
+#endif
+
     // Setting the description text here instead of in the ui file allows to paste
     // a formatted link (text color is a more readable blend of text color and original link color).
     txtMappingsOverview->setText(tr(
@@ -276,7 +295,7 @@ void DlgPrefControllers::slotHighlightDevice(DlgPrefController* pControllerDlg,
     pControllerTreeItem->setFont(0, temp);
 }
 
-#ifdef __PORTMIDI__
+#if defined(__PORTMIDI__) || defined(__ALSAMIDI__)
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
 void DlgPrefControllers::slotMidiThroughChanged(Qt::CheckState state) {
     m_pConfig->setValue(kMidiThroughCfgKey, state != Qt::Unchecked);
@@ -287,3 +306,15 @@ void DlgPrefControllers::slotMidiThroughChanged(bool checked) {
 }
 #endif
 #endif
+
+#if defined(__ALSAMIDI__) && defined(__PORTMIDI__)
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+void DlgPrefControllers::slotAlsaSequencerChanged(Qt::CheckState state) {
+    m_pConfig->setValue(kAlsaSequencerCfgKey, state != Qt::Unchecked);
+}
+#else
+void DlgPrefControllers::slotAlsaSequencerChanged(bool checked) {
+    m_pConfig->setValue(kAlsaSequencerCfgKey, checked);
+}
+#endif
+#endif
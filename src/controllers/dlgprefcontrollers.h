@@ -41,12 +41,19 @@ class DlgPrefControllers : public DlgPreferencePage, public Ui::DlgPrefControlle
 
   private slots:
     void rescanControllers();
-#ifdef __PORTMIDI__
+#if defined(__PORTMIDI__) || defined(__ALSAMIDI__)
 #if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
     void slotMidiThroughChanged(Qt::CheckState state);
 #else
     void slotMidiThroughChanged(bool checked);
 #endif
+#endif
+#if defined(__ALSAMIDI__) && defined(__PORTMIDI__)
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+    void slotAlsaSequencerChanged(Qt::CheckState state);
+#else
+    void slotAlsaSequencerChanged(bool checked);
+#endif
 #endif
     void slotHighlightDevice(DlgPrefController* dialog, bool enabled);
 
@@ -283,9 +283,9 @@ int HidController::open(const QString& resourcePath) {
     m_pHidIoThread->setObjectName(QStringLiteral("HidIoThread ") + getName());
 
     connect(m_pHidIoThread.get(),
-            &HidIoThread::receive,
+            &HidIoThread::inputReportsAvailable,
             this,
-            &HidController::receive,
+            &HidController::processInputReports,
             Qt::QueuedConnection);
 
     // Controller input needs to be prioritized since it can affect the
@@ -380,6 +380,16 @@ int HidController::close() {
     return 0;
 }
 
+void HidController::processInputReports() {
+    if (!m_pHidIoThread) {
+        // Signal queued before the device has been closed
+        return;
+    }
+    for (const auto& inputReport : m_pHidIoThread->takeInputReports()) {
+        receive(inputReport.data, inputReport.timestamp);
+    }
+}
+
 /// This function is only for class compatibility with the (midi)controller
 /// and will not do the same as for MIDI devices,
 /// because sending of raw bytes is not a supported HIDAPI feature.
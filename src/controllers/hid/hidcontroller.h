@@ -100,6 +100,10 @@ class HidController final : public Controller {
     // opened for real.
     void fetchReportDescriptorInBackground();
 
+  private slots:
+    /// Passes the InputReports received by the HidIoThread to the mapping
+    void processInputReports();
+
   private:
     int open(const QString& resourcePath) override;
     int close() override;
@@ -8,6 +8,18 @@
 #else
 #include <hidapi.h>
 #endif
+
+#if defined(__LINUX__) && !defined(__ANDROID__)
+// The hidraw backend of hidapi uses device nodes that can be waited for
+#define MIXXX_HID_WAIT_FOR_INPUT
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
 #include "moc_hidiothread.cpp"
 #include "util/runtimeloggingcategory.h"
 #include "util/string.h"
@@ -19,6 +31,7 @@ constexpr int kReportIdSize = 1;
 constexpr size_t kMaxHidErrorMessageSize = 512;
 
 // Sleep time of run loop, in idle case, when no time consuming operation was executed before
+// and the device can't be waited for
 // The lower the time the more even the CPU load is spread over time
 // High values block the IO of this device and reduce response time and also the bandwidth.
 // Note, that this value has no influence on the amount of data to process,
@@ -27,6 +40,11 @@ constexpr size_t kMaxHidErrorMessageSize = 512;
 // the fastest possible rate of HID devices with USB HighSpeed or USB SuperSpeed interface is 8kHz
 constexpr int kSleepTimeWhenIdleMicros = 250;
 
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+// HIDRAW_BUFFER_SIZE of the Linux kernel
+constexpr int kMaxBufferedHidrawReports = 64;
+#endif
+
 QString loggingCategoryPrefix(const QString& deviceName) {
     return QStringLiteral("controller.") +
             RuntimeLoggingCategory::removeInvalidCharsFromCategory(deviceName.toLower());
@@ -50,17 +68,44 @@ HidIoThread::HidIoThread(hid_device* pHidDevice,
           m_pollingBufferIndex(0),
           m_hidReadErrorLogged(false),
           m_deviceUsesReportIds(deviceUsesReportIds),
+          m_inputFd(-1),
+          m_wakeUpFd(-1),
           m_globalOutputReportFifo(),
           m_runLoopSemaphore(1) {
     // Initializing isn't strictly necessary but is good practice.
     for (int i = 0; i < kNumBuffers; i++) {
         memset(m_pPollData[i], 0, kBufferSize);
     }
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    // Every open file of a hidraw device receives all InputReports. Reading
+    // them from our own file instead of hid_read() allows to wait for them
+    // with poll(), hidapi doesn't expose its file descriptor.
+    if (QLatin1String(m_deviceInfo.pathRaw()).startsWith(QLatin1String("/dev/hidraw"))) {
+        m_inputFd = ::open(m_deviceInfo.pathRaw(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (m_inputFd < 0) {
+            qCWarning(m_logInput) << "Unable to open" << m_deviceInfo.pathRaw()
+                                  << "for waiting on InputReports:" << strerror(errno);
+        }
+    }
+    if (m_inputFd >= 0) {
+        m_wakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_wakeUpFd < 0) {
+            qCWarning(m_logBase) << "Unable to create eventfd:" << strerror(errno);
+            closeInputFd();
+        }
+    }
+#endif
     m_outputReportIterator = m_outputReports.begin();
     m_state.storeRelease(static_cast<int>(HidIoThreadState::Initialized));
 }
 
 HidIoThread::~HidIoThread() {
+    closeInputFd();
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_wakeUpFd >= 0) {
+        ::close(m_wakeUpFd);
+    }
+#endif
     hid_close(m_pHidDevice);
 #ifdef Q_OS_ANDROID
     if (m_androidConnection.isValid()) {
@@ -87,12 +132,124 @@ void HidIoThread::run() {
                         HidIoThreadState::Stopped)) {
                 break;
             }
-            // Sleep run loop, if no OutputReport was send
+            // Wait for the next InputReport or OutputReport if possible,
+            // otherwise sleep run loop, if no OutputReport was send.
             // Tests on Windows and Linux showed that the thread schedulers
             // handle usleep wait times reliable under CPU load
-            usleep(kSleepTimeWhenIdleMicros);
+            if (!waitForInputOrOutput()) {
+                usleep(kSleepTimeWhenIdleMicros);
+            }
+        }
+    }
+}
+
+bool HidIoThread::waitForInputOrOutput() {
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_inputFd < 0) {
+        return false;
+    }
+    pollfd fds[2] = {{m_wakeUpFd, POLLIN, 0}, {m_inputFd, POLLIN, 0}};
+    // Pending InputReports are only read in the InputOutputActive state,
+    // don't spin on them in the other states.
+    const nfds_t numFds = m_state.loadAcquire() ==
+                    static_cast<int>(HidIoThreadState::InputOutputActive)
+            ? 2
+            : 1;
+    if (::poll(fds, numFds, -1) < 0) {
+        if (errno == EINTR) {
+            return true;
+        }
+        qCWarning(m_logBase) << "poll() failed for" << m_deviceInfo.formatName()
+                             << ":" << strerror(errno);
+        auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+        fallBackToHidRead();
+        return false;
+    }
+    if (fds[0].revents & POLLIN) {
+        uint64_t wakeUpCount;
+        if (::read(m_wakeUpFd, &wakeUpCount, sizeof(wakeUpCount)) < 0) {
+            DEBUG_ASSERT(errno == EAGAIN);
+        }
+    }
+    if (numFds > 1 && (fds[1].revents & (POLLERR | POLLHUP | POLLNVAL))) {
+        // The device has been disconnected, let hid_read() report the error
+        qCWarning(m_logInput) << "Unable to wait for InputReports from"
+                              << m_deviceInfo.formatName();
+        auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
+        fallBackToHidRead();
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void HidIoThread::wakeUp() {
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_wakeUpFd >= 0) {
+        const uint64_t wakeUpCount = 1;
+        if (::write(m_wakeUpFd, &wakeUpCount, sizeof(wakeUpCount)) < 0) {
+            // The counter only overflows if the run loop is stuck
+            DEBUG_ASSERT(errno == EAGAIN);
+        }
+    }
+#endif
+}
+
+void HidIoThread::closeInputFd() {
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_inputFd >= 0) {
+        ::close(m_inputFd);
+        m_inputFd = -1;
+    }
+#endif
+}
+
+void HidIoThread::fallBackToHidRead() {
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_inputFd < 0) {
+        return;
+    }
+    closeInputFd();
+    // The file opened by hidapi has received the same InputReports, but
+    // they have never been read from it. The kernel keeps up to 64 of them
+    // for each open file, which would be replayed as if they were new.
+    // Discard them, only the InputReports received from now on are read
+    // with hid_read().
+    hid_set_nonblocking(m_pHidDevice, 1);
+    for (int i = 0; i < kMaxBufferedHidrawReports; ++i) {
+        if (hid_read(m_pHidDevice, m_pPollData[m_pollingBufferIndex], kBufferSize) <= 0) {
+            break;
+        }
+    }
+#endif
+}
+
+int HidIoThread::readInputReport() {
+#ifdef MIXXX_HID_WAIT_FOR_INPUT
+    if (m_inputFd >= 0) {
+        // Like hid_read() of the hidraw backend, which reads one
+        // InputReport from its own file.
+        const ssize_t bytesRead = ::read(
+                m_inputFd, m_pPollData[m_pollingBufferIndex], kBufferSize);
+        if (bytesRead < 0) {
+            if (errno == EAGAIN) {
+                return 0;
+            }
+            if (!m_hidReadErrorLogged) {
+                qCWarning(m_logInput)
+                        << "Unable to read buffered HID InputReports from"
+                        << m_deviceInfo.formatName() << ":" << strerror(errno);
+                m_hidReadErrorLogged = true;
+            }
+            // Fall back to hid_read(), which handles disconnected devices
+            fallBackToHidRead();
+            return 0;
         }
+        return static_cast<int>(bytesRead);
     }
+#endif
+    return hid_read(m_pHidDevice, m_pPollData[m_pollingBufferIndex], kBufferSize);
 }
 
 void HidIoThread::pollBufferedInputReports() {
@@ -111,7 +268,7 @@ void HidIoThread::pollBufferedInputReports() {
     // If the interval between two polls is to long, multiple buffered HID InputReports
     // will be processed at the same time.
     while (m_state.loadAcquire() == static_cast<int>(HidIoThreadState::InputOutputActive)) {
-        int bytesRead = hid_read(m_pHidDevice, m_pPollData[m_pollingBufferIndex], kBufferSize);
+        int bytesRead = readInputReport();
         if (bytesRead < 0) {
             // -1 is the only error value according to hidapi documentation.
             DEBUG_ASSERT(bytesRead == -1);
@@ -160,11 +317,19 @@ void HidIoThread::processInputReport(int bytesRead) {
     m_pollingBufferIndex = (m_pollingBufferIndex + 1) % kNumBuffers;
     m_lastPollSize = bytesRead;
 
-    // Convert array of bytes read in a JavaScript compatible return type, this is emitted as deep-copy, for thread safety.
+    // Convert array of bytes read in a JavaScript compatible return type, this is passed as deep-copy, for thread safety.
     // This eexecute callback function in JavaScript mapping and print to stdout in case of --controllerDebug
-    emit receive(QByteArray(reinterpret_cast<const char*>(pCurrentBuffer),
-                         bytesRead),
-            mixxx::Time::elapsed());
+    auto inputReportsLock = lockMutex(&m_inputReportsMutex);
+    const bool wasEmpty = m_inputReports.empty();
+    m_inputReports.push_back(HidInputReport{
+            QByteArray(reinterpret_cast<const char*>(pCurrentBuffer), bytesRead),
+            mixxx::Time::elapsed()});
+    inputReportsLock.unlock();
+    if (wasEmpty) {
+        // Otherwise the previous signal has not been handled yet and the
+        // controller thread will take this InputReport together with the others
+        emit inputReportsAvailable();
+    }
 
     if (m_deviceUsesReportIds.has_value() && bytesRead > 0) {
         if (m_deviceUsesReportIds.value()) {
@@ -183,6 +348,13 @@ void HidIoThread::processInputReport(int bytesRead) {
     }
 }
 
+std::vector<HidInputReport> HidIoThread::takeInputReports() {
+    std::vector<HidInputReport> inputReports;
+    auto inputReportsLock = lockMutex(&m_inputReportsMutex);
+    inputReports.swap(m_inputReports);
+    return inputReports;
+}
+
 QByteArray HidIoThread::getInputReport(quint8 reportID) {
     auto startOfHidGetInputReport = mixxx::Time::elapsed();
     auto hidDeviceLock = lockMutex(&m_hidDeviceAndPollMutex);
@@ -253,6 +425,7 @@ void HidIoThread::updateCachedOutputReportData(quint8 reportID,
     if (useNonSkippingFIFO) {
         m_globalOutputReportFifo.addReportDatasetToFifo(reportID, data, m_deviceInfo, m_logOutput);
     }
+    wakeUp();
 }
 
 bool HidIoThread::sendNextCachedOutputReport() {
@@ -383,7 +556,7 @@ bool HidIoThread::testAndSetThreadState(HidIoThreadState expectedState,
         // Test result must be handled outside of this function. [[nodiscard]]
         return false;
     }
-
+    wakeUp();
     return true;
 }
 
@@ -395,4 +568,5 @@ bool HidIoThread::waitUntilRunLoopIsStopped(unsigned int timeoutMillis) {
 
 void HidIoThread::setThreadState(HidIoThreadState expectedState) {
     m_state.storeRelease(static_cast<int>(expectedState));
+    wakeUp();
 }
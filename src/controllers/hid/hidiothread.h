@@ -3,6 +3,7 @@
 #include <QSemaphore>
 #include <QThread>
 #include <map>
+#include <vector>
 
 #include "controllers/hid/hiddevice.h"
 #include "controllers/hid/hidioglobaloutputreportfifo.h"
@@ -20,6 +21,12 @@ enum class HidIoThreadState {
     Stopped,
 };
 
+/// An InputReport together with the time it has been read from the device
+struct HidInputReport {
+    QByteArray data;
+    mixxx::Duration timestamp;
+};
+
 class HidIoThread : public QThread {
     Q_OBJECT
   public:
@@ -47,6 +54,10 @@ class HidIoThread : public QThread {
             const QByteArray& reportData,
             bool useNonSkippingFIFO);
     QByteArray getInputReport(quint8 reportID);
+
+    /// Returns all InputReports received since the last call,
+    /// in the order they have been received.
+    std::vector<HidInputReport> takeInputReports();
     void sendFeatureReport(quint8 reportID, const QByteArray& reportData);
     QByteArray getFeatureReport(quint8 reportID);
 
@@ -60,16 +71,31 @@ class HidIoThread : public QThread {
 #endif
 
   signals:
-    /// Signals that a HID InputReport received by Interrupt triggered from HID device
-    void receive(const QByteArray& data, mixxx::Duration timestamp);
+    /// Signals that HID InputReports received from the HID device are ready to
+    /// be taken with takeInputReports(). It is not emitted again before they
+    /// have been taken, so a busy controller thread handles all InputReports
+    /// of a burst with a single queued call instead of one per report.
+    void inputReportsAvailable();
     void reportReceived(quint8 reportId, const QByteArray& data);
 
   private:
     bool sendNextCachedOutputReport();
 
     void pollBufferedInputReports();
+    int readInputReport();
     void processInputReport(int bytesRead);
 
+    /// Blocks until an InputReport is available, an OutputReport has been
+    /// cached or the state has changed. Returns false if the device can't be
+    /// waited for, then the run loop falls back to polling.
+    bool waitForInputOrOutput();
+    /// Interrupts waitForInputOrOutput()
+    void wakeUp();
+    void closeInputFd();
+    /// Continues with hid_read() after reading from m_inputFd failed.
+    /// m_hidDeviceAndPollMutex must be locked.
+    void fallBackToHidRead();
+
     const mixxx::hid::DeviceInfo m_deviceInfo;
     const RuntimeLoggingCategory m_logBase;
     const RuntimeLoggingCategory m_logInput;
@@ -94,6 +120,16 @@ class HidIoThread : public QThread {
 
     std::optional<bool> m_deviceUsesReportIds;
 
+    /// A second read-only handle of the hidraw device, which is opened to
+    /// wait for InputReports with poll(). Only available on Linux, otherwise
+    /// the run loop polls hidapi with short sleeps in between.
+    int m_inputFd;
+    /// Counts the wake up requests of waitForInputOrOutput()
+    int m_wakeUpFd;
+
+    QMutex m_inputReportsMutex;
+    std::vector<HidInputReport> m_inputReports;
+
     /// Must be locked when a operation changes the size of the m_outputReports map,
     /// or when modify the m_outputReportIterator
     QMutex m_outputReportMapMutex;
@@ -0,0 +1,295 @@
+#include "controllers/midi/alsaseqcontroller.h"
+
+#include "controllers/midi/alsaseqinputthread.h"
+#include "controllers/midi/midiutils.h"
+#include "moc_alsaseqcontroller.cpp"
+#include "util/time.h"
+
+namespace {
+
+/// Large enough for every MIDI message except SysEx, which is not encoded
+constexpr long kEncoderBufferSize = 16;
+
+} // namespace
+
+AlsaSeqController::AlsaSeqController(const QString& deviceName,
+        const snd_seq_addr_t& deviceAddress,
+        bool isInput,
+        bool isOutput)
+        : MidiController(deviceName),
+          m_deviceAddress(deviceAddress),
+          m_pInputSeq(nullptr),
+          m_inputPort(-1),
+          m_queue(-1),
+          m_pOutputSeq(nullptr),
+          m_outputPort(-1),
+          m_pEncoder(nullptr) {
+    setInputDevice(isInput);
+    setOutputDevice(isOutput);
+}
+
+AlsaSeqController::~AlsaSeqController() {
+    if (isOpen()) {
+        close();
+    }
+}
+
+int AlsaSeqController::open(const QString& resourcePath) {
+    if (isOpen()) {
+        qCWarning(m_logBase) << "ALSA MIDI device" << getName() << "already open";
+        return -1;
+    }
+
+    qCInfo(m_logBase) << "AlsaSeqController: Opening" << getName() << "at"
+                      << QStringLiteral("%1:%2").arg(QString::number(m_deviceAddress.client),
+                                 QString::number(m_deviceAddress.port));
+    if (!openSequencer()) {
+        closeSequencer();
+        return -2;
+    }
+
+    startEngine();
+    applyMapping(resourcePath);
+    setOpen(true);
+    return 0;
+}
+
+bool AlsaSeqController::openSequencer() {
+    if (isInputDevice() && !openInput()) {
+        return false;
+    }
+    if (isOutputDevice() && !openOutput()) {
+        return false;
+    }
+    return true;
+}
+
+bool AlsaSeqController::openInput() {
+    // Duplex, because starting the queue requires sending an event
+    int err = snd_seq_open(&m_pInputSeq, "default", SND_SEQ_OPEN_DUPLEX, SND_SEQ_NONBLOCK);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to open ALSA sequencer for input:" << snd_strerror(err);
+        m_pInputSeq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(m_pInputSeq, AlsaSeqController::kClientName);
+
+    m_inputPort = snd_seq_create_simple_port(m_pInputSeq,
+            getName().toLocal8Bit().constData(),
+            SND_SEQ_PORT_CAP_WRITE,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    if (m_inputPort < 0) {
+        qCWarning(m_logBase) << "Failed to create ALSA sequencer port:"
+                             << snd_strerror(m_inputPort);
+        return false;
+    }
+
+    // The queue is only needed to stamp the incoming events with the time
+    // they have been received.
+    m_queue = snd_seq_alloc_named_queue(m_pInputSeq, AlsaSeqController::kClientName);
+    if (m_queue < 0) {
+        qCWarning(m_logBase) << "Failed to allocate ALSA sequencer queue:"
+                             << snd_strerror(m_queue);
+        return false;
+    }
+    snd_seq_start_queue(m_pInputSeq, m_queue, nullptr);
+    snd_seq_drain_output(m_pInputSeq);
+
+    snd_seq_queue_status_t* pQueueStatus;
+    snd_seq_queue_status_alloca(&pQueueStatus);
+    err = snd_seq_get_queue_status(m_pInputSeq, m_queue, pQueueStatus);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to query ALSA sequencer queue:" << snd_strerror(err);
+        return false;
+    }
+    const snd_seq_real_time_t* pQueueTime =
+            snd_seq_queue_status_get_real_time(pQueueStatus);
+    const mixxx::Duration queueStartTime = mixxx::Time::elapsed() -
+            mixxx::Duration::fromNanos(
+                    static_cast<qint64>(pQueueTime->tv_sec) * 1000000000 +
+                    pQueueTime->tv_nsec);
+
+    snd_seq_port_subscribe_t* pSubscription;
+    snd_seq_port_subscribe_alloca(&pSubscription);
+    const snd_seq_addr_t portAddress = {
+            static_cast<unsigned char>(snd_seq_client_id(m_pInputSeq)),
+            static_cast<unsigned char>(m_inputPort)};
+    snd_seq_port_subscribe_set_sender(pSubscription, &m_deviceAddress);
+    snd_seq_port_subscribe_set_dest(pSubscription, &portAddress);
+    snd_seq_port_subscribe_set_queue(pSubscription, m_queue);
+    snd_seq_port_subscribe_set_time_update(pSubscription, 1);
+    snd_seq_port_subscribe_set_time_real(pSubscription, 1);
+    err = snd_seq_subscribe_port(m_pInputSeq, pSubscription);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to connect to ALSA sequencer port for input:"
+                             << snd_strerror(err);
+        return false;
+    }
+
+    m_pInputThread = std::make_unique<AlsaSeqInputThread>(
+            m_pInputSeq, m_logInput, queueStartTime);
+    m_pInputThread->setObjectName(QStringLiteral("AlsaSeqInputThread %1").arg(getName()));
+    connect(m_pInputThread.get(),
+            &AlsaSeqInputThread::receivedShortMessage,
+            this,
+            &AlsaSeqController::receivedShortMessage);
+    connect(m_pInputThread.get(),
+            &AlsaSeqInputThread::receivedSysex,
+            this,
+            &AlsaSeqController::receive);
+    m_pInputThread->start(QThread::HighPriority);
+    return true;
+}
+
+bool AlsaSeqController::openOutput() {
+    int err = snd_seq_open(&m_pOutputSeq, "default", SND_SEQ_OPEN_OUTPUT, SND_SEQ_NONBLOCK);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to open ALSA sequencer for output:" << snd_strerror(err);
+        m_pOutputSeq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(m_pOutputSeq, AlsaSeqController::kClientName);
+
+    m_outputPort = snd_seq_create_simple_port(m_pOutputSeq,
+            getName().toLocal8Bit().constData(),
+            SND_SEQ_PORT_CAP_READ,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    if (m_outputPort < 0) {
+        qCWarning(m_logBase) << "Failed to create ALSA sequencer port:"
+                             << snd_strerror(m_outputPort);
+        return false;
+    }
+
+    err = snd_midi_event_new(kEncoderBufferSize, &m_pEncoder);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to create MIDI event encoder:" << snd_strerror(err);
+        m_pEncoder = nullptr;
+        return false;
+    }
+    err = snd_seq_connect_to(m_pOutputSeq,
+            m_outputPort,
+            m_deviceAddress.client,
+            m_deviceAddress.port);
+    if (err < 0) {
+        qCWarning(m_logBase) << "Failed to connect to ALSA sequencer port for output:"
+                             << snd_strerror(err);
+        return false;
+    }
+    return true;
+}
+
+int AlsaSeqController::close() {
+    if (!isOpen()) {
+        qCWarning(m_logBase) << "ALSA MIDI device" << getName() << "already closed";
+        return -1;
+    }
+
+    stopEngine();
+    MidiController::close();
+    closeSequencer();
+    setOpen(false);
+    return 0;
+}
+
+void AlsaSeqController::closeSequencer() {
+    if (m_pInputThread) {
+        m_pInputThread->stop();
+        m_pInputThread.reset();
+    }
+    if (m_pEncoder) {
+        snd_midi_event_free(m_pEncoder);
+        m_pEncoder = nullptr;
+    }
+    // Closing a client also removes its port, queue and subscriptions
+    if (m_pInputSeq) {
+        snd_seq_close(m_pInputSeq);
+        m_pInputSeq = nullptr;
+    }
+    m_inputPort = -1;
+    m_queue = -1;
+    if (m_pOutputSeq) {
+        snd_seq_close(m_pOutputSeq);
+        m_pOutputSeq = nullptr;
+    }
+    m_outputPort = -1;
+}
+
+bool AlsaSeqController::sendEvent(snd_seq_event_t* pEvent) {
+    snd_seq_ev_set_source(pEvent, m_outputPort);
+    snd_seq_ev_set_subs(pEvent);
+    snd_seq_ev_set_direct(pEvent);
+    const int err = snd_seq_event_output_direct(m_pOutputSeq, pEvent);
+    if (err < 0) {
+        qCWarning(m_logOutput) << "ALSA sequencer error:" << snd_strerror(err);
+        return false;
+    }
+    return true;
+}
+
+void AlsaSeqController::sendShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (!m_pOutputSeq || !m_pEncoder) {
+        return;
+    }
+
+    const unsigned char data[3] = {status, byte1, byte2};
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    snd_midi_event_reset_encode(m_pEncoder);
+    // Stops after the last data byte of the message, so passing an unused
+    // byte for one and two byte messages is fine.
+    snd_midi_event_encode(m_pEncoder, data, sizeof(data), &event);
+    if (event.type == SND_SEQ_EVENT_NONE) {
+        qCWarning(m_logOutput) << "Invalid short message"
+                               << MidiUtils::formatMidiOpCode(getName(),
+                                          status,
+                                          byte1,
+                                          byte2,
+                                          MidiUtils::channelFromStatus(status),
+                                          MidiUtils::opCodeFromStatus(status));
+        return;
+    }
+
+    if (sendEvent(&event)) {
+        qCDebug(m_logOutput) << QStringLiteral("outgoing: ")
+                             << MidiUtils::formatMidiOpCode(getName(),
+                                        status,
+                                        byte1,
+                                        byte2,
+                                        MidiUtils::channelFromStatus(status),
+                                        MidiUtils::opCodeFromStatus(status));
+    } else {
+        qCWarning(m_logOutput) << "Error sending short message"
+                               << MidiUtils::formatMidiOpCode(getName(),
+                                          status,
+                                          byte1,
+                                          byte2,
+                                          MidiUtils::channelFromStatus(status),
+                                          MidiUtils::opCodeFromStatus(status));
+    }
+}
+
+bool AlsaSeqController::sendBytes(const QByteArray& data) {
+    if (!m_pOutputSeq || !m_pEncoder) {
+        return false;
+    }
+    if (!data.startsWith(MidiUtils::opCodeValue(MidiOpCode::SystemExclusive)) ||
+            !data.endsWith(MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive))) {
+        qCDebug(m_logOutput) << "SysEx message does not start with 0xF0 and end with 0xF7 "
+                                "-- ignoring.";
+        return false;
+    }
+
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_sysex(&event, data.size(), const_cast<char*>(data.constData()));
+    if (!sendEvent(&event)) {
+        qCWarning(m_logOutput) << "Error sending SysEx message:"
+                               << MidiUtils::formatSysexMessage(getName(), data);
+        return false;
+    }
+    qCDebug(m_logOutput) << QStringLiteral("outgoing: ")
+                         << MidiUtils::formatSysexMessage(getName(), data);
+    return true;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <alsa/asoundlib.h>
+
+#include <memory>
+
+#include "controllers/midi/midicontroller.h"
+
+class AlsaSeqInputThread;
+
+/// ALSA sequencer based implementation of MidiController
+///
+/// Each opened controller creates its own ALSA sequencer clients for input
+/// and output, each with a single port that is connected to the port of the
+/// device. A client handle must not be used by multiple threads at once, so
+/// the input client is only read by the AlsaSeqInputThread and the output
+/// client is only written by the controller thread. Unlike PortMidiController
+/// this controller does not need to be polled: the AlsaSeqInputThread only
+/// wakes up when the device sends something.
+class AlsaSeqController : public MidiController {
+    Q_OBJECT
+  public:
+    /// The name of the sequencer clients of opened controllers
+    static constexpr const char* kClientName = "Mixxx";
+
+    AlsaSeqController(const QString& deviceName,
+            const snd_seq_addr_t& deviceAddress,
+            bool isInput,
+            bool isOutput);
+    ~AlsaSeqController() override;
+
+    PhysicalTransportProtocol getPhysicalTransportProtocol() const override {
+        return PhysicalTransportProtocol::UNKNOWN;
+    }
+
+    QString getVendorString() const override {
+        return QString();
+    }
+    QString getProductString() const override {
+        return getName();
+    }
+    std::optional<uint16_t> getVendorId() const override {
+        return std::nullopt;
+    }
+    std::optional<uint16_t> getProductId() const override {
+        return std::nullopt;
+    }
+    QString getSerialNumber() const override {
+        return QString();
+    }
+
+    std::optional<uint8_t> getUsbInterfaceNumber() const override {
+        return std::nullopt;
+    }
+
+  protected:
+    void sendShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2) override;
+
+  private:
+    int open(const QString& resourcePath) override;
+    int close() override;
+
+    // The sysex data must already contain the start byte 0xf0 and the end byte
+    // 0xf7.
+    bool sendBytes(const QByteArray& data) override;
+
+    bool openSequencer();
+    bool openInput();
+    bool openOutput();
+    void closeSequencer();
+    bool sendEvent(snd_seq_event_t* pEvent);
+
+    const snd_seq_addr_t m_deviceAddress;
+
+    // Owned by the controller thread, only used by the input thread while
+    // it is running.
+    snd_seq_t* m_pInputSeq;
+    int m_inputPort;
+    int m_queue;
+
+    snd_seq_t* m_pOutputSeq;
+    int m_outputPort;
+    snd_midi_event_t* m_pEncoder;
+
+    std::unique_ptr<AlsaSeqInputThread> m_pInputThread;
+
+    friend class AlsaSeqControllerTest;
+};
@@ -0,0 +1,95 @@
+#include "controllers/midi/alsaseqenumerator.h"
+
+#include <alsa/asoundlib.h>
+
+#include "controllers/defs_controllers.h"
+#include "controllers/midi/alsaseqcontroller.h"
+#include "moc_alsaseqenumerator.cpp"
+#include "util/cmdlineargs.h"
+
+namespace {
+
+constexpr unsigned int kInputCapabilities =
+        SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ;
+constexpr unsigned int kOutputCapabilities =
+        SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE;
+
+bool recognizeDevice(const QString& portName, UserSettingsPointer pConfig) {
+    // In developer mode we show the MIDI Through Port, otherwise ignore it
+    // since it routinely causes trouble.
+    return CmdlineArgs::Instance().getDeveloper() ||
+            pConfig->getValue(kMidiThroughCfgKey, false) ||
+            !portName.startsWith(kMidiThroughPortPrefix, Qt::CaseInsensitive);
+}
+
+} // namespace
+
+AlsaSeqEnumerator::AlsaSeqEnumerator(UserSettingsPointer pConfig)
+        : m_pConfig(pConfig) {
+}
+
+AlsaSeqEnumerator::~AlsaSeqEnumerator() {
+    qDebug() << "Deleting ALSA MIDI devices...";
+    qDeleteAll(m_devices);
+}
+
+/// Unlike PortMidi, the ALSA sequencer reports input and output of a device
+/// as a single port, so there is no need to pair them by name.
+QList<Controller*> AlsaSeqEnumerator::queryDevices() {
+    qDebug() << "Scanning ALSA MIDI devices:";
+
+    qDeleteAll(m_devices);
+    m_devices.clear();
+
+    snd_seq_t* pSeq = nullptr;
+    int err = snd_seq_open(&pSeq, "default", SND_SEQ_OPEN_DUPLEX, 0);
+    if (err < 0) {
+        qWarning() << "Failed to open ALSA sequencer:" << snd_strerror(err);
+        return m_devices;
+    }
+
+    snd_seq_client_info_t* pClientInfo;
+    snd_seq_port_info_t* pPortInfo;
+    snd_seq_client_info_alloca(&pClientInfo);
+    snd_seq_port_info_alloca(&pPortInfo);
+
+    snd_seq_client_info_set_client(pClientInfo, -1);
+    while (snd_seq_query_next_client(pSeq, pClientInfo) >= 0) {
+        const int client = snd_seq_client_info_get_client(pClientInfo);
+        if (client == SND_SEQ_CLIENT_SYSTEM) {
+            // Timer and announcements
+            continue;
+        }
+        if (QLatin1String(snd_seq_client_info_get_name(pClientInfo)) ==
+                QLatin1String(AlsaSeqController::kClientName)) {
+            // Don't connect to the ports of opened controllers
+            continue;
+        }
+        snd_seq_port_info_set_client(pPortInfo, client);
+        snd_seq_port_info_set_port(pPortInfo, -1);
+        while (snd_seq_query_next_port(pSeq, pPortInfo) >= 0) {
+            const unsigned int capabilities = snd_seq_port_info_get_capability(pPortInfo);
+            if (capabilities & SND_SEQ_PORT_CAP_NO_EXPORT) {
+                continue;
+            }
+            const bool isInput = (capabilities & kInputCapabilities) == kInputCapabilities;
+            const bool isOutput = (capabilities & kOutputCapabilities) == kOutputCapabilities;
+            const QString portName = QString::fromLocal8Bit(
+                    snd_seq_port_info_get_name(pPortInfo));
+            if (!isInput || !recognizeDevice(portName, m_pConfig)) {
+                // Is there a use case for output-only devices such as message
+                // displays? Then they need to be handled here.
+                continue;
+            }
+            const snd_seq_addr_t address = *snd_seq_port_info_get_addr(pPortInfo);
+            qDebug() << " Found" << (isOutput ? "input/output" : "input") << "device"
+                     << QStringLiteral("%1:%2").arg(QString::number(address.client),
+                                QString::number(address.port))
+                     << portName;
+            m_devices.push_back(new AlsaSeqController(portName, address, isInput, isOutput));
+        }
+    }
+
+    snd_seq_close(pSeq);
+    return m_devices;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "controllers/midi/midienumerator.h"
+#include "preferences/usersettings.h"
+
+/// Handles discovery and enumeration of DJ controllers that appear as ports
+/// of the ALSA sequencer on Linux.
+class AlsaSeqEnumerator : public MidiEnumerator {
+    Q_OBJECT
+  public:
+    explicit AlsaSeqEnumerator(UserSettingsPointer pConfig);
+    ~AlsaSeqEnumerator() override;
+
+    QList<Controller*> queryDevices() override;
+
+  private:
+    QList<Controller*> m_devices;
+    UserSettingsPointer m_pConfig;
+};
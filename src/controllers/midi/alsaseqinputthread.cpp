@@ -0,0 +1,166 @@
+#include "controllers/midi/alsaseqinputthread.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "controllers/midi/midiutils.h"
+#include "moc_alsaseqinputthread.cpp"
+#include "util/assert.h"
+#include "util/time.h"
+
+namespace {
+
+/// Large enough for every MIDI message except SysEx, which is not decoded
+constexpr long kDecoderBufferSize = 16;
+
+/// Drop incomplete SysEx messages instead of buffering them forever
+constexpr int kMaxSysexSize = 64 * 1024;
+
+} // namespace
+
+AlsaSeqInputThread::AlsaSeqInputThread(snd_seq_t* pSeq,
+        const RuntimeLoggingCategory& logInput,
+        mixxx::Duration queueStartTime)
+        : m_pSeq(pSeq),
+          m_logInput(logInput),
+          m_queueStartTime(queueStartTime),
+          m_pDecoder(nullptr),
+          m_stopEventFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+    if (m_stopEventFd < 0) {
+        qCWarning(m_logInput) << "Failed to create eventfd:" << strerror(errno);
+    }
+    int err = snd_midi_event_new(kDecoderBufferSize, &m_pDecoder);
+    if (err < 0) {
+        qCWarning(m_logInput) << "Failed to create MIDI event decoder:" << snd_strerror(err);
+        m_pDecoder = nullptr;
+    } else {
+        // Controller mappings expect the status byte in every message
+        snd_midi_event_no_status(m_pDecoder, 1);
+    }
+}
+
+AlsaSeqInputThread::~AlsaSeqInputThread() {
+    DEBUG_ASSERT(!isRunning());
+    if (m_pDecoder) {
+        snd_midi_event_free(m_pDecoder);
+    }
+    if (m_stopEventFd >= 0) {
+        ::close(m_stopEventFd);
+    }
+}
+
+void AlsaSeqInputThread::stop() {
+    requestInterruption();
+    if (m_stopEventFd >= 0) {
+        const uint64_t value = 1;
+        ssize_t written = ::write(m_stopEventFd, &value, sizeof(value));
+        Q_UNUSED(written);
+    }
+    wait();
+}
+
+void AlsaSeqInputThread::run() {
+    VERIFY_OR_DEBUG_ASSERT(m_pDecoder && m_stopEventFd >= 0) {
+        return;
+    }
+
+    const int numSeqFds = snd_seq_poll_descriptors_count(m_pSeq, POLLIN);
+    std::vector<pollfd> fds(numSeqFds + 1);
+    snd_seq_poll_descriptors(m_pSeq, fds.data(), numSeqFds, POLLIN);
+    fds[numSeqFds] = {m_stopEventFd, POLLIN, 0};
+
+    while (!isInterruptionRequested()) {
+        // Sleep until the kernel delivers an event or stop() is called
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            qCWarning(m_logInput) << "poll() failed:" << strerror(errno);
+            break;
+        }
+        // Read all pending events, the client has been opened in
+        // non-blocking mode.
+        snd_seq_event_t* pEvent = nullptr;
+        int result;
+        while ((result = snd_seq_event_input(m_pSeq, &pEvent)) >= 0 || result == -ENOSPC) {
+            if (result == -ENOSPC) {
+                qCWarning(m_logInput) << "ALSA sequencer input overrun, events have been lost";
+                continue;
+            }
+            processEvent(pEvent);
+        }
+        if (result != -EAGAIN) {
+            qCWarning(m_logInput) << "Failed to read ALSA sequencer event:" << snd_strerror(result);
+        }
+    }
+}
+
+mixxx::Duration AlsaSeqInputThread::eventTimestamp(const snd_seq_event_t* pEvent) const {
+    if (!snd_seq_ev_is_real(pEvent)) {
+        // The event has not been stamped by our queue
+        return mixxx::Time::elapsed();
+    }
+    return m_queueStartTime +
+            mixxx::Duration::fromNanos(
+                    static_cast<qint64>(pEvent->time.time.tv_sec) * 1000000000 +
+                    pEvent->time.time.tv_nsec);
+}
+
+void AlsaSeqInputThread::processEvent(const snd_seq_event_t* pEvent) {
+    const mixxx::Duration timestamp = eventTimestamp(pEvent);
+
+    if (pEvent->type == SND_SEQ_EVENT_SYSEX) {
+        processSysexEvent(pEvent, timestamp);
+        return;
+    }
+
+    unsigned char buffer[kDecoderBufferSize];
+    const long length = snd_midi_event_decode(m_pDecoder, buffer, sizeof(buffer), pEvent);
+    if (length <= 0) {
+        // Not a MIDI message, e.g. a port subscription
+        return;
+    }
+    const unsigned char status = buffer[0];
+    if (!m_sysex.isEmpty() && status < 0xF8) {
+        // Only real-time messages may be interleaved with a SysEx message
+        qCWarning(m_logInput) << "Buggy MIDI device: SysEx interrupted!";
+        m_sysex.clear();
+    }
+    emit receivedShortMessage(status,
+            length > 1 ? buffer[1] : 0,
+            length > 2 ? buffer[2] : 0,
+            timestamp);
+}
+
+void AlsaSeqInputThread::processSysexEvent(
+        const snd_seq_event_t* pEvent, mixxx::Duration timestamp) {
+    const auto* pData = static_cast<const char*>(pEvent->data.ext.ptr);
+    const int length = static_cast<int>(pEvent->data.ext.len);
+    if (length <= 0) {
+        return;
+    }
+    if (static_cast<unsigned char>(pData[0]) ==
+            MidiUtils::opCodeValue(MidiOpCode::SystemExclusive)) {
+        // Start of a new message
+        m_sysex.clear();
+    } else if (m_sysex.isEmpty()) {
+        qCWarning(m_logInput) << "Dropping SysEx continuation without start";
+        return;
+    }
+    if (m_sysex.size() + length > kMaxSysexSize) {
+        qCWarning(m_logInput) << "Dropping SysEx message larger than" << kMaxSysexSize << "bytes";
+        m_sysex.clear();
+        return;
+    }
+    m_sysex.append(pData, length);
+    if (static_cast<unsigned char>(m_sysex.back()) ==
+            MidiUtils::opCodeValue(MidiOpCode::EndOfExclusive)) {
+        emit receivedSysex(m_sysex, timestamp);
+        m_sysex.clear();
+    }
+}
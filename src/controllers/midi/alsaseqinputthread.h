@@ -0,0 +1,56 @@
+#pragma once
+
+#include <alsa/asoundlib.h>
+
+#include <QByteArray>
+#include <QThread>
+
+#include "util/duration.h"
+#include "util/runtimeloggingcategory.h"
+
+/// Receives the MIDI events of an AlsaSeqController.
+///
+/// The thread sleeps in poll() on the file descriptors of the ALSA sequencer
+/// client until the kernel delivers an event, so unlike the polling backends
+/// input is neither delayed nor batched by a timer interval. Events are
+/// stamped by the sequencer queue when they arrive at the port, which keeps
+/// the timestamps precise even if this thread or the controller thread is
+/// woken up late.
+class AlsaSeqInputThread : public QThread {
+    Q_OBJECT
+  public:
+    /// The queue start time is the value of mixxx::Time::elapsed() when the
+    /// real time of the sequencer queue was zero.
+    AlsaSeqInputThread(snd_seq_t* pSeq,
+            const RuntimeLoggingCategory& logInput,
+            mixxx::Duration queueStartTime);
+    ~AlsaSeqInputThread() override;
+
+    /// Wakes up the run loop and waits until the thread has finished.
+    void stop();
+
+    void run() override;
+
+  signals:
+    void receivedShortMessage(unsigned char status,
+            unsigned char control,
+            unsigned char value,
+            mixxx::Duration timestamp);
+    void receivedSysex(const QByteArray& data, mixxx::Duration timestamp);
+
+  private:
+    void processEvent(const snd_seq_event_t* pEvent);
+    void processSysexEvent(const snd_seq_event_t* pEvent, mixxx::Duration timestamp);
+    mixxx::Duration eventTimestamp(const snd_seq_event_t* pEvent) const;
+
+    snd_seq_t* const m_pSeq;
+    const RuntimeLoggingCategory m_logInput;
+    const mixxx::Duration m_queueStartTime;
+
+    snd_midi_event_t* m_pDecoder;
+    /// Written by stop() to wake up the run loop
+    int m_stopEventFd;
+
+    /// SysEx messages may be split into multiple events
+    QByteArray m_sysex;
+};
@@ -103,6 +103,8 @@ LegacyMidiControllerMappingFileHandler::load(const QDomElement& root,
                 options.setFlag(MidiOption::FourteenBitMSB);
             } else if (strMidiOption == QLatin1String("fourteen-bit-lsb")) {
                 options.setFlag(MidiOption::FourteenBitLSB);
+            } else if (strMidiOption == QLatin1String("coalesce")) {
+                options.setFlag(MidiOption::Coalesce);
             }
 
             optionsNode = optionsNode.nextSiblingElement();
@@ -369,6 +371,10 @@ QDomElement LegacyMidiControllerMappingFileHandler::inputMappingToXML(
             QDomElement singleOption = doc->createElement("fourteen-bit-lsb");
             optionsNode.appendChild(singleOption);
         }
+        if (mapping.options.testFlag(MidiOption::Coalesce)) {
+            QDomElement singleOption = doc->createElement("coalesce");
+            optionsNode.appendChild(singleOption);
+        }
     }
     controlNode.appendChild(optionsNode);
 
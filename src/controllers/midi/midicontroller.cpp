@@ -16,6 +16,16 @@
 #include "moc_midicontroller.cpp"
 #include "util/make_const_iterator.h"
 #include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+/// Script functions of MidiOption::Coalesce mappings are called at most once
+/// per interval, no matter how many messages a jog wheel or touch strip sends.
+/// The first message after a pause is passed on immediately.
+constexpr mixxx::Duration kCoalescingInterval = mixxx::Duration::fromMillis(10);
+
+} // namespace
 
 const QString kMakeInputHandlerError = QStringLiteral(
         "Invalid timer callback provided to midi.makeInputHandler. "
@@ -34,12 +44,23 @@ bool MidiInputHandleJSProxy::disconnect() {
 }
 
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_coalescingTimer(this) {
+    m_coalescingTimer.setSingleShot(true);
+    m_coalescingTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_coalescingTimer,
+            &QTimer::timeout,
+            this,
+            &MidiController::flushCoalescedInputMappings);
 }
 
 void MidiController::slotBeforeEngineShutdown() {
     Controller::slotBeforeEngineShutdown();
     m_pMapping->removeInputHandlerMappings();
+    // Release the script functions before their engine is gone
+    m_coalescingTimer.stop();
+    m_pendingCoalescedEntries.clear();
+    m_inputDispatchTable.clear();
 }
 
 MidiController::~MidiController() {
@@ -59,6 +80,7 @@ QString MidiController::mappingExtension() {
 void MidiController::setMapping(std::shared_ptr<LegacyControllerMapping> pMapping) {
     m_pMutableMapping = pMapping;
     m_pMapping = downcastAndClone<LegacyMidiControllerMapping>(pMapping.get());
+    m_inputDispatchTable.invalidate();
 }
 
 QList<LegacyControllerMapping::ScriptFileInfo> MidiController::getMappingScriptFiles() {
@@ -106,6 +128,13 @@ bool MidiController::applyMapping(const QString& resourcePath) {
     // Handles the engine
     bool result = Controller::applyMapping(resourcePath);
 
+    // Compile the input mappings now, including those that have been added
+    // by the init function of the script, instead of when the first message
+    // is received.
+    if (m_pMapping) {
+        compileInputMappings();
+    }
+
     // Only execute this code if this is an output device
     if (isOutputDevice()) {
         if (m_outputs.count() > 0) {
@@ -117,6 +146,12 @@ bool MidiController::applyMapping(const QString& resourcePath) {
     return result;
 }
 
+void MidiController::compileInputMappings() {
+    // The pending entries are replaced by the new table
+    flushCoalescedInputMappings();
+    m_inputDispatchTable.compile(m_pMapping->getInputMappings(), getScriptEngine().get());
+}
+
 void MidiController::createOutputHandlers() {
     if (!m_pMapping) {
         return;
@@ -269,6 +304,7 @@ void MidiController::commitTemporaryInputMappings() {
         m_pMapping->addInputMapping(it.key(), it.value());
     }
     m_temporaryInputMappings.clear();
+    m_inputDispatchTable.invalidate();
 }
 
 void MidiController::receivedShortMessage(unsigned char status,
@@ -305,6 +341,7 @@ void MidiController::receivedShortMessage(unsigned char status,
 
         auto it = m_temporaryInputMappings.constFind(mappingKey.key);
         if (it != m_temporaryInputMappings.constEnd()) {
+            flushPendingCoalescedInputMappings();
             for (; it != m_temporaryInputMappings.constEnd() && it.key() == mappingKey.key; ++it) {
                 processInputMapping(it.value(), status, control, value, timestamp);
             }
@@ -312,11 +349,125 @@ void MidiController::receivedShortMessage(unsigned char status,
         }
     }
 
-    for (auto [it, end] =
-                    m_pMapping->getInputMappings().equal_range(mappingKey.key);
-            it != end;
-            ++it) {
-        processInputMapping(it.value(), status, control, value, timestamp);
+    if (!MidiInputDispatchTable::contains(mappingKey)) {
+        // Invalid messages that are not in the table
+        flushPendingCoalescedInputMappings();
+        for (auto [it, end] =
+                        m_pMapping->getInputMappings().equal_range(mappingKey.key);
+                it != end;
+                ++it) {
+            processInputMapping(it.value(), status, control, value, timestamp);
+        }
+        return;
+    }
+
+    if (!m_inputDispatchTable.isCompiled()) {
+        compileInputMappings();
+    }
+    for (auto& entry : m_inputDispatchTable.lookup(mappingKey)) {
+        if (entry.mapping.options.testFlag(MidiOption::Script)) {
+            if (entry.mapping.options.testFlag(MidiOption::Coalesce) &&
+                    std::holds_alternative<ConfigKey>(entry.mapping.control)) {
+                coalesceInputMapping(&entry, control, value);
+                continue;
+            }
+            flushPendingCoalescedInputMappings();
+            processInputMapping(entry.mapping,
+                    status,
+                    control,
+                    value,
+                    timestamp,
+                    nullptr,
+                    &entry.scriptFunction);
+            continue;
+        }
+        // Only pass values on to valid ControlObjects.
+        ControlObject* pControl = entry.control();
+        if (pControl) {
+            flushPendingCoalescedInputMappings();
+            processInputMapping(entry.mapping, status, control, value, timestamp, pControl);
+        }
+    }
+}
+
+void MidiController::coalesceInputMapping(MidiInputDispatchTable::Entry* pEntry,
+        unsigned char control,
+        unsigned char value) {
+    const bool isPending = !pEntry->coalescedValues.empty();
+    pEntry->coalescedControl = control;
+    pEntry->coalescedValues.push_back(value);
+    if (isPending) {
+        return;
+    }
+
+    const mixxx::Duration nextCallTime = pEntry->lastCallTime + kCoalescingInterval;
+    const mixxx::Duration now = mixxx::Time::elapsed();
+    if (now >= nextCallTime) {
+        // The values of other mappings have been received before
+        flushPendingCoalescedInputMappings();
+        executeCoalescedInputMapping(pEntry);
+        return;
+    }
+    m_pendingCoalescedEntries.push_back(pEntry);
+    if (!m_coalescingTimer.isActive()) {
+        // Round up, the values of other mappings that are received in the
+        // meantime are passed on with those of this mapping.
+        m_coalescingTimer.start(static_cast<int>(
+                (nextCallTime - now + mixxx::Duration::fromMillis(1)).toIntegerMillis()));
+    }
+}
+
+void MidiController::flushCoalescedInputMappings() {
+    m_coalescingTimer.stop();
+    // Script functions don't receive messages, so they can't add entries
+    // while iterating.
+    for (auto* pEntry : m_pendingCoalescedEntries) {
+        executeCoalescedInputMapping(pEntry);
+    }
+    m_pendingCoalescedEntries.clear();
+}
+
+void MidiController::flushPendingCoalescedInputMappings() {
+    if (!m_pendingCoalescedEntries.empty()) {
+        flushCoalescedInputMappings();
+    }
+}
+
+void MidiController::executeCoalescedInputMapping(MidiInputDispatchTable::Entry* pEntry) {
+    pEntry->lastCallTime = mixxx::Time::elapsed();
+    auto pEngine = getScriptEngine();
+    const auto* pTarget = std::get_if<ConfigKey>(&pEntry->mapping.control);
+    if (pEngine == nullptr || pEngine->jsEngine() == nullptr || pTarget == nullptr ||
+            pEntry->coalescedValues.empty()) {
+        pEntry->coalescedValues.clear();
+        return;
+    }
+    if (pEntry->scriptFunction.isUndefined()) {
+        pEntry->scriptFunction = pEngine->wrapFunctionCode(
+                pTarget->item, MidiInputDispatchTable::kNumCoalescedScriptFunctionArgs);
+    }
+
+    const unsigned char status = pEntry->mapping.key.status;
+    const unsigned char channel = MidiUtils::channelFromStatus(status);
+    const unsigned char value = pEntry->coalescedValues.back();
+    const auto numValues = static_cast<uint>(pEntry->coalescedValues.size());
+    QJSValue values = pEngine->jsEngine()->newArray(numValues);
+    for (uint i = 0; i < numValues; ++i) {
+        values.setProperty(i, pEntry->coalescedValues[i]);
+    }
+    // Keeps the capacity for the next burst
+    pEntry->coalescedValues.clear();
+
+    const auto args = QJSValueList{
+            channel,
+            pEntry->coalescedControl,
+            value,
+            status,
+            pTarget->group,
+            values,
+    };
+    if (!pEngine->executeFunction(&pEntry->scriptFunction, args)) {
+        qCWarning(m_logBase) << "MidiController: Invalid script function" << pTarget->item;
     }
 }
 
@@ -324,7 +475,9 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
         unsigned char status,
         unsigned char control,
         unsigned char value,
-        mixxx::Duration timestamp) {
+        mixxx::Duration timestamp,
+        ControlObject* pControl,
+        QJSValue* pScriptFunction) {
     Q_UNUSED(timestamp)
     unsigned char channel = MidiUtils::channelFromStatus(status);
     MidiOpCode opCode = MidiUtils::opCodeFromStatus(status);
@@ -337,10 +490,14 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
 
         return std::visit(
                 MidiUtils::overloaded{
-                        [pEngine, this, channel, status, control, value](
+                        [pEngine, this, channel, status, control, value, pScriptFunction](
                                 const ConfigKey& target) {
-                            QJSValue function = pEngine->wrapFunctionCode(
-                                    target.item, 5);
+                            QJSValue function;
+                            QJSValue* pFunction = pScriptFunction ? pScriptFunction : &function;
+                            if (pFunction->isUndefined()) {
+                                *pFunction = pEngine->wrapFunctionCode(target.item,
+                                        MidiInputDispatchTable::kNumScriptFunctionArgs);
+                            }
                             const auto args = QJSValueList{
                                     channel,
                                     control,
@@ -349,7 +506,7 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
                                     target.group,
                             };
 
-                            if (!pEngine->executeFunction(&function, args)) {
+                            if (!pEngine->executeFunction(pFunction, args)) {
                                 qCWarning(m_logBase) << "MidiController: Invalid script function"
                                                      << target.item;
                             }
@@ -379,8 +536,8 @@ void MidiController::processInputMapping(const MidiInputMapping& mapping,
     }
 
     // Only pass values on to valid ControlObjects.
-    auto configKey = std::get<ConfigKey>(mapping.control);
-    ControlObject* pCO = ControlObject::getControl(configKey);
+    const auto& configKey = std::get<ConfigKey>(mapping.control);
+    ControlObject* pCO = pControl ? pControl : ControlObject::getControl(configKey);
     if (pCO == nullptr) {
         return;
     }
@@ -609,6 +766,7 @@ void MidiController::receive(const QByteArray& data, mixxx::Duration timestamp)
 
         auto it = m_temporaryInputMappings.constFind(mappingKey.key);
         if (it != m_temporaryInputMappings.constEnd()) {
+            flushPendingCoalescedInputMappings();
             for (; it != m_temporaryInputMappings.constEnd() && it.key() == mappingKey.key; ++it) {
                 processInputMapping(it.value(), data, timestamp);
             }
@@ -616,6 +774,7 @@ void MidiController::receive(const QByteArray& data, mixxx::Duration timestamp)
         }
     }
 
+    flushPendingCoalescedInputMappings();
     for (auto [it, end] =
                     m_pMapping->getInputMappings().equal_range(mappingKey.key);
             it != end;
@@ -688,6 +847,7 @@ QJSValue MidiController::makeInputHandler(unsigned char status,
             std::make_shared<QJSValue>(scriptCode));
 
     m_pMapping->addInputMapping(inputMapping.key.key, inputMapping);
+    m_inputDispatchTable.invalidate();
     // The returned object can be used for disconnecting like this:
     // var connection = midi.makeInputHandler();
     // connection.disconnect();
@@ -696,5 +856,8 @@ QJSValue MidiController::makeInputHandler(unsigned char status,
 
 bool MidiController::removeInputMapping(
         uint16_t key, const MidiInputMapping& mapping) {
+    // Entries of the table stay valid, in case this is called from the
+    // script function of one of them.
+    m_inputDispatchTable.invalidate();
     return m_pMapping->removeInputMapping(key, mapping);
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <QJSValue>
+#include <QTimer>
+#include <vector>
 
 #include "controllers/controller.h"
 #include "controllers/midi/legacymidicontrollermapping.h"
+#include "controllers/midi/midiinputdispatchtable.h"
 #include "controllers/midi/midimessage.h"
 #include "controllers/softtakeover.h"
 
@@ -99,14 +102,30 @@ class MidiController : public Controller {
     void learnTemporaryInputMappings(const MidiInputMappings& mappings);
     void clearTemporaryInputMappings();
     void commitTemporaryInputMappings();
+    /// Passes the pending values of MidiOption::Coalesce mappings to their
+    /// script functions
+    void flushCoalescedInputMappings();
 
   private:
+    void compileInputMappings();
+    void coalesceInputMapping(MidiInputDispatchTable::Entry* pEntry,
+            unsigned char control,
+            unsigned char value);
+    /// Must be called before processing any other mapping, to keep the
+    /// order in which the messages have been received.
+    void flushPendingCoalescedInputMappings();
+    void executeCoalescedInputMapping(MidiInputDispatchTable::Entry* pEntry);
+
+    /// The target of the mapping is looked up if pControl or pScriptFunction
+    /// are not passed. An undefined pScriptFunction is wrapped in place.
     void processInputMapping(
             const MidiInputMapping& mapping,
             unsigned char status,
             unsigned char control,
             unsigned char value,
-            mixxx::Duration timestamp);
+            mixxx::Duration timestamp,
+            ControlObject* pControl = nullptr,
+            QJSValue* pScriptFunction = nullptr);
     void processInputMapping(
             const MidiInputMapping& mapping,
             const QByteArray& data,
@@ -120,6 +139,12 @@ class MidiController : public Controller {
     QHash<uint16_t, MidiInputMapping> m_temporaryInputMappings;
     QList<MidiOutputHandler*> m_outputs;
     std::unique_ptr<LegacyMidiControllerMapping> m_pMapping;
+    /// The input mappings of m_pMapping, compiled on demand
+    MidiInputDispatchTable m_inputDispatchTable;
+    /// Entries of m_inputDispatchTable with coalesced values that are passed
+    /// to their script function when m_coalescingTimer fires
+    std::vector<MidiInputDispatchTable::Entry*> m_pendingCoalescedEntries;
+    QTimer m_coalescingTimer;
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
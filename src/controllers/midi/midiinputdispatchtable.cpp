@@ -0,0 +1,78 @@
+#include "controllers/midi/midiinputdispatchtable.h"
+
+#include <algorithm>
+
+#include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
+
+ControlObject* MidiInputDispatchTable::Entry::control() {
+    if (!pControl) {
+        const auto* pConfigKey = std::get_if<ConfigKey>(&mapping.control);
+        if (pConfigKey) {
+            pControl = ControlObject::getControl(*pConfigKey);
+        }
+    }
+    return pControl;
+}
+
+MidiInputDispatchTable::MidiInputDispatchTable()
+        : m_isCompiled(false) {
+    m_rowOfStatus.fill(kNoRow);
+}
+
+void MidiInputDispatchTable::clear() {
+    m_isCompiled = false;
+    m_rowOfStatus.fill(kNoRow);
+    m_rows.clear();
+    m_entries.clear();
+}
+
+void MidiInputDispatchTable::compile(
+        const QMultiHash<uint16_t, MidiInputMapping>& mappings,
+        ControllerScriptEngineLegacy* pEngine) {
+    clear();
+
+    std::vector<MidiKey> keys;
+    for (auto it = mappings.keyBegin(); it != mappings.keyEnd(); ++it) {
+        MidiKey key;
+        key.key = *it;
+        if (contains(key)) {
+            keys.push_back(key);
+        }
+    }
+    // Group the entries of each status byte
+    std::sort(keys.begin(), keys.end(), [](MidiKey lhs, MidiKey rhs) {
+        return lhs.status < rhs.status ||
+                (lhs.status == rhs.status && lhs.control < rhs.control);
+    });
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    m_entries.reserve(mappings.size());
+    for (const MidiKey key : keys) {
+        int& row = m_rowOfStatus[key.status - kMinStatus];
+        if (row == kNoRow) {
+            row = static_cast<int>(m_rows.size());
+            // All ranges are empty
+            m_rows.push_back(Row{});
+        }
+        Range& range = m_rows[row][columnOfControl(key.control)];
+        range.begin = static_cast<int>(m_entries.size());
+        for (auto [it, end] = mappings.equal_range(key.key); it != end; ++it) {
+            Entry entry{it.value(), nullptr, QJSValue(), {}, 0, mixxx::Duration()};
+            const auto* pConfigKey = std::get_if<ConfigKey>(&entry.mapping.control);
+            if (entry.mapping.options.testFlag(MidiOption::Script)) {
+                if (pConfigKey && pEngine) {
+                    entry.scriptFunction = pEngine->wrapFunctionCode(pConfigKey->item,
+                            entry.mapping.options.testFlag(MidiOption::Coalesce)
+                                    ? kNumCoalescedScriptFunctionArgs
+                                    : kNumScriptFunctionArgs);
+                }
+            } else if (pConfigKey) {
+                entry.pControl = ControlObject::getControl(
+                        *pConfigKey, ControlFlag::NoWarnIfMissing);
+            }
+            m_entries.push_back(std::move(entry));
+        }
+        range.end = static_cast<int>(m_entries.size());
+    }
+    m_isCompiled = true;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QJSValue>
+#include <QMultiHash>
+#include <QPointer>
+#include <array>
+#include <span>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "controllers/midi/midimessage.h"
+#include "util/duration.h"
+
+class ControllerScriptEngineLegacy;
+
+/// The input mappings of a MidiController, compiled into a table that is
+/// indexed by the status and control byte of incoming short messages.
+///
+/// Looking up the mappings of a message only indexes two arrays, without
+/// hashing the MidiKey. The targets of the mappings are resolved when the
+/// table is compiled, so that dispatching a message neither looks up the
+/// ControlObject nor wraps the script function.
+class MidiInputDispatchTable {
+  public:
+    struct Entry {
+        MidiInputMapping mapping;
+        /// Only for mappings without MidiOption::Script. Controls that don't
+        /// exist yet, e.g. of decks that are added later, are resolved on
+        /// first use by control().
+        QPointer<ControlObject> pControl;
+        /// Only for script mappings with a ConfigKey target
+        QJSValue scriptFunction;
+
+        /// Only for MidiOption::Coalesce mappings: the values that have not
+        /// been passed to the script function yet, the control byte of the
+        /// latest message and when the script function has been called.
+        std::vector<unsigned char> coalescedValues;
+        unsigned char coalescedControl;
+        mixxx::Duration lastCallTime;
+
+        ControlObject* control();
+    };
+
+    /// channel, control, value, status and group
+    static constexpr int kNumScriptFunctionArgs = 5;
+    /// Followed by the array of coalesced values
+    static constexpr int kNumCoalescedScriptFunctionArgs = 6;
+
+    MidiInputDispatchTable();
+
+    bool isCompiled() const {
+        return m_isCompiled;
+    }
+
+    /// Replaces the contents of the table. Script functions are only wrapped
+    /// if an engine is passed.
+    void compile(const QMultiHash<uint16_t, MidiInputMapping>& mappings,
+            ControllerScriptEngineLegacy* pEngine);
+
+    /// Must be called after the input mappings have been modified. The
+    /// entries stay valid until the table is compiled again.
+    void invalidate() {
+        m_isCompiled = false;
+    }
+
+    /// Removes all entries, e.g. before the script engine that has
+    /// wrapped the script functions is shut down.
+    void clear();
+
+    /// Returns true if the key can be looked up in this table. Keys with a
+    /// control byte that can't be sent in a short message are not included.
+    static bool contains(MidiKey key) {
+        return key.status >= kMinStatus &&
+                (key.control <= kMaxControl || key.control == kNoControl);
+    }
+
+    /// Returns the entries for the key in the order of
+    /// QMultiHash::equal_range(), the key must be contained in the table.
+    std::span<Entry> lookup(MidiKey key) {
+        const int row = m_rowOfStatus[key.status - kMinStatus];
+        if (row == kNoRow) {
+            return {};
+        }
+        const Range range = m_rows[row][columnOfControl(key.control)];
+        return std::span<Entry>(m_entries.data() + range.begin, range.end - range.begin);
+    }
+
+  private:
+    static constexpr unsigned char kMinStatus = 0x80;
+    static constexpr unsigned char kMaxControl = 0x7F;
+    /// The control byte of MidiKeys of messages without a control byte
+    static constexpr unsigned char kNoControl = 0xFF;
+    static constexpr int kNumStatus = 0x100 - kMinStatus;
+    static constexpr int kNumColumns = kMaxControl + 2;
+    static constexpr int kNoRow = -1;
+
+    static int columnOfControl(unsigned char control) {
+        return control == kNoControl ? kNumColumns - 1 : control;
+    }
+
+    struct Range {
+        int begin;
+        int end;
+    };
+    /// The controls of a single status byte
+    using Row = std::array<Range, kNumColumns>;
+
+    bool m_isCompiled;
+    /// Only status bytes with mappings have a row, which keeps the table
+    /// small enough to stay in the cache.
+    std::array<int, kNumStatus> m_rowOfStatus;
+    std::vector<Row> m_rows;
+    std::vector<Entry> m_entries;
+};
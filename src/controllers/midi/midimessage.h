@@ -131,6 +131,9 @@ enum class MidiOption : uint16_t {
     FourteenBitMSB = 0x2000,
     /// Generic Hercules Range Correction (0x01 -> +5; 0x7f -> -5)
     HercJogFast = 0x4000,
+    /// Calls the script function of a script binding at most once per
+    /// coalescing interval with all values received in between
+    Coalesce = 0x8000,
 };
 Q_DECLARE_FLAGS(MidiOptions, MidiOption);
 Q_DECLARE_OPERATORS_FOR_FLAGS(MidiOptions);
@@ -57,6 +57,8 @@ QString MidiUtils::midiOptionToTranslatedString(MidiOption option) {
         return QObject::tr("14-bit (LSB)");
     case MidiOption::FourteenBitMSB:
         return QObject::tr("14-bit (MSB)");
+    case MidiOption::Coalesce:
+        return QObject::tr("Coalesce");
     default:
         return QObject::tr("Unknown (0x%1)")
                 .arg(static_cast<uint16_t>(option), 4, 16, QLatin1Char('0'));
@@ -12,6 +12,7 @@
 #include <QQuickWindow>
 #include <QThread>
 #include <QTimer>
+#include <cstring>
 
 #include "controllers/controller.h"
 #include "controllers/controllerenginethreadcontrol.h"
@@ -41,6 +42,8 @@ ControllerRenderingEngine::ControllerRenderingEngine(
         gsl::not_null<ControllerEngineThreadControl*> engineThreadControl)
         : QObject(),
           m_screenInfo(info),
+          m_nextPixelBuffer(0),
+          m_synchronousReadback(false),
           m_GLDataFormat(GL_RGBA),
           m_GLDataType(GL_UNSIGNED_BYTE),
           m_isValid(true),
@@ -255,7 +258,11 @@ void ControllerRenderingEngine::finish() {
                 });
         m_quickWindow.reset();
 
-        // Free the engine and FBO.
+        // Free the engine, the pixel buffers and FBO.
+        for (auto& pPixelBuffer : m_pixelBuffers) {
+            pPixelBuffer.reset();
+        }
+        m_pendingFrameTimestamp = QDateTime();
         m_fbo.reset();
 
         m_context->doneCurrent();
@@ -300,6 +307,8 @@ void ControllerRenderingEngine::renderFrame() {
 
         m_quickWindow->setGeometry(0, 0, m_screenInfo.size.width(), m_screenInfo.size.height());
 
+        createPixelBuffers();
+
         m_context->doneCurrent();
     }
 
@@ -332,15 +341,6 @@ void ControllerRenderingEngine::renderFrame() {
     VERIFY_OR_TERMINATE(m_context->makeCurrent(m_offscreenSurface.get()),
             "Couldn't make the GLContext current to the OffscreenSurface.");
 
-#ifdef QT_OPENGL_ES_2
-    // OpenGL ES doesn't support extended format and type when reading pixel and
-    // only support GL_RGBA/GL_UNSIGNED_BYTE On this platform, we fallback to Qt
-    // for the pixel transformation, using QImage conversion capabilities
-    QImage fboImage(m_screenInfo.size, QImage::Format_RGBA8888);
-#else
-    QImage fboImage(m_screenInfo.size, m_screenInfo.pixelFormat);
-#endif
-
     VERIFY_OR_DEBUG_ASSERT(m_fbo->bind()) {
         kLogger.warning() << "Couldn't bind the FBO.";
     }
@@ -368,6 +368,82 @@ void ControllerRenderingEngine::renderFrame() {
     while ((glError = m_context->functions()->glGetError()) != GL_NO_ERROR) {
         kLogger.debug() << "Retrieved a previously unhandled GL error: " << glError;
     }
+
+#ifndef QT_OPENGL_ES_2
+    if (m_pixelBuffers[0] && m_synchronousReadback.load(std::memory_order_relaxed)) {
+        // The frame that is still pending is superseded by the current one
+        m_pendingFrameTimestamp = QDateTime();
+    } else if (m_pixelBuffers[0]) {
+        // glReadPixels only starts the transfer into the pixel buffer and
+        // returns right away, which gives the GPU a whole frame to complete
+        // it. Meanwhile, the frame of the other buffer is delivered.
+        QOpenGLBuffer* pTransferBuffer = m_pixelBuffers[m_nextPixelBuffer].get();
+        {
+            ScopedTimer t(QStringLiteral("ControllerRenderingEngine::renderFrame::glReadPixels"));
+            pTransferBuffer->bind();
+            m_context->functions()->glReadPixels(0,
+                    0,
+                    m_screenInfo.size.width(),
+                    m_screenInfo.size.height(),
+                    m_GLDataFormat,
+                    m_GLDataType,
+                    nullptr);
+            pTransferBuffer->release();
+        }
+        glError = m_context->functions()->glGetError();
+        VERIFY_OR_TERMINATE(glError == GL_NO_ERROR, "GLError after glReadPixels: " << glError);
+        m_nextPixelBuffer = 1 - m_nextPixelBuffer;
+
+        QImage frame;
+        const QDateTime frameTimestamp = m_pendingFrameTimestamp;
+        if (frameTimestamp.isValid()) {
+            ScopedTimer t(QStringLiteral("ControllerRenderingEngine::renderFrame::mapPixelBuffer"));
+            QOpenGLBuffer* pPendingBuffer = m_pixelBuffers[m_nextPixelBuffer].get();
+            pPendingBuffer->bind();
+            const auto* pPixels = static_cast<const uchar*>(
+                    pPendingBuffer->map(QOpenGLBuffer::ReadOnly));
+            VERIFY_OR_TERMINATE(pPixels, "Couldn't map the pixel buffer.");
+            frame = QImage(m_screenInfo.size, m_screenInfo.pixelFormat);
+            // The rows are stored bottom-up by OpenGL, so the frame is
+            // flipped while it is copied out of the buffer. Both use the
+            // default row alignment of 4 bytes.
+            const qsizetype bytesPerLine = frame.bytesPerLine();
+            const int height = frame.height();
+            for (int y = 0; y < height; ++y) {
+                std::memcpy(frame.scanLine(y),
+                        pPixels + (height - 1 - y) * bytesPerLine,
+                        bytesPerLine);
+            }
+            pPendingBuffer->unmap();
+            pPendingBuffer->release();
+        }
+        m_pendingFrameTimestamp = timestamp;
+
+        VERIFY_OR_DEBUG_ASSERT(m_fbo->release()) {
+            kLogger.debug() << "Couldn't release the FBO.";
+        }
+        m_context->doneCurrent();
+
+        if (frame.isNull()) {
+            // The first frame is still being transferred. Nothing can be
+            // sent, so the next frame is rendered right away to keep the
+            // frame loop going.
+            QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateRequest));
+            return;
+        }
+        emit frameRendered(m_screenInfo, frame, frameTimestamp);
+        return;
+    }
+#endif
+
+#ifdef QT_OPENGL_ES_2
+    // OpenGL ES doesn't support extended format and type when reading pixel and
+    // only support GL_RGBA/GL_UNSIGNED_BYTE On this platform, we fallback to Qt
+    // for the pixel transformation, using QImage conversion capabilities
+    QImage fboImage(m_screenInfo.size, QImage::Format_RGBA8888);
+#else
+    QImage fboImage(m_screenInfo.size, m_screenInfo.pixelFormat);
+#endif
     {
         ScopedTimer t(QStringLiteral("ControllerRenderingEngine::renderFrame::glReadPixels"));
         m_context->functions()->glReadPixels(0,
@@ -449,6 +525,41 @@ void ControllerRenderingEngine::renderFrame() {
     emit frameRendered(m_screenInfo, fboImage.copy(), timestamp);
 }
 
+void ControllerRenderingEngine::createPixelBuffers() {
+#ifndef QT_OPENGL_ES_2
+    // Pixel buffer objects are core since OpenGL 2.1
+    if (m_context->isOpenGLES() ||
+            (m_context->format().version() < qMakePair(2, 1) &&
+                    !m_context->hasExtension(QByteArrayLiteral("GL_ARB_pixel_buffer_object")))) {
+        kLogger.info() << "Pixel buffer objects are not supported, frames are "
+                          "read back synchronously";
+        return;
+    }
+    const int bytesPerLine =
+            (m_screenInfo.size.width() *
+                            QImage::toPixelFormat(m_screenInfo.pixelFormat).bitsPerPixel() +
+                    31) /
+            32 * 4;
+    for (auto& pPixelBuffer : m_pixelBuffers) {
+        pPixelBuffer = std::make_unique<QOpenGLBuffer>(QOpenGLBuffer::PixelPackBuffer);
+        pPixelBuffer->setUsagePattern(QOpenGLBuffer::StreamRead);
+        if (!pPixelBuffer->create()) {
+            kLogger.warning() << "Couldn't create the pixel buffers, frames are "
+                                 "read back synchronously";
+            for (auto& pCreatedPixelBuffer : m_pixelBuffers) {
+                pCreatedPixelBuffer.reset();
+            }
+            return;
+        }
+        pPixelBuffer->bind();
+        pPixelBuffer->allocate(bytesPerLine * m_screenInfo.size.height());
+        pPixelBuffer->release();
+    }
+    m_nextPixelBuffer = 0;
+    m_pendingFrameTimestamp = QDateTime();
+#endif
+}
+
 bool ControllerRenderingEngine::stop() {
     m_pThread->quit();
     return m_pThread->wait();
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QDateTime>
 #include <QObject>
+#include <QOpenGLBuffer>
 #include <QOpenGLContext>
 #include <QOpenGLFramebufferObject>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <gsl/pointers>
 
@@ -52,6 +56,14 @@ class ControllerRenderingEngine : public QObject {
         return m_screenInfo;
     }
 
+    /// Reads back all following frames synchronously instead of through the
+    /// pixel buffers, which deliver each frame one frame late. Used when
+    /// shutting down, so the last frame of the splash off animation is
+    /// delivered before the screen is stopped. Thread-safe.
+    void requestSynchronousReadback() {
+        m_synchronousReadback.store(true, std::memory_order_relaxed);
+    }
+
   public slots:
     // Request sending frame data to the device. The task will be run in the
     // rendering event loop. This method should only be called once received the
@@ -83,6 +95,9 @@ class ControllerRenderingEngine : public QObject {
 
   private:
     virtual void prepare();
+    /// Creates the pixel buffers for asynchronous readback, if they are
+    /// supported by the current context.
+    void createPixelBuffers();
 
     std::chrono::time_point<std::chrono::steady_clock> m_nextFrameStart;
 
@@ -97,6 +112,16 @@ class ControllerRenderingEngine : public QObject {
 
     std::unique_ptr<QOpenGLFramebufferObject> m_fbo;
 
+    /// Double-buffered readback: while the pixels of a frame are transferred
+    /// into one buffer, the frame in the other buffer is delivered. Empty if
+    /// pixel buffers are unsupported, e.g. on OpenGL ES 2.
+    std::array<std::unique_ptr<QOpenGLBuffer>, 2> m_pixelBuffers;
+    int m_nextPixelBuffer;
+    /// The timestamp of the frame that is being transferred into the pixel
+    /// buffer that was not written last, invalid if there is none.
+    QDateTime m_pendingFrameTimestamp;
+    std::atomic<bool> m_synchronousReadback;
+
     GLenum m_GLDataFormat;
     GLenum m_GLDataType;
 
@@ -12,6 +12,7 @@
 #include <QQuickWindow>
 #include <QtEndian>
 #include <algorithm>
+#include <cstring>
 #endif
 
 #include "controllers/controller.h"
@@ -24,6 +25,36 @@
 #include "util/cmdlineargs.h"
 
 using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/// Returns the bands of consecutive rows that differ between the frames, or
+/// the whole frame if it can't be compared with the previous one.
+QList<QRect> changedAreas(const QImage& previousFrame, const QImage& frame) {
+    if (previousFrame.isNull() || previousFrame.size() != frame.size() ||
+            previousFrame.format() != frame.format()) {
+        return {frame.rect()};
+    }
+    QList<QRect> areas;
+    // Ignore the padding at the end of the rows
+    const auto bytesPerRow = static_cast<std::size_t>(frame.width() * frame.depth() / 8);
+    int firstChangedRow = -1;
+    for (int y = 0; y <= frame.height(); ++y) {
+        const bool changed = y < frame.height() &&
+                std::memcmp(previousFrame.constScanLine(y),
+                        frame.constScanLine(y),
+                        bytesPerRow) != 0;
+        if (changed && firstChangedRow < 0) {
+            firstChangedRow = y;
+        } else if (!changed && firstChangedRow >= 0) {
+            areas.append(QRect(0, firstChangedRow, frame.width(), y - firstChangedRow));
+            firstChangedRow = -1;
+        }
+    }
+    return areas;
+}
+
+} // anonymous namespace
 #endif
 
 ControllerScriptEngineLegacy::ControllerScriptEngineLegacy(
@@ -193,7 +224,8 @@ QJSValue ControllerScriptEngineLegacy::wrapFunctionCode(
 
     QJSValue wrappedFunction;
 
-    const auto it = m_scriptWrappedFunctionCache.constFind(codeSnippet);
+    const auto cacheKey = qMakePair(codeSnippet, numberOfArgs);
+    const auto it = m_scriptWrappedFunctionCache.constFind(cacheKey);
     if (it != m_scriptWrappedFunctionCache.constEnd()) {
         wrappedFunction = it.value();
     } else {
@@ -211,7 +243,7 @@ QJSValue ControllerScriptEngineLegacy::wrapFunctionCode(
         if (wrappedFunction.isError()) {
             showScriptExceptionDialog(wrappedFunction);
         }
-        m_scriptWrappedFunctionCache[codeSnippet] = wrappedFunction;
+        m_scriptWrappedFunctionCache[cacheKey] = wrappedFunction;
     }
     return wrappedFunction;
 }
@@ -564,11 +596,24 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         qCWarning(m_logger) << "Controller JS engine has an unhandled error. Discarding.";
         qCDebug(m_logger) << "Controller JS error is:" << m_pJSEngine->catchError().toString();
     }
+    const QList<QRect> areas = changedAreas(
+            m_lastScreenFrames.value(screenInfo.identifier), frame);
+    QJSValue changedAreasArray = m_pJSEngine->newArray(static_cast<uint>(areas.size()));
+    for (int i = 0; i < areas.size(); ++i) {
+        QJSValue area = m_pJSEngine->newObject();
+        area.setProperty(QStringLiteral("x"), areas[i].x());
+        area.setProperty(QStringLiteral("y"), areas[i].y());
+        area.setProperty(QStringLiteral("width"), areas[i].width());
+        area.setProperty(QStringLiteral("height"), areas[i].height());
+        changedAreasArray.setProperty(static_cast<quint32>(i), area);
+    }
+
     // During the frame transformation, any QML errors are considered fatal.
     setErrorsAreFatal(true);
     auto result = pScreen->getTransform().call(
             QJSValueList{m_pJSEngine->toScriptValue(input),
-                    m_pJSEngine->toScriptValue(timestamp)});
+                    m_pJSEngine->toScriptValue(timestamp),
+                    changedAreasArray});
     if (result.isError()) {
         qCWarning(m_logger) << "Could not transform rendering buffer for screen"
                             << screenInfo.identifier;
@@ -600,6 +645,9 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
         qCWarning(m_logger) << "Unable to interpret the returned data " << returnedValue;
         return;
     }
+    // The changed areas are relative to the last frame that has actually
+    // been transformed, so a failed transformation doesn't lose changes.
+    m_lastScreenFrames.insert(screenInfo.identifier, frame);
 
     if (CmdlineArgs::Instance().getControllerDebug()) {
         qCDebug(m_logger) << "Transform screen data for screen " << screenInfo.identifier
@@ -614,6 +662,13 @@ void ControllerScriptEngineLegacy::handleScreenFrame(
 #endif
 
 void ControllerScriptEngineLegacy::shutdown() {
+#ifdef MIXXX_USE_QML
+    // Otherwise the last frame of the splash off animation would remain in
+    // the pixel buffer when stopping the screen.
+    for (const auto& pScreen : std::as_const(m_renderingScreens)) {
+        pScreen->requestSynchronousReadback();
+    }
+#endif
     callShutdownFunction();
 
 #ifdef MIXXX_USE_QML
@@ -636,6 +691,7 @@ void ControllerScriptEngineLegacy::shutdown() {
     }
 
     m_rootItems.clear();
+    m_lastScreenFrames.clear();
     for (const auto& pScreen : std::as_const(m_renderingScreens)) {
         // When stopping, the rendering engine emits an event which triggers the
         // shutdown in case it was initiated following a rendering issue. We
@@ -122,12 +122,16 @@ class ControllerScriptEngineLegacy : public ControllerScriptEngineBase {
     // identifier (LegacyControllerMapping::ScreenInfo::identifier), value in
     // the QML root item.
     std::unordered_map<QString, std::unique_ptr<mixxx::qml::QmlMixxxControllerScreen>> m_rootItems;
+    // The last frame of each screen, which the next frame is compared with
+    // to find the areas that have changed.
+    QHash<QString, QImage> m_lastScreenFrames;
     QList<LegacyControllerMapping::QMLModuleInfo> m_modules;
     QList<LegacyControllerMapping::ScreenInfo> m_infoScreens;
     QString m_resourcePath;
 #endif
     QList<QJSValue> m_incomingDataFunctions;
-    QHash<QString, QJSValue> m_scriptWrappedFunctionCache;
+    /// The wrapped functions by code snippet and number of arguments
+    QHash<QPair<QString, int>, QJSValue> m_scriptWrappedFunctionCache;
     QList<LegacyControllerMapping::ScriptFileInfo> m_scriptFiles;
     QHash<QString, QJSValue> m_settings;
 
@@ -49,11 +49,15 @@
 #include "qml/qmlsoundmanagerproxy.h"
 #endif
 #include "soundio/soundmanager.h"
+#ifdef __FFMPEG__
+#include "sources/soundsourceffmpeg.h"
+#endif
 #include "sources/soundsourceproxy.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/font.h"
 #include "util/logger.h"
+#include "util/realtimetrace.h"
 #include "util/screensavermanager.h"
 #include "util/statsmanager.h"
 #include "util/time.h"
@@ -371,6 +375,9 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
     }
+    if (m_cmdlineArgs.getRealtimeTraceEnabled()) {
+        mixxx::RealtimeTrace::setEnabled(true);
+    }
     mixxx::Translations::initializeTranslations(
             m_pSettingsManager->settings(), pApp, m_cmdlineArgs.getLocale());
     initializeKeyboard();
@@ -390,6 +397,12 @@ CoreServices::~CoreServices() {
         StatsManager::destroy();
     }
 
+    // The engine has been shut down in finalize(), so all events are complete
+    if (m_cmdlineArgs.getRealtimeTraceEnabled()) {
+        mixxx::RealtimeTrace::setEnabled(false);
+        mixxx::RealtimeTrace::writeChromeTrace(m_cmdlineArgs.getRealtimeTracePath());
+    }
+
     // HACK: Save config again. We saved it once before doing some dangerous
     // stuff. We only really want to save it here, but the first one was just
     // a precaution. The earlier one can be removed when stuff is more stable
@@ -484,6 +497,11 @@ void CoreServices::initialize(QApplication* pApp) {
     UserSettingsPointer pConfig = m_pSettingsManager->settings();
 
     Sandbox::setPermissionsFilePath(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
+#ifdef __FFMPEG__
+    mixxx::SoundSourceFFmpeg::setSeekIndexDirPath(
+            QDir(pConfig->getSettingsPath()).filePath("seekindex"));
+    mixxx::SoundSourceFFmpeg::pruneSeekIndexes();
+#endif
 
     QString resourcePath = pConfig->getResourcePath();
 
@@ -21,6 +21,11 @@ class ReverbGroupState : public EffectState {
     }
     ~ReverbGroupState() override = default;
 
+    void clear() {
+        sendPrevious = 0;
+        reverb.activate();
+    }
+
     float sampleRate;
     float sendPrevious;
     MixxxPlateX2 reverb;
@@ -5,6 +5,7 @@
 #include <QPair>
 #include <QString>
 
+#include "effects/backends/effectstatepool.h"
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
 #include "engine/effects/groupfeaturestate.h"
@@ -51,6 +52,8 @@
 /// without wasting a lot of memory. (EffectStates could be (de)allocated when toggling
 /// the enable switches for EffectSlots as well, but the memory savings would be
 /// relatively small compared to the additional code complexity.)
+/// EffectStates with a clear() method are recycled through the EffectStatePool
+/// of their type instead of being deleted and allocated again.
 class EffectState {
   public:
     EffectState(const mixxx::EngineParameters& engineParameters) {
@@ -127,6 +130,14 @@ class EffectProcessorImpl : public EffectProcessor {
         if (kEffectDebugOutput) {
             qDebug() << "~EffectProcessorImpl" << this;
         }
+        if constexpr (RecyclableEffectState<EffectSpecificState>) {
+            auto& pool = EffectStatePool<EffectSpecificState>::instance();
+            for (auto& outputChannelStates : m_channelStateMatrix) {
+                for (auto& pState : outputChannelStates) {
+                    pool.release(pState.release());
+                }
+            }
+        }
     };
 
     /// NOTE: Subclasses for Built-In effects must implement the following static methods for
@@ -244,6 +255,17 @@ class EffectProcessorImpl : public EffectProcessor {
     /// subclasses for built-in effects should not.
     virtual EffectSpecificState* createSpecificState(
             const mixxx::EngineParameters& engineParameters) {
+        if constexpr (RecyclableEffectState<EffectSpecificState>) {
+            EffectSpecificState* pState =
+                    EffectStatePool<EffectSpecificState>::instance().acquire();
+            if (pState) {
+                pState->clear();
+                if (kEffectDebugOutput) {
+                    qDebug() << this << "EffectProcessorImpl recycling EffectState" << pState;
+                }
+                return pState;
+            }
+        }
         EffectSpecificState* pState = new EffectSpecificState(engineParameters);
         if (kEffectDebugOutput) {
             qDebug() << this << "EffectProcessorImpl creating EffectState" << pState;
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/// EffectStates that can be reset to their initial state and are
+/// therefore recycled by the EffectStatePool.
+template<typename EffectSpecificState>
+concept RecyclableEffectState = requires(EffectSpecificState& state) {
+    state.clear();
+};
+
+/// Keeps the EffectStates of all unloaded effects of one type for reuse.
+/// Effect states with delay lines hold several megabytes, allocating and
+/// deleting them whenever an effect is swapped or the routing of an effect
+/// chain is toggled stalls the main thread.
+///
+/// The pool only retains states that have been in use before and never
+/// more than kCapacity. This is enough for the states of one effect type
+/// in all decks, samplers, and auxiliary inputs with both outputs. Each slot
+/// is exchanged atomically, so states can be acquired and released from any
+/// thread without locking.
+template<typename EffectSpecificState>
+class EffectStatePool {
+  public:
+    static constexpr int kCapacity = 64;
+
+    static EffectStatePool& instance() {
+        static EffectStatePool s_instance;
+        return s_instance;
+    }
+
+    EffectStatePool() = default;
+    EffectStatePool(const EffectStatePool&) = delete;
+    EffectStatePool& operator=(const EffectStatePool&) = delete;
+
+    ~EffectStatePool() {
+        for (auto& slot : m_slots) {
+            delete slot.exchange(nullptr);
+        }
+    }
+
+    /// Returns a recycled state that needs to be reset by the caller
+    /// or nullptr if the pool is empty.
+    EffectSpecificState* acquire() {
+        for (auto& slot : m_slots) {
+            if (slot.load(std::memory_order_relaxed)) {
+                EffectSpecificState* pState = slot.exchange(nullptr, std::memory_order_acquire);
+                if (pState) {
+                    return pState;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /// Takes ownership of the state, it is deleted if the pool is full.
+    void release(EffectSpecificState* pState) {
+        if (!pState) {
+            return;
+        }
+        for (auto& slot : m_slots) {
+            EffectSpecificState* pEmpty = nullptr;
+            if (slot.compare_exchange_strong(pEmpty, pState, std::memory_order_release)) {
+                return;
+            }
+        }
+        delete pState;
+    }
+
+    int size() const {
+        int size = 0;
+        for (const auto& slot : m_slots) {
+            if (slot.load(std::memory_order_relaxed)) {
+                ++size;
+            }
+        }
+        return size;
+    }
+
+  private:
+    std::array<std::atomic<EffectSpecificState*>, kCapacity> m_slots{};
+};
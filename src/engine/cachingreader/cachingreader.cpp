@@ -1,13 +1,17 @@
 #include "engine/cachingreader/cachingreader.h"
 
 #include <QtDebug>
+#include <algorithm>
+#include <cmath>
 
 #include "moc_cachingreader.cpp"
 #include "util/assert.h"
 #include "util/compatibility/qatomic.h"
 #include "util/counter.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/sample.h"
+#include "util/time.h"
 
 namespace {
 
@@ -35,12 +39,70 @@ constexpr SINT kDefaultHintFrames = 1024;
 // massive drop outs are expected to occur Mixxx should run reliably!
 constexpr SINT kNumberOfCachedChunksInMemory = 80;
 
+constexpr SINT kChunkReadRequestFifoSize = kNumberOfCachedChunksInMemory / 4;
+
+// Preloading only uses a part of the request FIFO. The remaining capacity
+// is reserved for the hints of the next callbacks, which are more urgent
+// and would be dropped if the worker has not yet caught up with the
+// preload requests.
+constexpr SINT kMaxPreloadRequestsPerCallback = kChunkReadRequestFifoSize / 4;
+constexpr SINT kMinWriteAvailableForPreload = kChunkReadRequestFifoSize / 2;
+
+// The size of the cache can be increased per deck by specifying the number of
+// minutes of audio that should fit into memory. Tracks that are shorter than
+// this are decoded completely in the background after loading, which ensures
+// that no jump to any position of the track results in a cache miss.
+//
+//     10 minutes @ 48 kHz stereo -> 352 chunks -> 22 MB
+//
+// The budget refers to 48 kHz. Tracks with a higher sample rate may not
+// fit completely into memory and are then cached partially as before.
+const ConfigKey kCacheSizeMinutesCfgKey =
+        ConfigKey(QStringLiteral("[App]"), QStringLiteral("caching_reader_cache_minutes"));
+
+constexpr double kCacheSizeReferenceSampleRate = 48000;
+
+// Tracks that are not longer than this are decoded completely into memory
+// in the background after loading. Subsequent reads are served from memory
+// without seeking and decoding. Disabled by default because of the memory
+// consumption, e.g. for a 10 minutes stereo track @ 44.1 kHz:
+//
+//     32-bit samples -> 212 MB
+//     16-bit samples -> 106 MB
+//
+// Stem tracks need 4 times as much.
+const ConfigKey kPreDecodeMinutesCfgKey =
+        ConfigKey(QStringLiteral("[App]"), QStringLiteral("caching_reader_predecode_minutes"));
+
+// Store the pre-decoded samples with 16-bit instead of 32-bit floats.
+// Disabled by default, because the 16-bit samples only have a headroom
+// of 6 dB above full scale.
+const ConfigKey kPreDecodeInt16CfgKey =
+        ConfigKey(QStringLiteral("[App]"), QStringLiteral("caching_reader_predecode_16bit"));
+
+SINT numberOfCachedChunksInMemory(const UserSettingsPointer& pConfig) {
+    if (!pConfig) {
+        return kNumberOfCachedChunksInMemory;
+    }
+    const double cacheSizeMinutes = pConfig->getValue(kCacheSizeMinutesCfgKey, 0.0);
+    if (!(cacheSizeMinutes > 0)) {
+        return kNumberOfCachedChunksInMemory;
+    }
+    const auto numberOfChunks = static_cast<SINT>(std::ceil(
+            cacheSizeMinutes * 60 * kCacheSizeReferenceSampleRate /
+            CachingReaderChunk::kFrames));
+    return math_max(numberOfChunks, kNumberOfCachedChunksInMemory);
+}
+
+constexpr SINT kInvalidChunkIndex = -1;
+
 } // anonymous namespace
 
 CachingReader::CachingReader(const QString& group,
         UserSettingsPointer config,
         mixxx::audio::ChannelCount maxSupportedChannel)
         : m_pConfig(config),
+          m_numberOfChunks(numberOfCachedChunksInMemory(config)),
           // Limit the number of in-flight requests to the worker. This should
           // prevent to overload the worker when it is not able to fetch those
           // requests from the FIFO timely. Otherwise outdated requests pile up
@@ -50,25 +112,29 @@ CachingReader::CachingReader(const QString& group,
           // buffer, where new requests replace old requests when full. Those
           // old requests need to be returned immediately to the CachingReader
           // that must take ownership and free them!!!
-          m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
+          m_chunkReadRequestFIFO(kChunkReadRequestFifoSize),
           // The capacity of the back channel must be equal to the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
           // the worker could get stuck in a hot loop!!!
-          m_readerStatusUpdateFIFO(kNumberOfCachedChunksInMemory),
+          m_readerStatusUpdateFIFO(m_numberOfChunks),
           m_state(STATE_IDLE),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
           m_sampleBuffer(CachingReaderChunk::kFrames * maxSupportedChannel *
-                  kNumberOfCachedChunksInMemory),
+                  m_numberOfChunks),
+          m_nextPreloadChunkIndex(kInvalidChunkIndex),
+          m_lastPreloadChunkIndex(kInvalidChunkIndex),
           m_worker(group,
+                  config ? config->getValue(kPreDecodeMinutesCfgKey, 0.0) : 0.0,
+                  config ? config->getValue(kPreDecodeInt16CfgKey, false) : false,
                   &m_chunkReadRequestFIFO,
                   &m_readerStatusUpdateFIFO,
                   maxSupportedChannel) {
-    m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
+    m_allocatedCachingReaderChunks.reserve(m_numberOfChunks);
     // Divide up the allocated raw memory buffer into total_chunks
     // chunks. Initialize each chunk to hold nothing and add it to the free
     // list.
-    for (SINT i = 0; i < kNumberOfCachedChunksInMemory; ++i) {
+    for (SINT i = 0; i < m_numberOfChunks; ++i) {
         CachingReaderChunkForOwner* c =
                 new CachingReaderChunkForOwner(
                         mixxx::SampleBuffer::WritableSlice(
@@ -204,6 +270,95 @@ CachingReaderChunkForOwner* CachingReader::lookupChunkAndFreshen(SINT chunkIndex
     return pChunk;
 }
 
+bool CachingReader::requestChunk(CachingReaderChunkForOwner* pChunk,
+        ReadRequestPriority priority,
+        qint64 timestampNanos) {
+    const SINT chunkIndex = pChunk->getIndex();
+    // Do not insert the allocated chunk into the MRU/LRU list,
+    // because it will be handed over to the worker immediately
+    CachingReaderChunkReadRequest request;
+    request.giveToWorker(pChunk, priority, timestampNanos);
+    if (kLogger.traceEnabled()) {
+        kLogger.trace()
+                << "Requesting read of chunk"
+                << request.chunk;
+    }
+    if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+        kLogger.warning()
+                << "Failed to submit read request for chunk"
+                << chunkIndex;
+        // Revoke the chunk from the worker and free it
+        pChunk->takeFromWorker();
+        freeChunk(pChunk);
+        return false;
+    }
+    return true;
+}
+
+void CachingReader::startPreload() {
+    m_nextPreloadChunkIndex = kInvalidChunkIndex;
+    m_lastPreloadChunkIndex = kInvalidChunkIndex;
+    if (m_numberOfChunks <= kNumberOfCachedChunksInMemory ||
+            m_readableFrameIndexRange.empty()) {
+        return;
+    }
+    const SINT firstChunkIndex =
+            CachingReaderChunk::indexForFrame(m_readableFrameIndexRange.start());
+    const SINT lastChunkIndex =
+            CachingReaderChunk::indexForFrame(m_readableFrameIndexRange.end() - 1);
+    if (lastChunkIndex - firstChunkIndex + 1 > m_numberOfChunks) {
+        kLogger.debug()
+                << "Track too long for being preloaded into"
+                << m_numberOfChunks
+                << "chunks";
+        return;
+    }
+    m_nextPreloadChunkIndex = firstChunkIndex;
+    m_lastPreloadChunkIndex = lastChunkIndex;
+}
+
+bool CachingReader::preloadChunks() {
+    if (m_nextPreloadChunkIndex == kInvalidChunkIndex) {
+        return false;
+    }
+    bool requested = false;
+    SINT numRequests = 0;
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    while (m_nextPreloadChunkIndex <= m_lastPreloadChunkIndex &&
+            numRequests < kMaxPreloadRequestsPerCallback &&
+            m_chunkReadRequestFIFO.writeAvailable() > kMinWriteAvailableForPreload) {
+        const SINT chunkIndex = m_nextPreloadChunkIndex;
+        if (!lookupChunk(chunkIndex)) {
+            // The whole track fits into the cache, so don't expire any
+            // chunk and stop preloading if this is not the case anymore.
+            CachingReaderChunkForOwner* pChunk = allocateChunk(chunkIndex);
+            if (!pChunk) {
+                kLogger.warning()
+                        << "Abort preloading: No free chunk available";
+                m_nextPreloadChunkIndex = kInvalidChunkIndex;
+                return requested;
+            }
+            if (!requestChunk(pChunk, ReadRequestPriority::Preload, nowNanos)) {
+                // Retry with the next callback
+                return requested;
+            }
+            requested = true;
+            ++numRequests;
+        }
+        ++m_nextPreloadChunkIndex;
+    }
+    if (m_nextPreloadChunkIndex > m_lastPreloadChunkIndex) {
+        if (kLogger.debugEnabled()) {
+            kLogger.debug()
+                    << "Requested all chunks up to"
+                    << m_lastPreloadChunkIndex
+                    << "for preloading";
+        }
+        m_nextPreloadChunkIndex = kInvalidChunkIndex;
+    }
+    return requested;
+}
+
 // Invoked from the UI thread!!
 #ifdef __STEM__
 void CachingReader::newTrack(TrackPointer pTrack, mixxx::StemChannelSelection stemMask) {
@@ -284,6 +439,7 @@ void CachingReader::process() {
                 }
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
+                startPreload();
                 m_state.storeRelease(STATE_TRACK_LOADED);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
@@ -542,11 +698,33 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         return;
     }
 
+    // Process the hints by priority, so the most urgent requests are
+    // submitted first if the FIFO is about to become full. Stable for hints
+    // with equal priority by using the index as secondary key.
+    m_sortedHintIndices.resize(hintList.size());
+    for (int i = 0; i < hintList.size(); ++i) {
+        m_sortedHintIndices[i] = i;
+    }
+    std::sort(m_sortedHintIndices.begin(),
+            m_sortedHintIndices.end(),
+            [&hintList](int lhs, int rhs) {
+                const auto lhsPriority = Hint::priority(hintList[lhs].type);
+                const auto rhsPriority = Hint::priority(hintList[rhs].type);
+                if (lhsPriority != rhsPriority) {
+                    return lhsPriority < rhsPriority;
+                }
+                return lhs < rhs;
+            });
+
     // For every chunk that the hints indicated, check if it is in the cache. If
     // any are not, then wake.
     bool shouldWake = false;
+    int hits = 0;
+    int misses = 0;
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
 
-    for (const auto& hint: hintList) {
+    for (const int hintIndex : std::as_const(m_sortedHintIndices)) {
+        const Hint& hint = hintList[hintIndex];
         SINT hintFrame = hint.frame;
         SINT hintFrameCount = hint.frameCount;
 
@@ -583,6 +761,7 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
             CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
             if (!pChunk) {
                 shouldWake = true;
+                ++misses;
                 pChunk = allocateChunkExpireLRU(chunkIndex);
                 if (!pChunk) {
                     kLogger.warning()
@@ -591,24 +770,9 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
                             << "for read request";
                     continue;
                 }
-                // Do not insert the allocated chunk into the MRU/LRU list,
-                // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request;
-                request.giveToWorker(pChunk);
-                if (kLogger.traceEnabled()) {
-                    kLogger.trace()
-                            << "Requesting read of chunk"
-                            << request.chunk;
-                }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
-                    kLogger.warning()
-                            << "Failed to submit read request for chunk"
-                            << chunkIndex;
-                    // Revoke the chunk from the worker and free it
-                    pChunk->takeFromWorker();
-                    freeChunk(pChunk);
-                }
+                requestChunk(pChunk, Hint::priority(hint.type), nowNanos);
             } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
+                ++hits;
                 // This will cause the chunk to be 'freshened' in the cache. The
                 // chunk will be moved to the end of the LRU list.
                 freshenChunk(pChunk);
@@ -616,6 +780,16 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
         }
     }
 
+    if (hits > 0 || misses > 0) {
+        m_worker.countHints(hits, misses);
+    }
+
+    // Use the remaining capacity of the request FIFO for decoding the
+    // rest of the track in the background, if it fits into the cache.
+    if (preloadChunks()) {
+        shouldWake = true;
+    }
+
     // If there are chunks to be read, wake up.
     if (shouldWake) {
         m_worker.workReady();
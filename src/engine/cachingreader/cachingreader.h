@@ -18,26 +18,47 @@
 // the reader work thread.
 typedef struct Hint {
     enum class Type {
-        SlipPosition,     // prio 1 (so far unused Mixxx 2.3 priority for reference)
+        SlipPosition,     // prio 1
         CurrentPosition,  // prio 1
         LoopStartEnabled, // prio 2
         MainCue,          // prio 10
         HotCue,           // prio 10
         LoopEndEnabled,   // prio 10
         LoopStart,        // prio 10
-        FirstSound,
-        IntroStart,
-        IntroEnd,
-        OutroStart
+        FirstSound,       // prio 20
+        IntroStart,       // prio 20
+        IntroEnd,         // prio 20
+        OutroStart        // prio 20
     };
 
+    static constexpr ReadRequestPriority priority(Type type) {
+        switch (type) {
+        case Type::SlipPosition:
+        case Type::CurrentPosition:
+            return ReadRequestPriority::Playback;
+        case Type::LoopStartEnabled:
+            return ReadRequestPriority::Loop;
+        case Type::MainCue:
+        case Type::HotCue:
+        case Type::LoopEndEnabled:
+        case Type::LoopStart:
+            return ReadRequestPriority::Cue;
+        case Type::FirstSound:
+        case Type::IntroStart:
+        case Type::IntroEnd:
+        case Type::OutroStart:
+            return ReadRequestPriority::Marker;
+        }
+        return ReadRequestPriority::Marker;
+    }
+
     // The frame to ensure is present in memory.
     SINT frame;
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others.
+    // Determines the order in which missing chunks are requested and read,
+    // see priority().
     Type type;
 
     // for the default frame count in forward direction
@@ -109,8 +130,9 @@ class CachingReader : public QObject {
 
     // Issue a list of hints, but check whether any of the hints request a chunk
     // that is not in the cache. If any hints do request a chunk not in cache,
-    // then wake the reader so that it can process them. Must only be called
-    // from the engine callback.
+    // then wake the reader so that it can process them. Hints are processed
+    // in the order of their priority. Must only be called from the engine
+    // callback.
     void hintAndMaybeWake(const HintVector& hintList);
 
     // Request that the CachingReader load a new track. These requests are
@@ -138,6 +160,9 @@ class CachingReader : public QObject {
   private:
     const UserSettingsPointer m_pConfig;
 
+    // The number of chunks in memory, configurable by the user
+    const SINT m_numberOfChunks;
+
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
@@ -168,6 +193,21 @@ class CachingReader : public QObject {
     // Gets a chunk from the free list, frees the LRU CachingReaderChunk if none available.
     CachingReaderChunkForOwner* allocateChunkExpireLRU(SINT chunkIndex);
 
+    // Hands over an allocated chunk to the worker. Frees the chunk and
+    // returns false if the request could not be submitted.
+    bool requestChunk(CachingReaderChunkForOwner* pChunk,
+            ReadRequestPriority priority,
+            qint64 timestampNanos);
+
+    // Enables preloading of the whole track after loading, if all of its
+    // chunks fit into the cache.
+    void startPreload();
+
+    // Requests the next few chunks to be preloaded, if the request FIFO has
+    // enough capacity left for the hints. Returns true if any request has
+    // been submitted.
+    bool preloadChunks();
+
     enum State {
         STATE_IDLE,
         STATE_TRACK_LOADING,
@@ -197,5 +237,16 @@ class CachingReader : public QObject {
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // Indices into the hint list of the current callback, sorted by
+    // priority. Preallocated to avoid memory allocation in the callback.
+    QVarLengthArray<int, 512> m_sortedHintIndices;
+
+    // The range of chunks that still need to be preloaded. Invalid (-1)
+    // if the track does not fit into the cache or preloading has finished.
+    SINT m_nextPreloadChunkIndex;
+    SINT m_lastPreloadChunkIndex;
+
     CachingReaderWorker m_worker;
+
+    friend class CachingReaderTest;
 };
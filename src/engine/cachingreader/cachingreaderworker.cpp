@@ -2,9 +2,11 @@
 
 #include <QAtomicInt>
 #include <QtDebug>
+#include <algorithm>
 
 #include "analyzer/analyzersilence.h"
 #include "moc_cachingreaderworker.cpp"
+#include "sources/audiosourcepredecodeproxy.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
 #include "util/compatibility/qmutex.h"
@@ -12,6 +14,8 @@
 #include "util/fifo.h"
 #include "util/logger.h"
 #include "util/span.h"
+#include "util/stat.h"
+#include "util/time.h"
 
 namespace {
 
@@ -20,17 +24,63 @@ mixxx::Logger kLogger("CachingReaderWorker");
 // we need the last silence frame and the first sound frame
 constexpr SINT kNumSoundFrameToVerify = 2;
 
+// Requests for cues and markers that could not be served within this time
+// are discarded, because the engine hints them again on every callback
+// as long as they are still relevant. This prevents that outdated requests
+// pile up while the worker is busy, e.g. when scratching.
+constexpr qint64 kStalePrefetchRequestAgeNanos = 1000 * 1000 * 1000; // 1 s
+
+constexpr Stat::ComputeFlags kReadLatencyStatFlags = {Stat::COUNT,
+        Stat::AVERAGE,
+        Stat::SAMPLE_VARIANCE,
+        Stat::MIN,
+        Stat::MAX};
+
+constexpr Stat::ComputeFlags kHintStatFlags = {Stat::COUNT,
+        Stat::SUM,
+        Stat::AVERAGE,
+        Stat::MIN,
+        Stat::MAX};
+
+// Comparator for the heap of pending requests, the most urgent request is
+// on top.
+bool isLessUrgent(const CachingReaderChunkReadRequest& lhs,
+        const CachingReaderChunkReadRequest& rhs) {
+    if (lhs.priority != rhs.priority) {
+        return lhs.priority > rhs.priority;
+    }
+    return lhs.timestampNanos > rhs.timestampNanos;
+}
+
+bool isStale(const CachingReaderChunkReadRequest& request, qint64 nowNanos) {
+    if (request.priority < ReadRequestPriority::Cue ||
+            request.priority == ReadRequestPriority::Preload) {
+        // Never discard requests for playback and those of the preloading,
+        // which are not repeated.
+        return false;
+    }
+    return nowNanos - request.timestampNanos > kStalePrefetchRequestAgeNanos;
+}
+
 } // anonymous namespace
 
 CachingReaderWorker::CachingReaderWorker(
         const QString& group,
+        double preDecodeMaxMinutes,
+        bool preDecodeInt16,
         FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
         FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
         mixxx::audio::ChannelCount maxSupportedChannel)
         : m_group(group),
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
+          m_preDecodeMaxMinutes(preDecodeMaxMinutes),
+          m_preDecodeInt16(preDecodeInt16),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_readLatencyStatTag(
+                  QStringLiteral("CachingReader %1 read latency").arg(m_group)),
+          m_hintHitsStatTag(QStringLiteral("CachingReader %1 hint hits").arg(m_group)),
+          m_hintMissesStatTag(QStringLiteral("CachingReader %1 hint misses").arg(m_group)),
           m_maxSupportedChannel(maxSupportedChannel) {
 }
 
@@ -120,6 +170,7 @@ void CachingReaderWorker::run() {
 
     Event::start(m_tag);
     while (!m_stop.loadAcquire()) {
+        reportHintStats();
         // Request is initialized by reading from FIFO
         CachingReaderChunkReadRequest request;
         if (m_newTrackAvailable.loadAcquire()) {
@@ -146,10 +197,17 @@ void CachingReaderWorker::run() {
                 // here, the engine is already stopped
                 unloadTrack();
             }
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        } else if (takeNextReadRequest(&request)) {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update = processReadRequest(request);
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
+            Stat::track(m_readLatencyStatTag,
+                    Stat::DURATION_NANOSEC,
+                    Stat::experimentFlags(kReadLatencyStatFlags),
+                    static_cast<double>(mixxx::Time::elapsed().toIntegerNanos() -
+                            request.timestampNanos));
+        } else if (preDecodeNextFrames()) {
+            // Check for new requests after each block of frames
         } else {
             Event::end(m_tag);
             m_semaRun.acquire();
@@ -158,7 +216,51 @@ void CachingReaderWorker::run() {
     }
 }
 
+void CachingReaderWorker::reportHintStats() {
+    const int hits = m_hintHits.fetchAndStoreRelaxed(0);
+    if (hits > 0) {
+        Stat::track(m_hintHitsStatTag, Stat::COUNTER, kHintStatFlags, hits);
+    }
+    const int misses = m_hintMisses.fetchAndStoreRelaxed(0);
+    if (misses > 0) {
+        Stat::track(m_hintMissesStatTag, Stat::COUNTER, kHintStatFlags, misses);
+    }
+}
+
+bool CachingReaderWorker::takeNextReadRequest(CachingReaderChunkReadRequest* pRequest) {
+    CachingReaderChunkReadRequest request;
+    while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        m_pendingReadRequests.push_back(request);
+        std::push_heap(m_pendingReadRequests.begin(),
+                m_pendingReadRequests.end(),
+                isLessUrgent);
+    }
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    while (!m_pendingReadRequests.empty()) {
+        std::pop_heap(m_pendingReadRequests.begin(),
+                m_pendingReadRequests.end(),
+                isLessUrgent);
+        request = m_pendingReadRequests.back();
+        m_pendingReadRequests.pop_back();
+        if (isStale(request, nowNanos)) {
+            // Return the chunk to the owner, it will be requested
+            // again if still needed.
+            const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
+            m_pReaderStatusFIFO->writeBlocking(&update, 1);
+            continue;
+        }
+        *pRequest = request;
+        return true;
+    }
+    return false;
+}
+
 void CachingReaderWorker::discardAllPendingRequests() {
+    for (const auto& request : std::as_const(m_pendingReadRequests)) {
+        const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
+        m_pReaderStatusFIFO->writeBlocking(&update, 1);
+    }
+    m_pendingReadRequests.clear();
     CachingReaderChunkReadRequest request;
     while (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
         const auto update = ReaderStatusUpdate::readDiscarded(request.chunk);
@@ -169,6 +271,8 @@ void CachingReaderWorker::discardAllPendingRequests() {
 void CachingReaderWorker::closeAudioSource() {
     discardAllPendingRequests();
 
+    m_pPreDecodeProxy.reset();
+
     if (m_pAudioSource) {
         // Closes open file handles of the old track.
         m_pAudioSource->close();
@@ -267,6 +371,8 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
+    maybeStartPreDecoding();
+
     // Adjust the internal buffer
     const SINT tempReadBufferSize =
             m_pAudioSource->getSignalInfo().frames2samples(
@@ -301,6 +407,40 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
             mixxx::audio::FramePos(m_pAudioSource->frameLength()));
 }
 
+void CachingReaderWorker::maybeStartPreDecoding() {
+    DEBUG_ASSERT(m_pAudioSource);
+    DEBUG_ASSERT(!m_pPreDecodeProxy);
+    if (!(m_preDecodeMaxMinutes > 0) ||
+            !m_pAudioSource->hasDuration() ||
+            m_pAudioSource->getDuration() > m_preDecodeMaxMinutes * 60) {
+        return;
+    }
+    const auto sampleFormat = m_preDecodeInt16
+            ? mixxx::AudioSourcePreDecodeProxy::SampleFormat::Int16
+            : mixxx::AudioSourcePreDecodeProxy::SampleFormat::Float32;
+    m_pPreDecodeProxy = mixxx::AudioSourcePreDecodeProxy::create(
+            m_pAudioSource, sampleFormat);
+    m_pAudioSource = m_pPreDecodeProxy;
+    kLogger.debug()
+            << m_group
+            << "Decoding track into"
+            << m_pPreDecodeProxy->sizeInBytes()
+            << "bytes of memory";
+}
+
+bool CachingReaderWorker::preDecodeNextFrames() {
+    if (!m_pPreDecodeProxy) {
+        return false;
+    }
+    if (m_pPreDecodeProxy->decodeNextFrames(CachingReaderChunk::kFrames)) {
+        return true;
+    }
+    // Finished, reads of frames that could not be decoded are still
+    // delegated to the wrapped audio source.
+    m_pPreDecodeProxy.reset();
+    return false;
+}
+
 void CachingReaderWorker::quitWait() {
     m_stop = 1;
     m_semaRun.release();
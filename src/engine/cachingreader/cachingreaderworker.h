@@ -2,6 +2,7 @@
 
 #include <QMutex>
 #include <QString>
+#include <vector>
 
 #include "audio/frame.h"
 #include "audio/types.h"
@@ -13,13 +14,39 @@
 template<class DataType>
 class FIFO;
 
+namespace mixxx {
+class AudioSourcePreDecodeProxy;
+} // namespace mixxx
+
+// Priorities of chunk read requests. Lower values are more urgent. The
+// worker always processes the most urgent pending request first.
+enum class ReadRequestPriority : int {
+    // Chunks around the play and slip position
+    Playback = 1,
+    // Chunks needed for an enabled loop
+    Loop = 2,
+    // Cue and hotcue positions the user is likely to jump to
+    Cue = 10,
+    // Analyzed markers like first sound, intro and outro
+    Marker = 20,
+    // Background decoding of the whole track
+    Preload = 100,
+};
+
 // POD with trivial ctor/dtor/copy for passing through FIFO
 typedef struct CachingReaderChunkReadRequest {
     CachingReaderChunk* chunk;
+    ReadRequestPriority priority;
+    // Time of the request in nanoseconds, see mixxx::Time::elapsed()
+    qint64 timestampNanos;
 
-    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner) {
+    void giveToWorker(CachingReaderChunkForOwner* chunkForOwner,
+            ReadRequestPriority priorityArg,
+            qint64 timestampNanosArg) {
         DEBUG_ASSERT(chunkForOwner);
         chunk = chunkForOwner;
+        priority = priorityArg;
+        timestampNanos = timestampNanosArg;
         chunkForOwner->giveToWorker();
     }
 } CachingReaderChunkReadRequest;
@@ -96,8 +123,12 @@ class CachingReaderWorker : public EngineWorker {
     Q_OBJECT
 
   public:
-    // Construct a CachingReader with the given group.
+    // Construct a CachingReader with the given group. Tracks that are not
+    // longer than preDecodeMaxMinutes are decoded completely into memory,
+    // optionally with 16-bit instead of float samples.
     CachingReaderWorker(const QString& group,
+            double preDecodeMaxMinutes,
+            bool preDecodeInt16,
             FIFO<CachingReaderChunkReadRequest>* pChunkReadRequestFIFO,
             FIFO<ReaderStatusUpdate>* pReaderStatusFIFO,
             mixxx::audio::ChannelCount maxSupportedChannel);
@@ -116,6 +147,14 @@ class CachingReaderWorker : public EngineWorker {
 
     void quitWait();
 
+    // Counts the hits and misses of the read hints. Lock-free and thus
+    // safe to call from the engine callback. The counts are reported to
+    // StatsManager by the worker thread the next time it wakes up.
+    void countHints(int hits, int misses) {
+        m_hintHits.fetchAndAddRelaxed(hits);
+        m_hintMisses.fetchAndAddRelaxed(misses);
+    }
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
@@ -135,6 +174,9 @@ class CachingReaderWorker : public EngineWorker {
     const QString m_group;
     QString m_tag;
 
+    const double m_preDecodeMaxMinutes;
+    const bool m_preDecodeInt16;
+
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest>* m_pChunkReadRequestFIFO;
@@ -152,6 +194,26 @@ class CachingReaderWorker : public EngineWorker {
 
     void discardAllPendingRequests();
 
+    // Moves all requests from the FIFO into m_pendingReadRequests and
+    // takes the most urgent one. Stale prefetch requests are discarded.
+    // Returns false if no request is pending.
+    bool takeNextReadRequest(CachingReaderChunkReadRequest* pRequest);
+
+    // Heap of requests that have been fetched from the FIFO, but not
+    // yet processed. Ordered by priority and time of the request.
+    std::vector<CachingReaderChunkReadRequest> m_pendingReadRequests;
+
+    // Tag for the read latency (from request until the chunk is ready)
+    const QString m_readLatencyStatTag;
+
+    // Tags and pending counts of the per deck hint statistics
+    const QString m_hintHitsStatTag;
+    const QString m_hintMissesStatTag;
+    QAtomicInt m_hintHits;
+    QAtomicInt m_hintMisses;
+
+    void reportHintStats();
+
     /// call to be prepare for new tracks
     /// Make sure engine has been stopped before
     void closeAudioSource();
@@ -173,9 +235,21 @@ class CachingReaderWorker : public EngineWorker {
     void verifyFirstSound(const CachingReaderChunk* pChunk,
             mixxx::audio::ChannelCount channelCount);
 
+    /// Wraps the audio source for decoding the whole track into memory,
+    /// if enabled and the track is not too long.
+    void maybeStartPreDecoding();
+
+    /// Decodes the next frames of the track into memory while there are
+    /// no pending read requests. Returns false if there is nothing to do.
+    bool preDecodeNextFrames();
+
     // The current audio source of the track loaded
     mixxx::AudioSourcePointer m_pAudioSource;
 
+    // The same object as m_pAudioSource while the track is decoded into
+    // memory in the background, otherwise null.
+    std::shared_ptr<mixxx::AudioSourcePreDecodeProxy> m_pPreDecodeProxy;
+
     mixxx::audio::FramePos m_firstSoundFrameToVerify;
 
     // Temporary buffer for reading samples from all channels
@@ -63,6 +63,13 @@ class EngineChannel : public EngineObject {
         m_channelIndex = channelIndex;
     }
 
+    // Only called if the channels are processed in parallel, see
+    // EngineBuffer::setSyncProcessedSeparately().
+    virtual void preProcessSync() {
+    }
+    virtual void postProcessSync() {
+    }
+
     virtual void postProcessLocalBpm() {
     }
 
@@ -280,6 +280,14 @@ void EngineDeck::collectFeatures(GroupFeatureState* pGroupFeatures) const {
     m_pPregain->collectFeatures(pGroupFeatures);
 }
 
+void EngineDeck::preProcessSync() {
+    m_pBuffer->preProcessSync();
+}
+
+void EngineDeck::postProcessSync() {
+    m_pBuffer->postProcessSync();
+}
+
 void EngineDeck::postProcessLocalBpm() {
     m_pBuffer->postProcessLocalBpm();
 }
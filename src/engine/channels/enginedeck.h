@@ -29,6 +29,11 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     void process(CSAMPLE* pOutput, const std::size_t bufferSize) override;
     void collectFeatures(GroupFeatureState* pGroupFeatures) const override;
 
+    // Run the EngineSync steps of process() on the engine thread if the
+    // channels are processed in parallel.
+    void preProcessSync() override;
+    void postProcessSync() override;
+
     // postProcessLocalBpm() is called on all decks to update the localBpm after
     // process() is done. Updated localBpms for all decks are required for the
     // postProcess() step, to avoid issues with the order they are processed.
@@ -98,7 +98,8 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_pCrossfadeBuffer(SampleUtil::alloc(
                   kMaxEngineFrames * mixxx::kMaxEngineChannelInputCount)),
           m_bCrossfadeReady(false),
-          m_lastBufferSize(0)
+          m_lastBufferSize(0),
+          m_bSyncProcessedSeparately(false)
 #ifdef __STEM__
           ,
           m_stemMask()
@@ -904,7 +905,9 @@ void EngineBuffer::processTrackLocked(
     }
 
     // Sync requests can affect rate, so process those first.
-    processSyncRequests();
+    if (!m_bSyncProcessedSeparately) {
+        processSyncRequests();
+    }
 
     // Note: play is also active during cue preview
     bool paused = !m_playButton->toBool();
@@ -1269,12 +1272,30 @@ void EngineBuffer::process(CSAMPLE* pOutput, const std::size_t bufferSize) {
     }
 #endif
 
-    m_pSyncControl->updateAudible();
+    if (!m_bSyncProcessedSeparately) {
+        m_pSyncControl->updateAudible();
+    }
 
     m_lastBufferSize = bufferSize;
     m_bCrossfadeReady = false;
 }
 
+void EngineBuffer::preProcessSync() {
+    DEBUG_ASSERT(m_bSyncProcessedSeparately);
+    // Same conditions as for processing the requests in process(), otherwise
+    // they stay queued for the next callback.
+    bool hasStableTrack = m_pTrackLoaded->toBool() && m_iTrackLoading.loadAcquire() == 0;
+    if (hasStableTrack && m_pause.tryLock()) {
+        processSyncRequests();
+        m_pause.unlock();
+    }
+}
+
+void EngineBuffer::postProcessSync() {
+    DEBUG_ASSERT(m_bSyncProcessedSeparately);
+    m_pSyncControl->updateAudible();
+}
+
 void EngineBuffer::processSlip(std::size_t bufferSize) {
     // Do a single read from m_bSlipEnabled so we don't run in to race conditions.
     bool enabled = m_pSlipButton->toBool();
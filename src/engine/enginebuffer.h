@@ -146,6 +146,16 @@ class EngineBuffer : public EngineObject {
     void postProcessLocalBpm();
     void postProcess(const std::size_t bufferSize);
 
+    /// If enabled, process() skips the steps that modify the EngineSync state
+    /// that is shared by all decks, so that the decks can be processed in
+    /// parallel. The engine thread has to run them with preProcessSync()
+    /// before and postProcessSync() after processing all decks instead.
+    void setSyncProcessedSeparately(bool enabled) {
+        m_bSyncProcessedSeparately = enabled;
+    }
+    void preProcessSync();
+    void postProcessSync();
+
     /// Returns the seek position iff a seek is currently queued but not yet
     /// processed. If no seek was queued, and invalid frame position is returned.
     mixxx::audio::FramePos queuedSeekPosition() const;
@@ -506,6 +516,8 @@ class EngineBuffer : public EngineObject {
     bool m_bCrossfadeReady;
     std::size_t m_lastBufferSize;
 
+    bool m_bSyncProcessedSeparately;
+
     QSharedPointer<VisualPlayPosition> m_visualPlayPos;
 
 #ifdef __STEM__
@@ -0,0 +1,118 @@
+#include "engine/enginechannelworkerpool.h"
+
+#include <QThread>
+
+#include "engine/channels/enginechannel.h"
+#include "engine/effects/groupfeaturestate.h"
+#include "util/assert.h"
+#include "util/denormalsarezero.h"
+#include "util/realtimetrace.h"
+
+namespace {
+
+const ConfigKey kMultiThreadedChannelsCfgKey =
+        ConfigKey(QStringLiteral("[App]"), QStringLiteral("multithreaded_channels"));
+
+// Keep the worker threads alive for the whole session, so no thread is
+// (re-)created from within the audio callback.
+constexpr int kNeverExpire = -1;
+
+// Identifies the worker threads when releasing their trace buffers
+const int kRealtimeTraceOwner = 0;
+
+} // namespace
+
+EngineChannelTask::EngineChannelTask()
+        : QRunnable(),
+          m_completedSema(0),
+          m_pChannel(nullptr),
+          m_pOutput(nullptr),
+          m_bufferSize(0),
+          m_pFeatures(nullptr) {
+    setAutoDelete(false);
+}
+
+void EngineChannelTask::set(EngineChannel* pChannel,
+        CSAMPLE* pOutput,
+        std::size_t bufferSize,
+        GroupFeatureState* pFeatures) {
+    DEBUG_ASSERT(m_completedSema.available() == 0);
+    m_pChannel = pChannel;
+    m_pOutput = pOutput;
+    m_bufferSize = bufferSize;
+    m_pFeatures = pFeatures;
+}
+
+void EngineChannelTask::waitReady() {
+    VERIFY_OR_DEBUG_ASSERT(m_pChannel && m_pOutput) {
+        return;
+    };
+    m_completedSema.acquire();
+}
+
+void EngineChannelTask::run() {
+    VERIFY_OR_DEBUG_ASSERT(m_completedSema.available() == 0 && m_pChannel && m_pOutput) {
+        return;
+    };
+#if defined(__SSE__) && !defined(__EMSCRIPTEN__)
+    // The MXCSR register is per thread, so the worker threads need the same
+    // denormals handling as the engine thread, which is set up by
+    // SoundDevicePortAudio.
+    if (!_MM_GET_DENORMALS_ZERO_MODE()) {
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+    }
+    if (!_MM_GET_FLUSH_ZERO_MODE()) {
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+    }
+#endif
+    if (mixxx::RealtimeTrace::isEnabled()) {
+        mixxx::RealtimeTrace::registerCurrentThread("EngineChannelWorker", &kRealtimeTraceOwner);
+    }
+    mixxx::RealtimeTrace::begin(
+            mixxx::RealtimeTraceEvent::ChannelProcess, m_pChannel->getHandle());
+    m_pChannel->process(m_pOutput, m_bufferSize);
+    if (m_pFeatures) {
+        GroupFeatureState features;
+        m_pChannel->collectFeatures(&features);
+        *m_pFeatures = features;
+    }
+    // The engine thread may reuse the task as soon as it is released
+    mixxx::RealtimeTrace::end(
+            mixxx::RealtimeTraceEvent::ChannelProcess, m_pChannel->getHandle());
+    m_completedSema.release();
+}
+
+// static
+std::unique_ptr<EngineChannelWorkerPool> EngineChannelWorkerPool::create(
+        UserSettingsPointer pConfig) {
+    if (!pConfig || !pConfig->getValue(kMultiThreadedChannelsCfgKey, false)) {
+        return nullptr;
+    }
+    // The engine thread processes the sync leader and always takes care of
+    // one of the remaining channels itself, instead of idling till all
+    // workers are done.
+    const int numWorkers = QThread::idealThreadCount() - 1;
+    if (numWorkers < 1) {
+        qInfo() << "Multithreaded channel processing requested, but only"
+                << QThread::idealThreadCount() << "core available";
+        return nullptr;
+    }
+    qInfo() << "Channels will be processed using" << numWorkers
+            << "additional engine worker threads";
+    return std::unique_ptr<EngineChannelWorkerPool>(
+            new EngineChannelWorkerPool(numWorkers));
+}
+
+EngineChannelWorkerPool::EngineChannelWorkerPool(int numWorkers)
+        : QThreadPool() {
+    setObjectName(QStringLiteral("EngineChannelWorkerPool"));
+    setThreadPriority(QThread::TimeCriticalPriority);
+    setExpiryTimeout(kNeverExpire);
+    setMaxThreadCount(numWorkers);
+}
+
+EngineChannelWorkerPool::~EngineChannelWorkerPool() {
+    // All worker threads have exited when this returns
+    waitForDone();
+    mixxx::RealtimeTrace::releaseThreads(&kRealtimeTraceOwner);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <memory>
+
+#include "preferences/usersettings.h"
+#include "util/types.h"
+
+class EngineChannel;
+struct GroupFeatureState;
+
+/// EngineChannelTask processes a single EngineChannel for one audio callback.
+/// It is owned by EngineMixer (one per channel) and is either run by a thread
+/// of the EngineChannelWorkerPool or inline by the engine thread, if no worker
+/// is available.
+class EngineChannelTask : public QRunnable {
+  public:
+    EngineChannelTask();
+
+    /// @brief Prepare the task for the current callback
+    /// @param pChannel the channel to process. Must remain valid till
+    /// waitReady() has returned
+    /// @param pOutput the channel buffer
+    /// @param bufferSize the sample count
+    /// @param pFeatures if not null, the features of the channel are collected
+    /// into it after processing
+    void set(EngineChannel* pChannel,
+            CSAMPLE* pOutput,
+            std::size_t bufferSize,
+            GroupFeatureState* pFeatures);
+
+    /// Wait for the current task to complete.
+    void waitReady();
+
+    void run() override;
+
+  private:
+    // Whether or not the scheduled job has completed
+    QSemaphore m_completedSema;
+
+    EngineChannel* m_pChannel;
+    CSAMPLE* m_pOutput;
+    std::size_t m_bufferSize;
+    GroupFeatureState* m_pFeatures;
+};
+
+/// EngineChannelWorkerPool allows the engine thread to process independent
+/// channels in parallel. This is opt-in with [App],multithreaded_channels
+/// because channels are not fully independent: followers read the sync state
+/// of the leader, so the sync leader must always be processed by the engine
+/// thread before the other channels are dispatched. Everything that changes
+/// the EngineSync state, like sync mode requests, is run by the engine thread
+/// before the fork or after the join.
+class EngineChannelWorkerPool : public QThreadPool {
+  public:
+    /// Returns nullptr if multithreaded channel processing is disabled or not
+    /// possible on this machine.
+    static std::unique_ptr<EngineChannelWorkerPool> create(UserSettingsPointer pConfig);
+
+    ~EngineChannelWorkerPool() override;
+
+  private:
+    explicit EngineChannelWorkerPool(int numWorkers);
+};
@@ -25,6 +25,7 @@
 #include "preferences/usersettings.h"
 #include "util/defs.h"
 #include "util/parented_ptr.h"
+#include "util/realtimetrace.h"
 #include "util/sample.h"
 #include "util/samplebuffer.h"
 
@@ -61,6 +62,7 @@ EngineMixer::EngineMixer(UserSettingsPointer pConfig,
           m_talkoverHeadphones(kMaxEngineSamples),
           m_sidechainMix(kMaxEngineSamples),
           m_pWorkerScheduler(make_parented<EngineWorkerScheduler>(this)),
+          m_pChannelWorkerPool(EngineChannelWorkerPool::create(pConfig)),
           m_pEngineSync(std::make_unique<EngineSync>(pConfig)),
           m_pMainGain(std::make_unique<ControlAudioTaperPot>(
                   ConfigKey(group, "gain"), -14, 14, 0.5)),
@@ -231,6 +233,8 @@ std::span<const CSAMPLE> EngineMixer::getSidechainBuffer() const {
 }
 
 void EngineMixer::processChannels(std::size_t bufferSize) {
+    mixxx::ScopedRealtimeTrace trace(mixxx::RealtimeTraceEvent::ProcessChannels);
+
     // Update internal sync lock rate.
     m_pEngineSync->onCallbackStart(m_sampleRate, bufferSize);
 
@@ -241,7 +245,14 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
     m_activeTalkoverChannels.clear();
     m_activeChannels.clear();
 
-    // ScopedTimer timer(QStringLiteral("EngineMixer::processChannels"));
+    if (m_pChannelWorkerPool) {
+        // Sync requests may change the leader, so they are processed before
+        // it is looked up, like in the first step of processing the leader.
+        for (const auto& pChannelInfo : std::as_const(m_channels)) {
+            pChannelInfo->m_pChannel->preProcessSync();
+        }
+    }
+
     EngineChannel* pLeaderChannel = m_pEngineSync->getLeaderChannel();
     // Reserve the first place for the main channel which
     // should be processed first
@@ -319,17 +330,23 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
     }
 
     // Now that the list is built and ordered, do the processing.
-    for (int i = activeChannelsStartIndex; i < m_activeChannels.size(); ++i) {
-        ChannelInfo* pChannelInfo = m_activeChannels[i];
-        auto& pChannel = pChannelInfo->m_pChannel;
-        DEBUG_ASSERT(pChannelInfo->m_pBuffer.size() >= static_cast<SINT>(bufferSize));
-        pChannel->process(pChannelInfo->m_pBuffer.data(), bufferSize);
-
-        // Collect metadata for effects
-        if (m_pEngineEffectsManager) {
-            GroupFeatureState features;
-            pChannel->collectFeatures(&features);
-            pChannelInfo->m_features = features;
+    if (m_pChannelWorkerPool) {
+        int startIndex = activeChannelsStartIndex;
+        if (startIndex == 0) {
+            // The followers depend on the state of the sync leader, so it
+            // needs to be completed before the others are dispatched.
+            processChannel(m_activeChannels[0], bufferSize);
+            startIndex = 1;
+        }
+        processChannelsParallel(startIndex, bufferSize);
+        std::for_each(m_activeChannels.cbegin() + activeChannelsStartIndex,
+                m_activeChannels.cend(),
+                [](const auto& pChannelInfo) {
+                    pChannelInfo->m_pChannel->postProcessSync();
+                });
+    } else {
+        for (int i = activeChannelsStartIndex; i < m_activeChannels.size(); ++i) {
+            processChannel(m_activeChannels[i], bufferSize);
         }
     }
     // Do internal sync lock post-processing before the other
@@ -358,6 +375,51 @@ void EngineMixer::processChannels(std::size_t bufferSize) {
             });
 }
 
+void EngineMixer::processChannel(ChannelInfo* pChannelInfo, std::size_t bufferSize) {
+    auto& pChannel = pChannelInfo->m_pChannel;
+    mixxx::ScopedRealtimeTrace trace(
+            mixxx::RealtimeTraceEvent::ChannelProcess, pChannel->getHandle());
+    DEBUG_ASSERT(pChannelInfo->m_pBuffer.size() >= static_cast<SINT>(bufferSize));
+    pChannel->process(pChannelInfo->m_pBuffer.data(), bufferSize);
+
+    // Collect metadata for effects
+    if (m_pEngineEffectsManager) {
+        GroupFeatureState features;
+        pChannel->collectFeatures(&features);
+        pChannelInfo->m_features = features;
+    }
+}
+
+void EngineMixer::processChannelsParallel(int startIndex, std::size_t bufferSize) {
+    const int lastIndex = m_activeChannels.size() - 1;
+    for (int i = startIndex; i <= lastIndex; ++i) {
+        ChannelInfo* pChannelInfo = m_activeChannels[i];
+        EngineChannelTask* pTask = pChannelInfo->m_pTask.get();
+        VERIFY_OR_DEBUG_ASSERT(pTask) {
+            processChannel(pChannelInfo, bufferSize);
+            continue;
+        }
+        DEBUG_ASSERT(pChannelInfo->m_pBuffer.size() >= static_cast<SINT>(bufferSize));
+        pTask->set(pChannelInfo->m_pChannel.get(),
+                pChannelInfo->m_pBuffer.data(),
+                bufferSize,
+                m_pEngineEffectsManager ? &pChannelInfo->m_features : nullptr);
+        // The engine thread takes the last channel itself instead of idling
+        // and also any channel for which no worker slot is available.
+        if (i == lastIndex || !m_pChannelWorkerPool->tryStart(pTask)) {
+            pTask->run();
+        }
+    }
+    // We always perform a wait, even for tasks that were run in the engine
+    // thread, so the semaphore is reset
+    for (int i = startIndex; i <= lastIndex; ++i) {
+        EngineChannelTask* pTask = m_activeChannels[i]->m_pTask.get();
+        if (pTask) {
+            pTask->waitReady();
+        }
+    }
+}
+
 void EngineMixer::process(const std::size_t bufferSize) {
     DEBUG_ASSERT(bufferSize <= static_cast<int>(kMaxEngineSamples));
 
@@ -366,7 +428,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
         QThread::currentThread()->setObjectName("Engine");
         haveSetName = true;
     }
-    // Trace t("EngineMixer::process");
+    mixxx::ScopedRealtimeTrace trace(mixxx::RealtimeTraceEvent::EngineProcess);
 
     bool mainEnabled = m_pMainEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
@@ -400,6 +462,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
     m_headphoneGain.setGain(pflMixGainInHeadphones);
 
     if (headphoneEnabled) {
+        mixxx::ScopedRealtimeTrace headphoneTrace(mixxx::RealtimeTraceEvent::HeadphoneMix);
         // Process effects and mix PFL channels together for the headphones.
         // Effects will be reprocessed post-fader for the crossfader buses
         // and main mix, so the channel input buffers cannot be modified here.
@@ -437,6 +500,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
 
     // Mix all the talkover enabled channels together.
     // Effects processing is done in place to avoid unnecessary buffer copying.
+    mixxx::RealtimeTrace::begin(mixxx::RealtimeTraceEvent::TalkoverMix);
     ChannelMixer::applyEffectsInPlaceAndMixChannels(
             m_talkoverGain,
             m_activeTalkoverChannels,
@@ -461,6 +525,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
                 CSAMPLE_GAIN_ONE,
                 CSAMPLE_GAIN_ONE);
     }
+    mixxx::RealtimeTrace::end(mixxx::RealtimeTraceEvent::TalkoverMix);
 
     switch (m_pTalkoverDucking->getMode()) {
     case EngineTalkoverDucking::OFF:
@@ -491,6 +556,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
     // channel volume faders and crossfader.
     m_mainGain.setGains(crossfaderLeftGain, 1.0f, crossfaderRightGain);
 
+    mixxx::RealtimeTrace::begin(mixxx::RealtimeTraceEvent::BusMix);
     for (int o = EngineChannel::LEFT; o <= EngineChannel::RIGHT; o++) {
         ChannelMixer::applyEffectsInPlaceAndMixChannels(m_mainGain,
                 m_activeBusChannels[o],
@@ -502,9 +568,11 @@ void EngineMixer::process(const std::size_t bufferSize) {
                 m_sampleRate,
                 m_pEngineEffectsManager);
     }
+    mixxx::RealtimeTrace::end(mixxx::RealtimeTraceEvent::BusMix);
 
     // Process crossfader orientation bus channel effects
     if (m_pEngineEffectsManager) {
+        mixxx::ScopedRealtimeTrace busEffectsTrace(mixxx::RealtimeTraceEvent::BusEffects);
         m_pEngineEffectsManager->processPostFaderInPlace(
                 m_busCrossfaderLeftHandle.handle(),
                 m_mainHandle.handle(),
@@ -726,12 +794,14 @@ void EngineMixer::process(const std::size_t bufferSize) {
         // EngineSideChain::receiveBuffer has copied the input buffer to m_pSidechainMix
         // via before (called by SoundManager::pushInputBuffers())
         if (m_pEngineSideChain) {
+            mixxx::ScopedRealtimeTrace sidechainTrace(mixxx::RealtimeTraceEvent::Sidechain);
             m_pEngineSideChain->writeSamples(m_sidechainMix.data(), iFrames);
         }
 
         // Process effects that apply to main hardware output only but not
         // record/broadcast signal
         if (m_pEngineEffectsManager) {
+            mixxx::ScopedRealtimeTrace mainEffectsTrace(mixxx::RealtimeTraceEvent::MainEffects);
             GroupFeatureState mainFeatures;
             mainFeatures.gain = m_pMainGain->get();
             m_pEngineEffectsManager->processPostFaderInPlace(
@@ -767,6 +837,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
         // Update VU meter (it does not return anything). Needs to be here so that
         // main balance and talkover is reflected in the VU meter.
         if (m_pVumeter != nullptr) {
+            mixxx::ScopedRealtimeTrace vuMeterTrace(mixxx::RealtimeTraceEvent::VuMeters);
             m_pVumeter->process(m_main.data(), bufferSize);
         }
     }
@@ -795,6 +866,7 @@ void EngineMixer::process(const std::size_t bufferSize) {
 void EngineMixer::applyMainEffects(std::size_t bufferSize) {
     // Apply main effects
     if (m_pEngineEffectsManager) {
+        mixxx::ScopedRealtimeTrace trace(mixxx::RealtimeTraceEvent::MainEffects);
         GroupFeatureState mainFeatures;
         mainFeatures.gain = m_pMainGain->get();
         m_pEngineEffectsManager->processPostFaderInPlace(m_mainHandle.handle(),
@@ -860,6 +932,9 @@ void EngineMixer::addChannel(std::unique_ptr<EngineChannel> pChannel) {
     pChannelInfo->m_pMuteControl->setButtonMode(mixxx::control::ButtonMode::PowerWindow);
     pChannelInfo->m_pBuffer = mixxx::SampleBuffer(kMaxEngineSamples);
     pChannelInfo->m_pBuffer.clear();
+    if (m_pChannelWorkerPool) {
+        pChannelInfo->m_pTask = std::make_unique<EngineChannelTask>();
+    }
     EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
     m_channels.append(std::move(pChannelInfo));
     constexpr GainCache gainCacheDefault = {0, false};
@@ -879,6 +954,8 @@ void EngineMixer::addChannel(std::unique_ptr<EngineChannel> pChannel) {
 
     if (pBuffer != nullptr) {
         pBuffer->bindWorkers(m_pWorkerScheduler);
+        // The worker threads must not touch the shared EngineSync state
+        pBuffer->setSyncProcessedSeparately(m_pChannelWorkerPool != nullptr);
     }
 }
 
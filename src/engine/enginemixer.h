@@ -12,6 +12,7 @@
 #include "engine/channelhandle.h"
 #include "engine/channels/enginechannel.h"
 #include "engine/effects/groupfeaturestate.h"
+#include "engine/enginechannelworkerpool.h"
 #include "engine/engineobject.h"
 #include "preferences/usersettings.h"
 #include "recording/recordingmanager.h"
@@ -124,6 +125,8 @@ class EngineMixer : public QObject, public AudioSource {
         std::unique_ptr<ControlObject> m_pVolumeControl{nullptr};
         std::unique_ptr<ControlPushButton> m_pMuteControl{nullptr};
         GroupFeatureState m_features{};
+        // Only allocated if multithreaded channel processing is enabled
+        std::unique_ptr<EngineChannelTask> m_pTask{nullptr};
         int m_index;
     };
 
@@ -259,6 +262,14 @@ class EngineMixer : public QObject, public AudioSource {
     // m_activeTalkoverChannels with each channel that is active for the
     // respective output.
     void processChannels(std::size_t bufferSize);
+    // Processes a single channel and collects its features for effects.
+    void processChannel(ChannelInfo* pChannelInfo, std::size_t bufferSize);
+    // Processes m_activeChannels from startIndex on using the
+    // m_pChannelWorkerPool. The engine thread processes the last channel and
+    // any channel for which no worker is available. Returns when all channels
+    // are processed. The steps that modify the EngineSync state are not run by
+    // the channels but by the caller, see EngineChannel::preProcessSync().
+    void processChannelsParallel(int startIndex, std::size_t bufferSize);
 
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
     void applyMainEffects(std::size_t bufferSize);
@@ -296,6 +307,8 @@ class EngineMixer : public QObject, public AudioSource {
     mixxx::SampleBuffer m_sidechainMix;
 
     parented_ptr<EngineWorkerScheduler> m_pWorkerScheduler;
+    // nullptr unless multithreaded channel processing is enabled
+    std::unique_ptr<EngineChannelWorkerPool> m_pChannelWorkerPool;
     std::unique_ptr<EngineSync> m_pEngineSync;
 
     std::unique_ptr<ControlObject> m_pMainGain;
@@ -10,6 +10,16 @@
 #include "engine/engineobject.h"
 #include "util/sample.h"
 
+#if defined(__SSE2__) && !defined(__EMSCRIPTEN__)
+#include <emmintrin.h>
+#define MIXXX_IIR_SSE2
+#define MIXXX_IIR_SIMD
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MIXXX_IIR_NEON
+#define MIXXX_IIR_SIMD
+#endif
+
 // set to 1 to print some analysis data using qDebug()
 // It prints the resulting delay after 50 % of impulse have passed
 // and the gain and phase shift at some sample frequencies
@@ -27,6 +37,113 @@ enum IIRPass {
 };
 
 
+/// The samples of both channels of a stereo signal. If available, the
+/// filters process them in parallel lanes of a single SIMD register
+/// (two doubles with SSE2 or AArch64 NEON) and store the state of both
+/// channels interleaved. Compilers don't vectorize the separate
+/// processing of both channels on their own.
+class IIRStereoSample {
+  public:
+    IIRStereoSample() = default;
+#if defined(MIXXX_IIR_SSE2)
+    IIRStereoSample(double left, double right)
+            : m_reg(_mm_set_pd(right, left)) {
+    }
+
+    double left() const {
+        return _mm_cvtsd_f64(m_reg);
+    }
+    double right() const {
+        return _mm_cvtsd_f64(_mm_unpackhi_pd(m_reg, m_reg));
+    }
+
+    friend IIRStereoSample operator+(IIRStereoSample lhs, IIRStereoSample rhs) {
+        return IIRStereoSample(_mm_add_pd(lhs.m_reg, rhs.m_reg));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample lhs, IIRStereoSample rhs) {
+        return IIRStereoSample(_mm_sub_pd(lhs.m_reg, rhs.m_reg));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample val) {
+        // Flip the sign bit like the scalar negation
+        return IIRStereoSample(_mm_xor_pd(val.m_reg, _mm_set1_pd(-0.0)));
+    }
+    friend IIRStereoSample operator*(IIRStereoSample lhs, double rhs) {
+        return IIRStereoSample(_mm_mul_pd(lhs.m_reg, _mm_set1_pd(rhs)));
+    }
+
+  private:
+    explicit IIRStereoSample(__m128d reg)
+            : m_reg(reg) {
+    }
+
+    __m128d m_reg;
+#elif defined(MIXXX_IIR_NEON)
+    IIRStereoSample(double left, double right)
+            : m_reg(vcombine_f64(vdup_n_f64(left), vdup_n_f64(right))) {
+    }
+
+    double left() const {
+        return vgetq_lane_f64(m_reg, 0);
+    }
+    double right() const {
+        return vgetq_lane_f64(m_reg, 1);
+    }
+
+    friend IIRStereoSample operator+(IIRStereoSample lhs, IIRStereoSample rhs) {
+        return IIRStereoSample(vaddq_f64(lhs.m_reg, rhs.m_reg));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample lhs, IIRStereoSample rhs) {
+        return IIRStereoSample(vsubq_f64(lhs.m_reg, rhs.m_reg));
+    }
+    friend IIRStereoSample operator-(IIRStereoSample val) {
+        return IIRStereoSample(vnegq_f64(val.m_reg));
+    }
+    friend IIRStereoSample operator*(IIRStereoSample lhs, double rhs) {
+        return IIRStereoSample(vmulq_n_f64(lhs.m_reg, rhs));
+    }
+
+  private:
+    explicit IIRStereoSample(float64x2_t reg)
+            : m_reg(reg) {
+    }
+
+    float64x2_t m_reg;
+#else
+    // Without SIMD registers for doubles both channels are processed
+    // separately
+    IIRStereoSample(double left, double right)
+            : m_left(left),
+              m_right(right) {
+    }
+
+    double left() const {
+        return m_left;
+    }
+    double right() const {
+        return m_right;
+    }
+
+  private:
+    double m_left;
+    double m_right;
+#endif
+
+#if defined(MIXXX_IIR_SIMD)
+  public:
+    friend IIRStereoSample operator*(double lhs, IIRStereoSample rhs) {
+        return rhs * lhs;
+    }
+    friend IIRStereoSample& operator+=(IIRStereoSample& lhs, IIRStereoSample rhs) {
+        lhs = lhs + rhs;
+        return lhs;
+    }
+    friend IIRStereoSample& operator-=(IIRStereoSample& lhs, IIRStereoSample rhs) {
+        lhs = lhs - rhs;
+        return lhs;
+    }
+#endif
+};
+
 class EngineFilterIIRBase : public EngineObjectConstIn {
   public:
     virtual void assumeSettled() = 0;
@@ -85,11 +202,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 
     void initBuffers() {
         // Copy the current buffers into the old buffers
-        memcpy(m_oldBuf1, m_buf1, sizeof(m_buf1));
-        memcpy(m_oldBuf2, m_buf2, sizeof(m_buf2));
+        m_oldBuf = m_buf;
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        m_buf = State{};
         m_doRamping = true;
     }
 
@@ -239,8 +354,10 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     virtual void process(const CSAMPLE* pIn, CSAMPLE* pOutput, const std::size_t bufferSize) {
         if (!m_doRamping) {
             for (std::size_t i = 0; i < bufferSize; i += 2) {
-                pOutput[i] = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                pOutput[i + 1] = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
+                const IIRStereoSample out = processFrame(
+                        m_coef, &m_buf, IIRStereoSample(pIn[i], pIn[i + 1]));
+                pOutput[i] = static_cast<CSAMPLE>(out.left());
+                pOutput[i + 1] = static_cast<CSAMPLE>(out.right());
             }
         } else {
             double cross_mix = 0.0;
@@ -257,12 +374,14 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                 // of the new filter but it turns out that this produces
                 // a gain drop due to the filter delay which is more
                 // conspicuous than the settling noise.
+                const IIRStereoSample in(pIn[i], pIn[i + 1]);
                 double old1;
                 double old2;
                 if (!m_doStart) {
                     // Process old filter, but only if we do not do a fresh start
-                    old1 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf1, pIn[i]));
-                    old2 = static_cast<CSAMPLE>(processSample(m_oldCoef, m_oldBuf2, pIn[i + 1]));
+                    const IIRStereoSample old = processFrame(m_oldCoef, &m_oldBuf, in);
+                    old1 = static_cast<CSAMPLE>(old.left());
+                    old2 = static_cast<CSAMPLE>(old.right());
                 } else {
                     if (m_startFromDry) {
                         old1 = pIn[i];
@@ -272,8 +391,9 @@ class EngineFilterIIR : public EngineFilterIIRBase {
                         old2 = 0;
                     }
                 }
-                double new1 = static_cast<CSAMPLE>(processSample(m_coef, m_buf1, pIn[i]));
-                double new2 = static_cast<CSAMPLE>(processSample(m_coef, m_buf2, pIn[i + 1]));
+                const IIRStereoSample out = processFrame(m_coef, &m_buf, in);
+                double new1 = static_cast<CSAMPLE>(out.left());
+                double new2 = static_cast<CSAMPLE>(out.right());
 
                 if (i < bufferSize / 2) {
                     pOutput[i] = static_cast<CSAMPLE>(old1);
@@ -291,11 +411,34 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     }
 
   protected:
-    inline double processSample(double* coef, double* buf, double val);
+    /// Processes a single sample of one channel (double) or of
+    /// both channels in parallel (IIRStereoSample).
+    template<typename S>
+    inline S processSample(const double* coef, S* buf, S val);
+
+    struct State {
+#if defined(MIXXX_IIR_SIMD)
+        // Interleaved state of both channels
+        IIRStereoSample buf[SIZE];
+#else
+        double left[SIZE];
+        double right[SIZE];
+#endif
+    };
+
+    inline IIRStereoSample processFrame(
+            const double* coef, State* pState, IIRStereoSample val) {
+#if defined(MIXXX_IIR_SIMD)
+        return processSample(coef, pState->buf, val);
+#else
+        return IIRStereoSample(
+                processSample(coef, pState->left, val.left()),
+                processSample(coef, pState->right, val.right()));
+#endif
+    }
     inline void pauseFilterInner() {
         // Set the current buffers to 0
-        memset(m_buf1, 0, sizeof(m_buf1));
-        memset(m_buf2, 0, sizeof(m_buf2));
+        m_buf = State{};
         m_doRamping = true;
         m_doStart = true;
     }
@@ -304,15 +447,10 @@ class EngineFilterIIR : public EngineFilterIIRBase {
     // Old coefficients needed for ramping
     double m_oldCoef[SIZE + 1];
 
-    // Channel 1 state
-    double m_buf1[SIZE];
-    // Old channel 1 buffer needed for ramping
-    double m_oldBuf1[SIZE];
-
-    // Channel 2 state
-    double m_buf2[SIZE];
-    // Old channel 2 buffer needed for ramping
-    double m_oldBuf2[SIZE];
+    // State of both channels
+    State m_buf;
+    // Old state needed for ramping
+    State m_oldBuf;
 
     // Flag set to true if ramping needs to be done
     bool m_doRamping;
@@ -323,10 +461,11 @@ class EngineFilterIIR : public EngineFilterIIRBase {
 };
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<2, IIR_LP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -337,10 +476,11 @@ inline double EngineFilterIIR<2, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<2, IIR_BP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = -tmp;
@@ -351,10 +491,11 @@ inline double EngineFilterIIR<2, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<2, IIR_HP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -365,10 +506,11 @@ inline double EngineFilterIIR<2, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<4, IIR_LP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -384,10 +526,11 @@ inline double EngineFilterIIR<4, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<8, IIR_BP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -414,10 +557,11 @@ inline double EngineFilterIIR<8, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<4, IIR_HP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     iir= val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -433,10 +577,11 @@ inline double EngineFilterIIR<4, IIR_HP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<8, IIR_LP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -463,10 +608,11 @@ inline double EngineFilterIIR<8, IIR_LP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
-                                                         double* buf,
-                                                         double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<16, IIR_BP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     buf[7] = buf[8]; buf[8] = buf[9]; buf[9] = buf[10]; buf[10] = buf[11];
@@ -515,10 +661,11 @@ inline double EngineFilterIIR<16, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<8, IIR_HP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
     buf[3] = buf[4]; buf[4] = buf[5]; buf[5] = buf[6]; buf[6] = buf[7];
     iir = val * coef[0];
@@ -546,10 +693,11 @@ inline double EngineFilterIIR<8, IIR_HP>::processSample(double* coef,
 
 // IIR_LP and IIR_HP use the same processSample routine
 template<>
-inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<5, IIR_BP>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0]; buf[0] = buf[1];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = coef[2] * tmp;
@@ -560,10 +708,11 @@ inline double EngineFilterIIR<5, IIR_BP>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<4, IIR_LPMO>::processSample(const double* coef,
+        S* buf,
+        S val) {
+   S tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= tmp;
@@ -586,10 +735,11 @@ inline double EngineFilterIIR<4, IIR_LPMO>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-   double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<4, IIR_HPMO>::processSample(const double* coef,
+        S* buf,
+        S val) {
+   S tmp, fir, iir;
    tmp= buf[0]; buf[0] = buf[1]; buf[1] = buf[2]; buf[2] = buf[3];
    iir= val * coef[0];
    iir -= coef[1]*tmp; fir= -tmp;
@@ -611,10 +761,11 @@ inline double EngineFilterIIR<4, IIR_HPMO>::processSample(double* coef,
 }
 
 template<>
-inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<2, IIR_LP2>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0];
     iir = val * coef[0];
     iir -= coef[1] * tmp; fir = tmp;
@@ -632,10 +783,11 @@ inline double EngineFilterIIR<2, IIR_LP2>::processSample(double* coef,
 
 
 template<>
-inline double EngineFilterIIR<2, IIR_HP2>::processSample(double* coef,
-                                                        double* buf,
-                                                        double val) {
-    double tmp, fir, iir;
+template<typename S>
+inline S EngineFilterIIR<2, IIR_HP2>::processSample(const double* coef,
+        S* buf,
+        S val) {
+    S tmp, fir, iir;
     tmp = buf[0];
     iir = val * -coef[0]; // swap gain to be in phase with LP2
     iir -= coef[1] * tmp; fir = -tmp;
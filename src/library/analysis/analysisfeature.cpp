@@ -205,7 +205,9 @@ void AnalysisFeature::stopAnalysis() {
 void AnalysisFeature::onTrackAnalysisSchedulerProgress(
         AnalyzerProgress /*currentTrackProgress*/,
         int currentTrackNumber,
-        int totalTracksCount) {
+        int totalTracksCount,
+        double /*tracksPerMinute*/,
+        double /*workerBusyRatio*/) {
     // Ignore any delayed progress updates after the analysis
     // has already been stopped.
     if (!m_pTrackAnalysisScheduler) {
@@ -222,6 +224,7 @@ void AnalysisFeature::onTrackAnalysisSchedulerFinished() {
     if (!m_pTrackAnalysisScheduler) {
         return; // already inactive
     }
+    // The throughput has already been logged by the scheduler
     kLogger.info() << "Finishing analysis";
     if (m_pTrackAnalysisScheduler) {
         // Free resources by abandoning the queue after the batch analysis
@@ -45,7 +45,11 @@ class AnalysisFeature : public LibraryFeature {
     void stopAnalysis();
 
   private slots:
-    void onTrackAnalysisSchedulerProgress(AnalyzerProgress currentTrackProgress, int currentTrackNumber, int totalTracksCount);
+    void onTrackAnalysisSchedulerProgress(AnalyzerProgress currentTrackProgress,
+            int currentTrackNumber,
+            int totalTracksCount,
+            double tracksPerMinute,
+            double workerBusyRatio);
     void onTrackAnalysisSchedulerFinished();
 
   private:
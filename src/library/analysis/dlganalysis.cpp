@@ -188,12 +188,17 @@ void DlgAnalysis::slotAnalysisActive(bool bActive) {
         pushButtonAnalyze->setChecked(false);
         pushButtonAnalyze->setText(tr("Analyze"));
         labelProgress->setText("");
+        labelProgress->setToolTip(QString());
         labelProgress->setEnabled(false);
     }
 }
 
 void DlgAnalysis::onTrackAnalysisSchedulerProgress(
-        AnalyzerProgress, int finishedCount, int totalCount) {
+        AnalyzerProgress,
+        int finishedCount,
+        int totalCount,
+        double tracksPerMinute,
+        double workerBusyRatio) {
     // qDebug() << this << "onTrackAnalysisSchedulerProgress" <<
     // analyzerProgress << finishedCount << totalCount;
     if (labelProgress->isEnabled()) {
@@ -205,11 +210,20 @@ void DlgAnalysis::onTrackAnalysisSchedulerProgress(
             }
         }
 
-        labelProgress->setText(tr("Analyzing %1/%2")
-                                       .arg(QString::number(finishedCount),
-                                               QString::number(totalCount)) +
+        QString text = tr("Analyzing %1/%2")
+                               .arg(QString::number(finishedCount),
+                                       QString::number(totalCount)) +
                 QStringLiteral(" (%3%)").arg(
-                        QString::number(totalProgressPercent)));
+                        QString::number(totalProgressPercent));
+        // The throughput is unknown until the first track has been finished
+        if (tracksPerMinute > 0) {
+            text += QStringLiteral(" - ") +
+                    tr("%1 tracks/min").arg(QString::number(tracksPerMinute, 'f', 1));
+        }
+        labelProgress->setText(text);
+        labelProgress->setToolTip(tr("Worker busy: %1%")
+                                          .arg(QString::number(
+                                                  qRound(workerBusyRatio * 100))));
     }
 }
 
@@ -38,7 +38,11 @@ class DlgAnalysis : public QWidget, public Ui::DlgAnalysis, public virtual Libra
     void selectAll();
     void analyze();
     void slotAnalysisActive(bool bActive);
-    void onTrackAnalysisSchedulerProgress(AnalyzerProgress analyzerProgress, int finishedCount, int totalCount);
+    void onTrackAnalysisSchedulerProgress(AnalyzerProgress analyzerProgress,
+            int finishedCount,
+            int totalCount,
+            double tracksPerMinute,
+            double workerBusyRatio);
     void onTrackAnalysisSchedulerFinished();
     void slotShowRecentSongs();
     void slotRecentDaysChanged(int days);
@@ -1,5 +1,6 @@
 #include "library/basetrackcache.h"
 
+#include "library/columnartrackindex.h"
 #include "library/queryutil.h"
 #include "library/searchquery.h"
 #include "library/searchqueryparser.h"
@@ -14,6 +15,50 @@ namespace {
 
 constexpr bool sDebug = false;
 
+/// The column types are chosen to sort like the ORDER BY clauses
+/// of ColumnCache::columnSortForFieldIndex()
+QVector<ColumnarTrackIndex::ColumnType> columnarIndexColumnTypes(
+        const ColumnCache& columnCache, int columnCount) {
+    QVector<ColumnarTrackIndex::ColumnType> columnTypes(
+            columnCount, ColumnarTrackIndex::ColumnType::Text);
+    const auto setColumnType = [&](ColumnCache::Column column,
+                                       ColumnarTrackIndex::ColumnType columnType) {
+        const int index = columnCache.fieldIndex(column);
+        if (index >= 0 && index < columnCount) {
+            columnTypes[index] = columnType;
+        }
+    };
+    for (const auto column : {
+                 ColumnCache::COLUMN_LIBRARYTABLE_ID,
+                 ColumnCache::COLUMN_LIBRARYTABLE_DURATION,
+                 ColumnCache::COLUMN_LIBRARYTABLE_BITRATE,
+                 ColumnCache::COLUMN_LIBRARYTABLE_BPM,
+                 ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN,
+                 ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE,
+                 ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS,
+                 ColumnCache::COLUMN_LIBRARYTABLE_MIXXXDELETED,
+                 ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED,
+                 ColumnCache::COLUMN_LIBRARYTABLE_PLAYED,
+                 ColumnCache::COLUMN_LIBRARYTABLE_RATING,
+                 ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID,
+                 ColumnCache::COLUMN_LIBRARYTABLE_TUNING_FREQUENCY,
+                 ColumnCache::COLUMN_LIBRARYTABLE_BPM_LOCK,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COLOR,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COVERART_SOURCE,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COVERART_TYPE,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COVERART_COLOR,
+                 ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH,
+                 ColumnCache::COLUMN_TRACKLOCATIONSTABLE_FSDELETED,
+         }) {
+        setColumnType(column, ColumnarTrackIndex::ColumnType::Number);
+    }
+    setColumnType(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER,
+            ColumnarTrackIndex::ColumnType::IntegerText);
+    setColumnType(ColumnCache::COLUMN_LIBRARYTABLE_KEY,
+            ColumnarTrackIndex::ColumnType::Key);
+    return columnTypes;
+}
+
 }  // namespace
 
 BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
@@ -84,6 +129,9 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
     for (const auto& trackId : std::as_const(trackIds)) {
         m_trackInfo.remove(trackId);
         m_dirtyTracks.remove(trackId);
+        if (m_pColumnarIndex) {
+            m_pColumnarIndex->remove(trackId);
+        }
     }
 }
 
@@ -111,6 +159,30 @@ void BaseTrackCache::ensureCached(TrackId trackId) {
     updateTrackInIndex(trackId);
 }
 
+void BaseTrackCache::setColumnarIndexEnabled(bool enabled) {
+    if (enabled == static_cast<bool>(m_pColumnarIndex)) {
+        return;
+    }
+    if (!enabled) {
+        m_pColumnarIndex.reset();
+        return;
+    }
+
+    PerformanceTimer timer;
+    timer.start();
+    m_pColumnarIndex = std::make_unique<ColumnarTrackIndex>(m_columnCache,
+            columnarIndexColumnTypes(m_columnCache, columnCount()));
+    for (auto it = m_trackInfo.constBegin(); it != m_trackInfo.constEnd(); ++it) {
+        m_pColumnarIndex->insertOrUpdate(it.key(), it.value());
+    }
+    qDebug() << this << "building the columnar index took"
+             << timer.elapsed().debugMillisWithUnit();
+}
+
+void BaseTrackCache::setFullTextSearchEnabled(bool enabled) {
+    m_pQueryParser->setFullTextSearchEnabled(enabled);
+}
+
 const TrackPointer& BaseTrackCache::getCachedTrack(TrackId trackId) const {
     DEBUG_ASSERT(m_bIsCaching);
     // Only refresh the recently used track if the identifiers
@@ -176,6 +248,9 @@ bool BaseTrackCache::updateTrackInIndex(
         for (int i = 0; i < numColumns; ++i) {
             record[i] = getTrackValueForColumn(pTrack, i);
         }
+        if (m_pColumnarIndex) {
+            m_pColumnarIndex->insertOrUpdate(trackId, record);
+        }
         if (m_bIsCaching) {
             replaceRecentTrack(trackId, pTrack);
         }
@@ -227,6 +302,9 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
                 record[i] = query.value(i);
             }
         }
+        if (m_pColumnarIndex) {
+            m_pColumnarIndex->insertOrUpdate(trackId, record);
+        }
     }
 
     qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
@@ -249,6 +327,9 @@ void BaseTrackCache::buildIndex() {
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
     m_trackInfo.clear();
+    if (m_pColumnarIndex) {
+        m_pColumnarIndex->clear();
+    }
     if (m_bIsCaching) {
         resetRecentTrack();
     }
@@ -462,16 +543,8 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         buildIndex();
     }
 
-    // The id string we need for our QSqlQuery
-    QStringList idStrings;
-    // The id set we need for removing/adding dirty tracks
-    QSet<TrackId> ids;
-    // TODO(rryan) consider making this the data passed in and a separate
-    // QVector for output
     QSet<TrackId> dirtyTracks;
     for (const auto& trackId : trackIds) {
-        idStrings << trackId.toString();
-        ids << trackId;
         if (m_dirtyTracks.contains(trackId)) {
             dirtyTracks.insert(trackId);
         }
@@ -492,46 +565,15 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     const std::unique_ptr<QueryNode> pQuery =
             m_pQueryParser->parseQuery(searchPlusExtraFilter, QString());
 
-    QString filter = pQuery->toSql();
-    if (!filter.isEmpty()) {
-        filter.prepend("WHERE ");
-    }
-
-    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
-
-    if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
-    }
-
-    QSqlQuery query(m_database);
-    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
-    // won't allocate a giant in-memory table that we won't use at all.
-    query.setForwardOnly(true);
-    query.prepare(queryString);
-
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
-
-    int idColumn = query.record().indexOf(m_idColumn);
-    int rows = query.size();
-
-    if (sDebug) {
-        qDebug() << "Rows returned:" << rows;
+    if (!filterAndSortInColumnarIndex(
+                trackIds, *pQuery, orderByClause, sortColumns, columnOffset)) {
+        queryTrackOrder(*pQuery, orderByClause);
     }
 
-    m_trackOrder.resize(0); // keeps allocated memory
     trackToIndex->clear();
-    if (rows > 0) {
-        trackToIndex->reserve(rows);
-        m_trackOrder.reserve(rows);
-    }
-
-    while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+    trackToIndex->reserve(m_trackOrder.size());
+    for (int i = 0; i < m_trackOrder.size(); ++i) {
+        (*trackToIndex)[m_trackOrder[i]] = i;
     }
 
     // At this point, the original set of tracks have been divided into two
@@ -561,7 +603,7 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         // or
         // the track matches the search and ids (if not empty) contains its id
         bool shouldBeInResultSet = searchPlusExtraFilter.isEmpty() ||
-                ((ids.isEmpty() || ids.contains(trackId)) && pQuery->match(pTrack));
+                (trackIds.contains(trackId) && pQuery->match(pTrack));
 
         // If the track is in this result set.
         bool isInResultSet = trackToIndex->contains(trackId);
@@ -611,6 +653,82 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     }
 }
 
+void BaseTrackCache::queryTrackOrder(
+        const QueryNode& query, const QString& orderByClause) {
+    QString filter = query.toSql();
+    if (!filter.isEmpty()) {
+        filter.prepend("WHERE ");
+    }
+
+    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
+            .arg(m_idColumn, m_tableName, filter, orderByClause);
+
+    if (sDebug) {
+        qDebug() << this << "select() executing:" << queryString;
+    }
+
+    QSqlQuery sqlQuery(m_database);
+    // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
+    // won't allocate a giant in-memory table that we won't use at all.
+    sqlQuery.setForwardOnly(true);
+    sqlQuery.prepare(queryString);
+
+    m_trackOrder.resize(0); // keeps allocated memory
+    if (!sqlQuery.exec()) {
+        LOG_FAILED_QUERY(sqlQuery);
+    }
+
+    int idColumn = sqlQuery.record().indexOf(m_idColumn);
+    int rows = sqlQuery.size();
+
+    if (sDebug) {
+        qDebug() << "Rows returned:" << rows;
+    }
+
+    if (rows > 0) {
+        m_trackOrder.reserve(rows);
+    }
+
+    while (sqlQuery.next()) {
+        m_trackOrder.append(TrackId(sqlQuery.value(idColumn)));
+    }
+}
+
+bool BaseTrackCache::filterAndSortInColumnarIndex(const QSet<TrackId>& trackIds,
+        const QueryNode& query,
+        const QString& orderByClause,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset) {
+    if (!m_pColumnarIndex || !query.prepareRecordMatching()) {
+        return false;
+    }
+
+    // The sort columns are only applied if the table is sorted by
+    // columns of the track source, see BaseSqlTableModel::setSort()
+    QList<SortColumn> indexSortColumns;
+    if (!orderByClause.isEmpty()) {
+        for (const auto& sortColumn : sortColumns) {
+            const int column = sortColumn.m_column - columnOffset;
+            // Column 0 is either the id or a column of the table, e.g.
+            // the preview column that is sorted randomly
+            if (column <= 0 || column >= columnCount()) {
+                return false;
+            }
+            indexSortColumns.append(SortColumn(column, sortColumn.m_order));
+        }
+    }
+
+    PerformanceTimer timer;
+    timer.start();
+    m_trackOrder = m_pColumnarIndex->filterAndSort(
+            trackIds, query, indexSortColumns, m_columnCache.keyNotation());
+    if (sDebug) {
+        qDebug() << this << "filterAndSortInColumnarIndex took"
+                 << timer.elapsed().debugMillisWithUnit();
+    }
+    return true;
+}
+
 int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         const QList<SortColumn>& sortColumns,
         const int columnOffset,
@@ -16,6 +16,8 @@
 #include "util/class.h"
 #include "util/string.h"
 
+class ColumnarTrackIndex;
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
 
@@ -75,6 +77,15 @@ class BaseTrackCache : public QObject {
     virtual bool isCached(TrackId trackId) const;
     virtual void ensureCached(TrackId trackId);
 
+    /// Filter and sort with an in-memory copy of all columns instead of
+    /// querying the database. Queries that can only be evaluated by SQLite
+    /// still use the database.
+    void setColumnarIndexEnabled(bool enabled);
+
+    /// Text searches use the full-text search index of the track collection.
+    /// Only applicable if the table is the library table or a view of it.
+    void setFullTextSearchEnabled(bool enabled);
+
   signals:
     void tracksChanged(const QSet<TrackId>& trackIds);
 
@@ -96,6 +107,13 @@ class BaseTrackCache : public QObject {
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
+
+    void queryTrackOrder(const QueryNode& query, const QString& orderByClause);
+    bool filterAndSortInColumnarIndex(const QSet<TrackId>& trackIds,
+            const QueryNode& query,
+            const QString& orderByClause,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset);
     QVariant getTrackValueForColumn(TrackPointer pTrack, int column) const;
 
     int findSortInsertionPoint(TrackPointer pTrack,
@@ -139,5 +157,8 @@ class BaseTrackCache : public QObject {
     QHash<TrackId, QVector<QVariant>> m_trackInfo;
     QSqlDatabase m_database;
 
+    // Optional, mirrors m_trackInfo
+    std::unique_ptr<ColumnarTrackIndex> m_pColumnarIndex;
+
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
 };
@@ -0,0 +1,437 @@
+#include "library/columnartrackindex.h"
+
+#include <QDir>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "library/basetrackcache.h"
+#include "library/columncache.h"
+#include "library/searchquery.h"
+#include "util/assert.h"
+#include "util/db/dbconnection.h"
+#include "util/string.h"
+
+namespace {
+
+// Distributing less rows over multiple threads is not worth the overhead
+constexpr std::size_t kMinRowsPerTask = 4096;
+
+constexpr double kNullNumber = std::numeric_limits<double>::quiet_NaN();
+
+const QString kEmptyString = QStringLiteral("");
+
+struct RowRange {
+    std::size_t begin;
+    std::size_t end;
+    std::vector<int> rows;
+};
+
+struct MergeTask {
+    std::size_t begin;
+    std::size_t middle;
+    std::size_t end;
+};
+
+std::vector<RowRange> splitRows(std::size_t numRows) {
+    const auto maxTasks = static_cast<std::size_t>(
+            std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+    const auto numTasks = std::clamp<std::size_t>(
+            numRows / kMinRowsPerTask, 1, maxTasks);
+    std::vector<RowRange> ranges;
+    ranges.reserve(numTasks);
+    for (std::size_t i = 0; i < numTasks; ++i) {
+        ranges.push_back(RowRange{
+                numRows * i / numTasks,
+                numRows * (i + 1) / numTasks,
+                {}});
+    }
+    return ranges;
+}
+
+template<typename T, typename Func>
+void runConcurrently(std::vector<T>* pTasks, Func func) {
+    if (pTasks->size() == 1) {
+        func(pTasks->front());
+    } else {
+        QtConcurrent::blockingMap(*pTasks, func);
+    }
+}
+
+/// Like `cast(text as integer)` in SQLite, i.e. 0 if the text
+/// doesn't start with a number.
+double leadingInteger(const QString& text) {
+    const QString trimmed = text.trimmed();
+    int end = 0;
+    if (end < trimmed.size() && (trimmed[end] == '-' || trimmed[end] == '+')) {
+        ++end;
+    }
+    while (end < trimmed.size() && trimmed[end] >= '0' && trimmed[end] <= '9') {
+        ++end;
+    }
+    bool ok = false;
+    const double value = trimmed.left(end).toDouble(&ok);
+    return ok ? value : 0.0;
+}
+
+/// NULL values are sorted first like in SQLite
+int compareNumbers(double lhs, double rhs) {
+    const bool lhsNull = std::isnan(lhs);
+    const bool rhsNull = std::isnan(rhs);
+    if (lhsNull || rhsNull) {
+        return static_cast<int>(rhsNull) - static_cast<int>(lhsNull);
+    }
+    if (lhs < rhs) {
+        return -1;
+    }
+    if (lhs > rhs) {
+        return 1;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+class ColumnarTrackIndex::Record : public TrackRecord {
+  public:
+    Record(const ColumnarTrackIndex& index, int row)
+            : m_index(index),
+              m_row(row) {
+    }
+
+    TrackId getId() const override {
+        return m_index.m_trackIds[m_row];
+    }
+
+    QVariant getValue(const QString& columnName) const override {
+        const int columnIndex = this->columnIndex(columnName);
+        if (columnIndex < 0) {
+            return QVariant();
+        }
+        const Column& column = m_index.m_columns[columnIndex];
+        if (column.type == ColumnType::Number) {
+            const double value = column.numbers[m_row];
+            if (std::isnan(value)) {
+                return QVariant();
+            }
+            return value;
+        }
+        const QString& text = column.texts[m_row];
+        if (text.isNull()) {
+            return QVariant();
+        }
+        if (columnIndex == m_index.m_yearColumn) {
+            // Same as for loaded tracks, only the year is matched
+            return text.left(4);
+        }
+        return text;
+    }
+
+    std::optional<QString> getLatinLowText(const QString& columnName) const override {
+        const int columnIndex = this->columnIndex(columnName);
+        if (columnIndex < 0) {
+            return std::nullopt;
+        }
+        const Column& column = m_index.m_columns[columnIndex];
+        if (column.type == ColumnType::Number) {
+            return TrackRecord::getLatinLowText(columnName);
+        }
+        if (column.texts[m_row].isNull()) {
+            return std::nullopt;
+        }
+        return column.latinLowTexts[m_row];
+    }
+
+  private:
+    int columnIndex(const QString& columnName) const {
+        const int index = m_index.m_columnCache.fieldIndex(columnName);
+        if (index >= static_cast<int>(m_index.m_columns.size())) {
+            return -1;
+        }
+        return index;
+    }
+
+    const ColumnarTrackIndex& m_index;
+    const int m_row;
+};
+
+ColumnarTrackIndex::ColumnarTrackIndex(const ColumnCache& columnCache,
+        const QVector<ColumnType>& columnTypes,
+        QLocale locale)
+        : m_columnCache(columnCache),
+          m_locale(std::move(locale)),
+          m_keyIdColumn(columnCache.fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY_ID)),
+          m_yearColumn(columnCache.fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR)),
+          m_directoryColumn(columnCache.fieldIndex(
+                  ColumnCache::COLUMN_TRACKLOCATIONSTABLE_DIRECTORY)) {
+    m_columns.resize(columnTypes.size());
+    for (int i = 0; i < columnTypes.size(); ++i) {
+        m_columns[i].type = columnTypes[i];
+    }
+    DEBUG_ASSERT(m_keyIdColumn < 0 ||
+            m_columns[m_keyIdColumn].type == ColumnType::Number);
+}
+
+void ColumnarTrackIndex::clear() {
+    for (auto& column : m_columns) {
+        column.texts.clear();
+        column.latinLowTexts.clear();
+        column.numbers.clear();
+        column.sortKeys.clear();
+    }
+    m_trackIds.clear();
+    m_rowsByTrackId.clear();
+    m_freeRows.clear();
+}
+
+int ColumnarTrackIndex::allocateRow(TrackId trackId) {
+    const auto it = m_rowsByTrackId.constFind(trackId);
+    if (it != m_rowsByTrackId.constEnd()) {
+        return it.value();
+    }
+
+    int row;
+    if (m_freeRows.empty()) {
+        row = static_cast<int>(m_trackIds.size());
+        m_trackIds.push_back(trackId);
+        for (auto& column : m_columns) {
+            if (column.type != ColumnType::Number) {
+                column.texts.emplace_back();
+                column.latinLowTexts.emplace_back();
+            }
+            if (column.type == ColumnType::Number ||
+                    column.type == ColumnType::IntegerText) {
+                column.numbers.push_back(kNullNumber);
+            }
+            if (!column.sortKeys.empty()) {
+                column.sortKeys.emplace_back();
+            }
+        }
+    } else {
+        row = m_freeRows.back();
+        m_freeRows.pop_back();
+        m_trackIds[row] = trackId;
+    }
+    m_rowsByTrackId.insert(trackId, row);
+    return row;
+}
+
+void ColumnarTrackIndex::setValue(int row, int columnIndex, const QVariant& value) {
+    Column& column = m_columns[columnIndex];
+    if (column.type == ColumnType::Number) {
+        column.numbers[row] = value.isNull() ? kNullNumber : value.toDouble();
+        return;
+    }
+
+    QString text;
+    if (!value.isNull()) {
+        text = value.toString();
+        if (text.isNull()) {
+            // Distinguish empty strings from NULL
+            text = kEmptyString;
+        } else if (columnIndex == m_directoryColumn) {
+            // Like the location that is already cached with native separators
+            text = QDir::toNativeSeparators(text);
+        }
+    }
+    if (column.type == ColumnType::IntegerText) {
+        column.numbers[row] = text.isNull() ? kNullNumber : leadingInteger(text);
+    }
+    QString latinLowText = text;
+    mixxx::DbConnection::makeStringLatinLow(&latinLowText);
+    column.texts[row] = std::move(text);
+    column.latinLowTexts[row] = std::move(latinLowText);
+    if (!column.sortKeys.empty()) {
+        column.sortKeys[row].reset();
+    }
+}
+
+void ColumnarTrackIndex::insertOrUpdate(TrackId trackId, const QVector<QVariant>& values) {
+    VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
+        return;
+    }
+    DEBUG_ASSERT(values.size() == static_cast<int>(m_columns.size()));
+    const int row = allocateRow(trackId);
+    for (int i = 0; i < static_cast<int>(m_columns.size()); ++i) {
+        setValue(row, i, values.value(i));
+    }
+}
+
+void ColumnarTrackIndex::remove(TrackId trackId) {
+    const auto it = m_rowsByTrackId.find(trackId);
+    if (it == m_rowsByTrackId.end()) {
+        return;
+    }
+    const int row = it.value();
+    m_rowsByTrackId.erase(it);
+    m_trackIds[row] = TrackId();
+    // Release the memory of the strings
+    for (auto& column : m_columns) {
+        if (column.type != ColumnType::Number) {
+            column.texts[row] = QString();
+            column.latinLowTexts[row] = QString();
+        }
+        if (!column.sortKeys.empty()) {
+            column.sortKeys[row].reset();
+        }
+    }
+    m_freeRows.push_back(row);
+}
+
+void ColumnarTrackIndex::updateSortKeys(const std::vector<int>& rows, int columnIndex) {
+    Column& column = m_columns[columnIndex];
+    if (column.sortKeys.size() < m_trackIds.size()) {
+        column.sortKeys.resize(m_trackIds.size());
+    }
+    std::vector<RowRange> ranges = splitRows(rows.size());
+    runConcurrently(&ranges, [this, &column, &rows](RowRange& range) {
+        // QCollator is not thread-safe, not even the implicitly shared copies
+        const mixxx::StringCollator collator(m_locale);
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            const int row = rows[i];
+            if (!column.sortKeys[row] && !column.texts[row].isNull()) {
+                column.sortKeys[row] = collator.sortKey(column.texts[row]);
+            }
+        }
+    });
+}
+
+void ColumnarTrackIndex::sortRows(std::vector<int>* pRows,
+        const QList<SortColumn>& sortColumns,
+        KeyUtils::KeyNotation keyNotation) const {
+    std::vector<int> keyOrder;
+    keyOrder.reserve(mixxx::track::io::key::ChromaticKey_MAX + 1);
+    for (int key = 0; key <= mixxx::track::io::key::ChromaticKey_MAX; ++key) {
+        keyOrder.push_back(KeyUtils::keyToCircleOfFifthsOrder(
+                static_cast<mixxx::track::io::key::ChromaticKey>(key),
+                keyNotation));
+    }
+    const auto keyNumber = [this, &keyOrder](int row) {
+        const double keyId = m_columns[m_keyIdColumn].numbers[row];
+        if (std::isnan(keyId) || keyId < 0 ||
+                keyId >= static_cast<double>(keyOrder.size())) {
+            return kNullNumber;
+        }
+        return static_cast<double>(keyOrder[static_cast<std::size_t>(keyId)]);
+    };
+
+    const auto compare = [this, &keyNumber](
+                                 const Column& column, int lhs, int rhs) {
+        switch (column.type) {
+        case ColumnType::Number:
+        case ColumnType::IntegerText:
+            return compareNumbers(column.numbers[lhs], column.numbers[rhs]);
+        case ColumnType::Key:
+            if (m_keyIdColumn < 0) {
+                return 0;
+            }
+            return compareNumbers(keyNumber(lhs), keyNumber(rhs));
+        case ColumnType::Text:
+            break;
+        }
+        const auto& lhsKey = column.sortKeys[lhs];
+        const auto& rhsKey = column.sortKeys[rhs];
+        if (!lhsKey || !rhsKey) {
+            // NULL values are sorted first
+            return static_cast<int>(rhsKey.has_value()) - static_cast<int>(lhsKey.has_value());
+        }
+        return lhsKey->compare(*rhsKey);
+    };
+
+    const auto lessThan = [this, &sortColumns, &compare](int lhs, int rhs) {
+        for (const auto& sortColumn : sortColumns) {
+            const int result = compare(m_columns[sortColumn.m_column], lhs, rhs);
+            if (result != 0) {
+                return sortColumn.m_order == Qt::AscendingOrder ? result < 0 : result > 0;
+            }
+        }
+        // Make the order deterministic
+        return m_trackIds[lhs] < m_trackIds[rhs];
+    };
+
+    std::vector<RowRange> ranges = splitRows(pRows->size());
+    runConcurrently(&ranges, [pRows, &lessThan](RowRange& range) {
+        std::sort(pRows->begin() + range.begin, pRows->begin() + range.end, lessThan);
+    });
+
+    // Merge the sorted ranges pairwise
+    std::vector<std::size_t> bounds;
+    bounds.reserve(ranges.size() + 1);
+    for (const auto& range : ranges) {
+        bounds.push_back(range.begin);
+    }
+    bounds.push_back(pRows->size());
+    while (bounds.size() > 2) {
+        std::vector<MergeTask> tasks;
+        std::vector<std::size_t> mergedBounds;
+        for (std::size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            tasks.push_back(MergeTask{bounds[i], bounds[i + 1], bounds[i + 2]});
+            mergedBounds.push_back(bounds[i]);
+        }
+        if (bounds.size() % 2 == 0) {
+            // An odd number of ranges, the last one is merged in the next pass
+            mergedBounds.push_back(bounds[bounds.size() - 2]);
+        }
+        mergedBounds.push_back(pRows->size());
+        runConcurrently(&tasks, [pRows, &lessThan](MergeTask& task) {
+            std::inplace_merge(pRows->begin() + task.begin,
+                    pRows->begin() + task.middle,
+                    pRows->begin() + task.end,
+                    lessThan);
+        });
+        bounds = std::move(mergedBounds);
+    }
+}
+
+QVector<TrackId> ColumnarTrackIndex::filterAndSort(
+        const QSet<TrackId>& trackIds,
+        const QueryNode& query,
+        const QList<SortColumn>& sortColumns,
+        KeyUtils::KeyNotation keyNotation) {
+    std::vector<int> candidateRows;
+    candidateRows.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+        const auto it = m_rowsByTrackId.constFind(trackId);
+        if (it != m_rowsByTrackId.constEnd()) {
+            candidateRows.push_back(it.value());
+        }
+    }
+
+    std::vector<RowRange> ranges = splitRows(candidateRows.size());
+    runConcurrently(&ranges, [this, &query, &candidateRows](RowRange& range) {
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            const int row = candidateRows[i];
+            if (query.match(Record(*this, row))) {
+                range.rows.push_back(row);
+            }
+        }
+    });
+    std::vector<int> rows;
+    rows.reserve(candidateRows.size());
+    for (const auto& range : ranges) {
+        rows.insert(rows.end(), range.rows.begin(), range.rows.end());
+    }
+
+    if (!sortColumns.isEmpty() && rows.size() > 1) {
+        for (const auto& sortColumn : sortColumns) {
+            VERIFY_OR_DEBUG_ASSERT(sortColumn.m_column >= 0 &&
+                    sortColumn.m_column < static_cast<int>(m_columns.size())) {
+                return {};
+            }
+            if (m_columns[sortColumn.m_column].type == ColumnType::Text) {
+                updateSortKeys(rows, sortColumn.m_column);
+            }
+        }
+        sortRows(&rows, sortColumns, keyNotation);
+    }
+
+    QVector<TrackId> sortedTrackIds;
+    sortedTrackIds.reserve(static_cast<int>(rows.size()));
+    for (const int row : rows) {
+        sortedTrackIds.append(m_trackIds[row]);
+    }
+    return sortedTrackIds;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QCollatorSortKey>
+#include <QHash>
+#include <QList>
+#include <QLocale>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <optional>
+#include <vector>
+
+#include "track/keyutils.h"
+#include "track/trackid.h"
+
+class ColumnCache;
+class QueryNode;
+class SortColumn;
+
+/// An in-memory copy of the columns of a BaseTrackCache for filtering and
+/// sorting tracks without querying the database.
+///
+/// Each column is stored in a separate array that is indexed by row. Text
+/// columns additionally store the folded strings for matching search terms
+/// and the collation keys for sorting, the latter are only created when
+/// sorting by that column for the first time. Numeric columns are stored as
+/// plain doubles with NaN representing NULL.
+///
+/// Filtering and sorting are distributed over the global thread pool.
+class ColumnarTrackIndex {
+  public:
+    enum class ColumnType {
+        /// Sorted with the collator
+        Text,
+        /// Sorted by the leading integer, i.e. `cast(... as integer)`
+        IntegerText,
+        /// Stored and sorted as double
+        Number,
+        /// Sorted by the key id column in circle of fifths order
+        Key,
+    };
+
+    /// The column types are given in the order of the field indices of
+    /// the column cache.
+    ColumnarTrackIndex(const ColumnCache& columnCache,
+            const QVector<ColumnType>& columnTypes,
+            QLocale locale = QLocale());
+
+    int size() const {
+        return m_rowsByTrackId.size();
+    }
+
+    /// The values must be given in the order of the field indices, i.e.
+    /// like the records of BaseTrackCache.
+    void insertOrUpdate(TrackId trackId, const QVector<QVariant>& values);
+    void remove(TrackId trackId);
+    void clear();
+
+    /// Returns the ids of all indexed tracks in trackIds that match the
+    /// query, sorted like by an `ORDER BY` clause for the sort columns.
+    ///
+    /// The sort columns must refer to field indices. QueryNode::prepareRecordMatching()
+    /// must have returned true before.
+    QVector<TrackId> filterAndSort(
+            const QSet<TrackId>& trackIds,
+            const QueryNode& query,
+            const QList<SortColumn>& sortColumns,
+            KeyUtils::KeyNotation keyNotation);
+
+  private:
+    /// Provides the values of a single row for matching queries
+    class Record;
+
+    struct Column {
+        ColumnType type;
+        /// NULL values are stored as null strings. Empty for numbers.
+        std::vector<QString> texts;
+        /// Empty for numbers
+        std::vector<QString> latinLowTexts;
+        /// Only for Number and IntegerText
+        std::vector<double> numbers;
+        /// Empty until sorted by this column for the first time
+        std::vector<std::optional<QCollatorSortKey>> sortKeys;
+    };
+
+    int allocateRow(TrackId trackId);
+    void setValue(int row, int column, const QVariant& value);
+    void updateSortKeys(const std::vector<int>& rows, int column);
+    void sortRows(std::vector<int>* pRows,
+            const QList<SortColumn>& sortColumns,
+            KeyUtils::KeyNotation keyNotation) const;
+
+    const ColumnCache& m_columnCache;
+    /// Each thread needs its own collator for creating the sort keys
+    const QLocale m_locale;
+    const int m_keyIdColumn;
+    const int m_yearColumn;
+    const int m_directoryColumn;
+
+    std::vector<Column> m_columns;
+    std::vector<TrackId> m_trackIds;
+    QHash<TrackId, int> m_rowsByTrackId;
+    std::vector<int> m_freeRows;
+};
@@ -1,22 +1,56 @@
 #include "library/dao/analysisdao.h"
 
+#include <QFile>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QtDebug>
+#include <limits>
 
 #include "library/queryutil.h"
 #include "preferences/waveformsettings.h"
+#include "util/assert.h"
 #include "util/performancetimer.h"
 #include "waveform/waveform.h"
 
 const QString AnalysisDao::s_analysisTableName = "track_analysis";
 
+namespace {
+
 // For a track that takes 1.2MB to store the big waveform, the default
 // compression level (-1) takes the size down to about 600KB. The difference
 // between the default and 9 (the max) was only about 1-2KB for a lot of extra
 // CPU time so I think we should stick with the default. rryan 4/3/2012
 constexpr int kCompressionLevel = -1;
 
+const QString kRawFileSuffix = QStringLiteral(".raw");
+
+int checksum(const QByteArray& data) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return qChecksum(data);
+#else
+    return qChecksum(data.constData(), data.length());
+#endif
+}
+
+/// Maps the whole file into memory. The returned byte array refers to the
+/// mapped memory and is only valid while the file is open.
+QByteArray mapFile(QFile* pFile) {
+    if (!pFile->open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    const qint64 size = pFile->size();
+    if (size <= 0 || size > std::numeric_limits<int>::max()) {
+        return QByteArray();
+    }
+    const uchar* pData = pFile->map(0, size);
+    if (!pData) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(pData), static_cast<int>(size));
+}
+
+} // anonymous namespace
+
 AnalysisDao::AnalysisDao(UserSettingsPointer pConfig)
         : m_pConfig(pConfig) {
     QDir storagePath = getAnalysisStoragePath();
@@ -81,25 +115,34 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         info.type = static_cast<AnalysisType>(query->value(typeColumn).toInt());
         info.description = query->value(descriptionColumn).toString();
         info.version = query->value(versionColumn).toString();
-        int checksum = query->value(dataChecksumColumn).toInt();
-        QString dataPath = analysisPath.absoluteFilePath(
-            QString::number(info.analysisId));
-        const QByteArray compressedData = loadDataFromFile(dataPath);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        const int file_checksum = qChecksum(
-                compressedData);
-#else
-        const int file_checksum = qChecksum(
-                compressedData.constData(),
-                compressedData.length());
-#endif
-        if (checksum != file_checksum) {
-            qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
-            continue;
+        const int dataChecksum = query->value(dataChecksumColumn).toInt();
+        const QString analysisId = QString::number(info.analysisId);
+        QString dataPath = getAnalysisFilePath(analysisPath, analysisId, DataFormat::Raw);
+        if (QFile::exists(dataPath)) {
+            // Only verified here and mapped again when the data is read,
+            // see readData()
+            QFile file(dataPath);
+            const QByteArray data = mapFile(&file);
+            if (dataChecksum != checksum(data)) {
+                qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
+                         << "length" << data.length();
+                continue;
+            }
+            info.dataFormat = DataFormat::Raw;
+            info.dataFilePath = dataPath;
+            bytes += data.length();
+        } else {
+            dataPath = getAnalysisFilePath(analysisPath, analysisId, DataFormat::Compressed);
+            const QByteArray compressedData = loadDataFromFile(dataPath);
+            if (dataChecksum != checksum(compressedData)) {
+                qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
+                         << "length" << compressedData.length();
+                continue;
+            }
+            info.dataFormat = DataFormat::Compressed;
+            info.data = qUncompress(compressedData);
+            bytes += info.data.length();
         }
-        info.data = qUncompress(compressedData);
-        bytes += info.data.length();
         analyses.append(info);
     }
     qDebug() << "AnalysisDAO fetched" << analyses.size() << "analyses,"
@@ -108,6 +151,19 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
     return analyses;
 }
 
+//static
+QByteArray AnalysisDao::readData(const AnalysisInfo& analysis, QFile* pFile) {
+    switch (analysis.dataFormat) {
+    case DataFormat::Compressed:
+        return analysis.data;
+    case DataFormat::Raw:
+        pFile->setFileName(analysis.dataFilePath);
+        return mapFile(pFile);
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QByteArray();
+}
+
 bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     if (!m_database.isOpen() || info == nullptr) {
         return false;
@@ -120,15 +176,10 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    const QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    const int checksum = qChecksum(
-            compressedData);
-#else
-    const int checksum = qChecksum(
-            compressedData.constData(),
-            compressedData.length());
-#endif
+    const QByteArray fileData = info->dataFormat == DataFormat::Raw
+            ? info->data
+            : qCompress(info->data, kCompressionLevel);
+    const int dataChecksum = checksum(fileData);
     QSqlQuery query(m_database);
     if (info->analysisId == -1) {
         query.prepare(QString(
@@ -140,7 +191,7 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
         query.bindValue(":type", info->type);
         query.bindValue(":description", info->description);
         query.bindValue(":version", info->version);
-        query.bindValue(":data_checksum", checksum);
+        query.bindValue(":data_checksum", dataChecksum);
 
         if (!query.exec()) {
             LOG_FAILED_QUERY(query) << "couldn't save new analysis";
@@ -162,7 +213,7 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
         query.bindValue(":type", info->type);
         query.bindValue(":description", info->description);
         query.bindValue(":version", info->version);
-        query.bindValue(":data_checksum", checksum);
+        query.bindValue(":data_checksum", dataChecksum);
 
         if (!query.exec()) {
             LOG_FAILED_QUERY(query) << "couldn't update existing analysis";
@@ -170,16 +221,23 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
         }
     }
 
-    QString dataPath = getAnalysisStoragePath().absoluteFilePath(
-        QString::number(info->analysisId));
-    if (!saveDataToFile(dataPath, compressedData)) {
+    const QDir analysisPath = getAnalysisStoragePath();
+    const QString analysisId = QString::number(info->analysisId);
+    QString dataPath = getAnalysisFilePath(analysisPath, analysisId, info->dataFormat);
+    if (!saveDataToFile(dataPath, fileData)) {
         qDebug() << "WARNING: Couldn't save analysis data to file" << dataPath;
         return false;
     }
+    // Otherwise the outdated file in the other format would be loaded or
+    // leak when the analysis is deleted by a previous version of Mixxx.
+    deleteFile(getAnalysisFilePath(analysisPath,
+            analysisId,
+            info->dataFormat == DataFormat::Raw ? DataFormat::Compressed
+                                                : DataFormat::Raw));
 
     qDebug() << "AnalysisDAO saved analysis" << info->analysisId
-             << QString("%1 (%2 compressed)").arg(QString::number(info->data.length()),
-                                                  QString::number(compressedData.length()))
+             << QString("%1 (%2 on disk)").arg(QString::number(info->data.length()),
+                                                QString::number(fileData.length()))
              << "bytes for track"
              << info->trackId << "in" << time.elapsed().debugMillisWithUnit();
     return true;
@@ -199,9 +257,7 @@ bool AnalysisDao::deleteAnalysis(const int analysisId) {
         return false;
     }
 
-    QString dataPath = getAnalysisStoragePath().absoluteFilePath(
-        QString::number(analysisId));
-    deleteFile(dataPath);
+    deleteFiles(getAnalysisStoragePath(), QString::number(analysisId));
     return true;
 }
 
@@ -219,9 +275,7 @@ void AnalysisDao::deleteAnalyses(const QList<TrackId>& trackIds) {
     const int idColumn = query.record().indexOf("id");
     QDir analysisPath(getAnalysisStoragePath());
     while (query.next()) {
-        int id = query.value(idColumn).toInt();
-        QString dataPath = analysisPath.absoluteFilePath(QString::number(id));
-        deleteFile(dataPath);
+        deleteFiles(analysisPath, query.value(idColumn).toString());
     }
     query.prepare(QString("DELETE FROM track_analysis "
                           "WHERE track_id in (%1)").arg(idList.join(",")));
@@ -262,6 +316,19 @@ QDir AnalysisDao::getAnalysisStoragePath() const {
     return dir.absolutePath().append("/");
 }
 
+QString AnalysisDao::getAnalysisFilePath(const QDir& analysisPath,
+        const QString& analysisId,
+        DataFormat dataFormat) const {
+    switch (dataFormat) {
+    case DataFormat::Compressed:
+        return analysisPath.absoluteFilePath(analysisId);
+    case DataFormat::Raw:
+        return analysisPath.absoluteFilePath(analysisId + kRawFileSuffix);
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
 QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
     QFile file(filename);
     if (!file.exists()) {
@@ -278,6 +345,11 @@ bool AnalysisDao::deleteFile(const QString& fileName) const {
     return file.remove();
 }
 
+void AnalysisDao::deleteFiles(const QDir& analysisPath, const QString& analysisId) const {
+    deleteFile(getAnalysisFilePath(analysisPath, analysisId, DataFormat::Compressed));
+    deleteFile(getAnalysisFilePath(analysisPath, analysisId, DataFormat::Raw));
+}
+
 bool AnalysisDao::saveDataToFile(const QString& fileName, const QByteArray& data) const {
     QFile file(fileName);
 
@@ -340,7 +412,8 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVEFORM;
     analysis.description = pWaveform->getDescription();
     analysis.version = pWaveform->getVersion();
-    analysis.data = pWaveform->toByteArray();
+    analysis.dataFormat = DataFormat::Raw;
+    analysis.data = pWaveform->toRawByteArray();
     bool success = saveAnalysis(&analysis);
     if (success) {
         pWaveform->setSaveState(Waveform::SaveState::Saved);
@@ -355,7 +428,7 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
     analysis.description = pWaveSummary->getDescription();
     analysis.version = pWaveSummary->getVersion();
-    analysis.data = pWaveSummary->toByteArray();
+    analysis.data = pWaveSummary->toRawByteArray();
 
     success = saveAnalysis(&analysis);
     if (success) {
@@ -383,8 +456,13 @@ size_t AnalysisDao::getDiskUsageInBytes(
     const int idColumn = query.record().indexOf("id");
     size_t total = 0;
     while (query.next()) {
-        total += QFileInfo(analysisPath.absoluteFilePath(
-                query.value(idColumn).toString())).size();
+        const QString analysisId = query.value(idColumn).toString();
+        total += QFileInfo(getAnalysisFilePath(
+                                   analysisPath, analysisId, DataFormat::Compressed))
+                         .size();
+        total += QFileInfo(getAnalysisFilePath(
+                                   analysisPath, analysisId, DataFormat::Raw))
+                         .size();
     }
     return total;
 }
@@ -405,8 +483,7 @@ bool AnalysisDao::deleteAnalysesByType(
 
     const int idColumn = query.record().indexOf("id");
     while (query.next()) {
-        QString dataPath = analysisPath.absoluteFilePath(query.value(idColumn).toString());
-        deleteFile(dataPath);
+        deleteFiles(analysisPath, query.value(idColumn).toString());
     }
     query.prepare(QString("DELETE FROM %1 WHERE type=:type").arg(s_analysisTableName));
     query.bindValue(":type", type);
@@ -7,6 +7,7 @@
 #include "track/trackid.h"
 #include "waveform/waveform.h"
 
+class QFile;
 class QSqlDatabase;
 
 class AnalysisDao : public DAO {
@@ -19,17 +20,35 @@ class AnalysisDao : public DAO {
         TYPE_WAVESUMMARY
     };
 
+    /// How the data is stored on disk
+    enum class DataFormat {
+        /// qCompress()ed protobuf in the file named after the id
+        Compressed,
+        /// Uncompressed in the file named after the id with the suffix
+        /// ".raw". It is memory mapped when the data is read.
+        /// The files are several times larger than the compressed ones,
+        /// but they are loaded without decoding. Only newly analyzed
+        /// waveforms are stored in this format, existing compressed
+        /// analyses are kept until the track is analyzed again.
+        Raw,
+    };
+
     struct AnalysisInfo {
         AnalysisInfo()
                 : analysisId(-1),
-                  type(TYPE_UNKNOWN) {
+                  type(TYPE_UNKNOWN),
+                  dataFormat(DataFormat::Compressed) {
         }
         int analysisId;
         TrackId trackId;
         AnalysisType type;
         QString description;
         QString version;
+        DataFormat dataFormat;
+        // Empty for the raw format, use readData() instead
         QByteArray data;
+        // The file of the raw format
+        QString dataFilePath;
     };
 
     explicit AnalysisDao(UserSettingsPointer pConfig);
@@ -45,6 +64,12 @@ class AnalysisDao : public DAO {
             const QSqlDatabase& database,
             AnalysisType type) const;
 
+    /// Returns the data of an analysis. The file of the raw format is
+    /// mapped into memory by pFile and the returned data is only valid
+    /// while it is open. The file is not kept open by the loaded analyses,
+    /// because a mapped file can't be deleted or replaced on Windows.
+    static QByteArray readData(const AnalysisInfo& analysis, QFile* pFile);
+
     QList<AnalysisInfo> getAnalysesForTrackByType(TrackId trackId, AnalysisType type);
     QList<AnalysisInfo> getAnalysesForTrack(TrackId trackId);
     bool saveAnalysis(AnalysisInfo* analysis);
@@ -59,9 +84,13 @@ class AnalysisDao : public DAO {
 
   private:
     QDir getAnalysisStoragePath() const;
+    QString getAnalysisFilePath(const QDir& analysisPath,
+            const QString& analysisId,
+            DataFormat dataFormat) const;
     QByteArray loadDataFromFile(const QString& fileName) const;
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
+    void deleteFiles(const QDir& analysisPath, const QString& analysisId) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
 
     const UserSettingsPointer m_pConfig;
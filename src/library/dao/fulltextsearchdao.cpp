@@ -0,0 +1,253 @@
+#include "library/dao/fulltextsearchdao.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "library/dao/trackschema.h"
+#include "library/library_prefs.h"
+#include "library/queryutil.h"
+#include "util/db/sqllikewildcards.h"
+#include "util/db/sqltransaction.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("FullTextSearchDAO");
+
+const QString kTableName = QStringLiteral("library_fts");
+const QString kLibraryTable = QStringLiteral(LIBRARY_TABLE);
+const QString kTrackLocationsTable = QStringLiteral(TRACKLOCATIONS_TABLE);
+
+/// The columns of the library table, the location is stored in
+/// the track_locations table.
+const QStringList kLibraryColumns = {
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_ALBUM,
+        LIBRARYTABLE_ALBUMARTIST,
+        LIBRARYTABLE_GENRE,
+        LIBRARYTABLE_COMMENT,
+        LIBRARYTABLE_GROUPING,
+};
+
+const QStringList kColumns = kLibraryColumns + QStringList{TRACKLOCATIONSTABLE_LOCATION};
+
+const QStringList kTriggerNames = {
+        QStringLiteral("library_fts_insert"),
+        QStringLiteral("library_fts_update"),
+        QStringLiteral("library_fts_delete"),
+        QStringLiteral("library_fts_relocate"),
+};
+
+/// The trigram tokenizer can only match substrings with at least 3 characters
+constexpr int kMinArgumentLength = 3;
+
+/// The text is stored folded by the latinlow() function of DbConnection
+/// that is also applied by the LIKE operator. The tokenizer alone doesn't
+/// decompose the characters of other scripts like Greek, kana with dakuten
+/// or compatibility forms.
+QStringList foldedColumns(const QString& prefix, const QStringList& columns) {
+    QStringList folded;
+    folded.reserve(columns.size());
+    for (const auto& column : columns) {
+        folded.append(QStringLiteral("latinlow(%1%2)").arg(prefix, column));
+    }
+    return folded;
+}
+
+/// The triggers are temporary, i.e. they only exist for the connection that
+/// created them. Persistent triggers would break every modification of the
+/// library by other applications or older versions that don't provide the
+/// latinlow() function.
+QStringList createTriggerQueries() {
+    const QString columns = kColumns.join(QStringLiteral(", "));
+    const QString insertNewRow =
+            QStringLiteral(
+                    "INSERT INTO %1(rowid, %2) VALUES (new.%3, %4, "
+                    "(SELECT latinlow(%5) FROM %6 WHERE %7=new.%8));")
+                    .arg(kTableName,
+                            columns,
+                            LIBRARYTABLE_ID,
+                            foldedColumns(QStringLiteral("new."), kLibraryColumns)
+                                    .join(QStringLiteral(", ")),
+                            TRACKLOCATIONSTABLE_LOCATION,
+                            kTrackLocationsTable,
+                            TRACKLOCATIONSTABLE_ID,
+                            LIBRARYTABLE_LOCATION);
+    const QString deleteOldRow =
+            QStringLiteral("DELETE FROM %1 WHERE rowid=old.%2;")
+                    .arg(kTableName, LIBRARYTABLE_ID);
+    return {
+            QStringLiteral(
+                    "CREATE TEMP TRIGGER IF NOT EXISTS %1 AFTER INSERT ON main.%2 "
+                    "BEGIN %3 END")
+                    .arg(kTriggerNames[0], kLibraryTable, insertNewRow),
+            QStringLiteral(
+                    "CREATE TEMP TRIGGER IF NOT EXISTS %1 AFTER UPDATE OF %2, %3 "
+                    "ON main.%4 BEGIN %5 %6 END")
+                    .arg(kTriggerNames[1],
+                            kLibraryColumns.join(QStringLiteral(", ")),
+                            LIBRARYTABLE_LOCATION,
+                            kLibraryTable,
+                            deleteOldRow,
+                            insertNewRow),
+            QStringLiteral(
+                    "CREATE TEMP TRIGGER IF NOT EXISTS %1 AFTER DELETE ON main.%2 "
+                    "BEGIN %3 END")
+                    .arg(kTriggerNames[2], kLibraryTable, deleteOldRow),
+            QStringLiteral(
+                    "CREATE TEMP TRIGGER IF NOT EXISTS %1 AFTER UPDATE OF %2 "
+                    "ON main.%3 BEGIN "
+                    "UPDATE %4 SET %2=latinlow(new.%2) WHERE rowid IN "
+                    "(SELECT %5 FROM %6 WHERE %7=new.%8); END")
+                    .arg(kTriggerNames[3],
+                            TRACKLOCATIONSTABLE_LOCATION,
+                            kTrackLocationsTable,
+                            kTableName,
+                            LIBRARYTABLE_ID,
+                            kLibraryTable,
+                            LIBRARYTABLE_LOCATION,
+                            TRACKLOCATIONSTABLE_ID),
+    };
+}
+
+QStringList dropTriggerQueries() {
+    QStringList queries;
+    for (const auto& triggerName : kTriggerNames) {
+        queries.append(QStringLiteral("DROP TRIGGER IF EXISTS temp.%1").arg(triggerName));
+    }
+    return queries;
+}
+
+bool execQueries(const QSqlDatabase& database, const QStringList& queries) {
+    QSqlQuery query(database);
+    for (const auto& queryString : queries) {
+        if (!query.exec(queryString)) {
+            kLogger.warning()
+                    << "Failed to execute" << queryString << ':' << query.lastError();
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Fails if the table doesn't exist or the FTS5 module is not available
+bool isIndexUsable(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    return query.exec(QStringLiteral("SELECT rowid FROM main.%1 LIMIT 0").arg(kTableName));
+}
+
+} // anonymous namespace
+
+FullTextSearchDAO::FullTextSearchDAO(UserSettingsPointer pConfig)
+        : m_pConfig(std::move(pConfig)),
+          m_available(false) {
+}
+
+void FullTextSearchDAO::initialize(const QSqlDatabase& database) {
+    DAO::initialize(database);
+    m_available = false;
+    setEnabled(m_pConfig->getValue(mixxx::library::prefs::kFullTextSearchConfigKey,
+            mixxx::library::prefs::kFullTextSearchDefault));
+}
+
+void FullTextSearchDAO::setEnabled(bool enabled) {
+    if (enabled) {
+        // The index is rebuilt, because the library might have been
+        // modified without the triggers in the meantime.
+        m_available = createIndex();
+    } else {
+        m_available = false;
+        dropIndex();
+    }
+}
+
+// static
+void FullTextSearchDAO::attachConnection(const QSqlDatabase& database) {
+    if (isIndexUsable(database)) {
+        execQueries(database, createTriggerQueries());
+    } else {
+        execQueries(database, dropTriggerQueries());
+    }
+}
+
+bool FullTextSearchDAO::createIndex() {
+    PerformanceTimer timer;
+    timer.start();
+
+    SqlTransaction transaction(m_database);
+    if (!transaction) {
+        return false;
+    }
+    // Requires the trigram tokenizer of SQLite 3.34. The diacritics have
+    // already been removed by latinlow().
+    QStringList queries = {
+            QStringLiteral("DROP TABLE IF EXISTS main.%1").arg(kTableName),
+            QStringLiteral(
+                    "CREATE VIRTUAL TABLE main.%1 USING fts5(%2, "
+                    "tokenize='trigram case_sensitive 0')")
+                    .arg(kTableName, kColumns.join(QStringLiteral(", "))),
+            QStringLiteral(
+                    "INSERT INTO main.%1(rowid, %2) SELECT %3.%4, %5, latinlow(%6.%7) "
+                    "FROM %3 LEFT JOIN %6 ON %3.%8=%6.%9")
+                    .arg(kTableName,
+                            kColumns.join(QStringLiteral(", ")),
+                            kLibraryTable,
+                            LIBRARYTABLE_ID,
+                            foldedColumns(kLibraryTable + QChar('.'), kLibraryColumns)
+                                    .join(QStringLiteral(", ")),
+                            kTrackLocationsTable,
+                            TRACKLOCATIONSTABLE_LOCATION,
+                            LIBRARYTABLE_LOCATION,
+                            TRACKLOCATIONSTABLE_ID),
+    };
+    queries += createTriggerQueries();
+    if (!execQueries(m_database, queries)) {
+        kLogger.info() << "Full-text search is not available, "
+                          "falling back to LIKE clauses";
+        transaction.rollback();
+        dropIndex();
+        return false;
+    }
+    if (!transaction.commit()) {
+        return false;
+    }
+    kLogger.info()
+            << "Created full-text search index in"
+            << timer.elapsed().debugMillisWithUnit();
+    return true;
+}
+
+void FullTextSearchDAO::dropIndex() {
+    execQueries(m_database, dropTriggerQueries());
+    // Fails if the FTS5 module is not available. The orphaned table
+    // is harmless, it is not used or modified without the triggers.
+    execQueries(m_database, {QStringLiteral("DROP TABLE IF EXISTS main.%1").arg(kTableName)});
+}
+
+QString FullTextSearchDAO::selectTrackIdsSql(
+        const QString& idColumn,
+        const QStringList& sqlColumns,
+        const QString& argument) const {
+    if (!m_available || sqlColumns.isEmpty()) {
+        return QString();
+    }
+    for (const auto& sqlColumn : sqlColumns) {
+        if (!kColumns.contains(sqlColumn)) {
+            return QString();
+        }
+    }
+    // LIKE wildcards typed by the user can't be matched by the index
+    if (argument.toUcs4().size() < kMinArgumentLength ||
+            argument.contains(kSqlLikeMatchAll) ||
+            argument.contains(kSqlLikeMatchOne)) {
+        return QString();
+    }
+    QString phrase = argument;
+    phrase.replace(QChar('"'), QStringLiteral("\"\""));
+    const QString match = QStringLiteral("{%1} : \"%2\"")
+                                  .arg(sqlColumns.join(QChar(' ')), phrase);
+    return QStringLiteral("%1 IN (SELECT rowid FROM %2 WHERE %2 MATCH %3)")
+            .arg(idColumn, kTableName, FieldEscaper(m_database).escapeString(match));
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include "library/dao/dao.h"
+#include "preferences/usersettings.h"
+
+/// Maintains the SQLite FTS5 table `library_fts` with the text columns of
+/// the library that are searched by default.
+///
+/// The table uses the trigram tokenizer that supports matching arbitrary
+/// substrings with at least 3 characters. It is kept in sync with the
+/// `library` and `track_locations` tables by triggers, i.e. independent of
+/// which code path modifies the tracks. The text is stored folded by the
+/// `latinlow()` SQL function of DbConnection, the same folding that is
+/// applied by the LIKE operator.
+///
+/// The triggers are temporary, i.e. they need to be created for each
+/// connection that modifies the library, see attachConnection(). Other
+/// applications and older versions that don't provide `latinlow()` are
+/// still able to modify the library, but don't update the index. That's
+/// why the index is rebuilt whenever it is enabled.
+///
+/// The index is optional: If the SQLite library does not provide the
+/// required FTS5 features it is not created and all text searches fall
+/// back to LIKE clauses.
+class FullTextSearchDAO : public DAO {
+  public:
+    explicit FullTextSearchDAO(UserSettingsPointer pConfig);
+    ~FullTextSearchDAO() override = default;
+
+    /// Creates and populates the index if enabled in the preferences.
+    /// This may take a while for large libraries.
+    void initialize(const QSqlDatabase& database) override;
+
+    /// (Re-)creates or drops the index
+    void setEnabled(bool enabled);
+
+    /// Keeps the index in sync with the modifications made through another
+    /// connection, e.g. that of the library scanner. Must be invoked again
+    /// whenever the index might have been enabled or disabled.
+    static void attachConnection(const QSqlDatabase& database);
+
+    bool isAvailable() const {
+        return m_available;
+    }
+
+    /// Returns a condition that selects the ids of all tracks that might
+    /// contain the argument in one of the columns. It doesn't replace the
+    /// LIKE clauses, but narrows down the rows that need to be checked by
+    /// them.
+    ///
+    /// The argument must be folded by DbConnection::makeStringLatinLow()
+    /// like the text in the index.
+    ///
+    /// Returns a null string if the index is not available or cannot be
+    /// used for these columns or this argument.
+    QString selectTrackIdsSql(
+            const QString& idColumn,
+            const QStringList& sqlColumns,
+            const QString& argument) const;
+
+  private:
+    bool createIndex();
+    void dropIndex();
+
+    const UserSettingsPointer m_pConfig;
+    bool m_available;
+};
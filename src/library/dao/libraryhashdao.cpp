@@ -19,6 +19,14 @@ inline constexpr mixxx::cache_key_signed_t dbHash(mixxx::cache_key_t hash) {
     return mixxx::signedCacheKey(hash);
 }
 
+// Modification times are stored in milliseconds since 1970-01-01T00:00:00.000 UTC
+QVariant dbModifiedTime(const QDateTime& modifiedAt) {
+    if (!modifiedAt.isValid()) {
+        return QVariant();
+    }
+    return modifiedAt.toMSecsSinceEpoch();
+}
+
 } // anonymous namespace
 
 QHash<QString, mixxx::cache_key_t> LibraryHashDAO::getDirectoryHashes() {
@@ -39,6 +47,27 @@ QHash<QString, mixxx::cache_key_t> LibraryHashDAO::getDirectoryHashes() {
     return hashes;
 }
 
+QHash<QString, QDateTime> LibraryHashDAO::getDirectoryModifiedTimes() {
+    QSqlQuery query(m_database);
+    query.prepare(
+            "SELECT modified_ms, directory_path FROM LibraryHashes "
+            "WHERE modified_ms IS NOT NULL");
+    QHash<QString, QDateTime> modifiedTimes;
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    const int modifiedColumn = query.record().indexOf("modified_ms");
+    const int directoryPathColumn = query.record().indexOf("directory_path");
+    while (query.next()) {
+        modifiedTimes[query.value(directoryPathColumn).toString()] =
+                QDateTime::fromMSecsSinceEpoch(
+                        query.value(modifiedColumn).toLongLong());
+    }
+
+    return modifiedTimes;
+}
+
 mixxx::cache_key_t LibraryHashDAO::getDirectoryHash(const QString& dirPath) {
     //qDebug() << "LibraryHashDAO::getDirectoryHash" << QThread::currentThread() << m_database.connectionName();
     mixxx::cache_key_t hash = mixxx::invalidCacheKey();
@@ -62,14 +91,19 @@ mixxx::cache_key_t LibraryHashDAO::getDirectoryHash(const QString& dirPath) {
     return hash;
 }
 
-void LibraryHashDAO::saveDirectoryHash(const QString& dirPath, mixxx::cache_key_t hash) {
+void LibraryHashDAO::saveDirectoryHash(const QString& dirPath,
+        mixxx::cache_key_t hash,
+        const QDateTime& modifiedAt) {
     //qDebug() << "LibraryHashDAO::saveDirectoryHash" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
-    query.prepare("INSERT INTO LibraryHashes (directory_path, hash, directory_deleted) "
-                    "VALUES (:directory_path, :hash, :directory_deleted)");
+    query.prepare(
+            "INSERT INTO LibraryHashes "
+            "(directory_path, hash, directory_deleted, modified_ms) "
+            "VALUES (:directory_path, :hash, :directory_deleted, :modified_ms)");
     query.bindValue(":directory_path", dirPath);
     query.bindValue(":hash", dbHash(hash));
     query.bindValue(":directory_deleted", 0);
+    query.bindValue(":modified_ms", dbModifiedTime(modifiedAt));
 
     if (!query.exec()) {
         LOG_FAILED_QUERY(query) << "Creating new dirhash failed.";
@@ -78,18 +112,20 @@ void LibraryHashDAO::saveDirectoryHash(const QString& dirPath, mixxx::cache_key_
 }
 
 void LibraryHashDAO::updateDirectoryHash(const QString& dirPath,
-                                         mixxx::cache_key_t newHash,
-                                         int dir_deleted) {
+        mixxx::cache_key_t newHash,
+        int dir_deleted,
+        const QDateTime& modifiedAt) {
     //qDebug() << "LibraryHashDAO::updateDirectoryHash" << QThread::currentThread() << m_database.connectionName();
     QSqlQuery query(m_database);
     // By definition if we have calculated a new hash for a directory then it
     // exists and no longer needs verification.
     query.prepare("UPDATE LibraryHashes "
             "SET hash=:hash, directory_deleted=:directory_deleted, "
-            "needs_verification=0 "
+            "needs_verification=0, modified_ms=:modified_ms "
             "WHERE directory_path=:directory_path");
     query.bindValue(":hash", dbHash(newHash));
     query.bindValue(":directory_deleted", dir_deleted);
+    query.bindValue(":modified_ms", dbModifiedTime(modifiedAt));
     query.bindValue(":directory_path", dirPath);
 
     if (!query.exec()) {
@@ -101,6 +137,19 @@ void LibraryHashDAO::updateDirectoryHash(const QString& dirPath,
     //qDebug() << getDirectoryHash(dirPath);
 }
 
+void LibraryHashDAO::updateDirectoryModifiedTime(const QString& dirPath,
+        const QDateTime& modifiedAt) {
+    QSqlQuery query(m_database);
+    query.prepare("UPDATE LibraryHashes "
+                  "SET modified_ms=:modified_ms "
+                  "WHERE directory_path=:directory_path");
+    query.bindValue(":modified_ms", dbModifiedTime(modifiedAt));
+    query.bindValue(":directory_path", dirPath);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "Updating directory modification time failed.";
+    }
+}
+
 void LibraryHashDAO::updateDirectoryStatuses(const QStringList& dirPaths,
                                              const bool deleted,
                                              const bool verified) {
@@ -1,7 +1,8 @@
 #pragma once
 
-#include <QObject>
+#include <QDateTime>
 #include <QHash>
+#include <QObject>
 #include <QString>
 
 #include "library/dao/dao.h"
@@ -12,10 +13,20 @@ class LibraryHashDAO : public DAO {
     ~LibraryHashDAO() override = default;
 
     QHash<QString, mixxx::cache_key_t> getDirectoryHashes();
+    /// Returns the modification times of all directories with a hash that
+    /// have been recorded when the directory was last listed. Directories
+    /// without a recorded modification time are omitted.
+    QHash<QString, QDateTime> getDirectoryModifiedTimes();
     mixxx::cache_key_t getDirectoryHash(const QString& dirPath);
-    void saveDirectoryHash(const QString& dirPath, mixxx::cache_key_t hash);
-    void updateDirectoryHash(const QString& dirPath, mixxx::cache_key_t newHash,
-                             int dir_deleted);
+    void saveDirectoryHash(const QString& dirPath,
+            mixxx::cache_key_t hash,
+            const QDateTime& modifiedAt = QDateTime());
+    void updateDirectoryHash(const QString& dirPath,
+            mixxx::cache_key_t newHash,
+            int dir_deleted,
+            const QDateTime& modifiedAt = QDateTime());
+    void updateDirectoryModifiedTime(const QString& dirPath,
+            const QDateTime& modifiedAt);
     void markAsExisting(const QString& dirPath);
     void invalidateAllDirectories();
     void markUnverifiedDirectoriesAsDeleted();
@@ -45,6 +45,10 @@ mixxx::Logger kLogger("TrackDAO");
 
 enum { UndefinedRecordIndex = -2 };
 
+// Bounds the length of statements with a list of track ids and the
+// number of their bound parameters
+constexpr int kMaxTrackIdsPerQuery = 200;
+
 void markTrackLocationsAsDeleted(const QSqlDatabase& database, const QString& directory) {
     // kLogger.debug()<< "markTrackLocationsAsDeleted" <<
     // QThread::currentThread() << m_database.connectionName();
@@ -86,6 +90,16 @@ QSet<QString> collectTrackLocations(FwdSqlQuery& query) {
     return locations;
 }
 
+/// Cue points are bound to the track object and the thread that has
+/// imported them. Temporary tracks with cue points or pending imports
+/// could not be adopted and their metadata needs to be imported again.
+bool canAdoptPreparedTrack(const Track& preparedTrack) {
+    return preparedTrack.checkSourceSynchronized() &&
+            preparedTrack.getBeatsImportStatus() == Track::ImportStatus::Complete &&
+            preparedTrack.getCueImportStatus() == Track::ImportStatus::Complete &&
+            preparedTrack.getCuePoints().isEmpty();
+}
+
 } // anonymous namespace
 
 TrackDAO::TrackDAO(CueDAO& cueDao,
@@ -329,6 +343,50 @@ QSet<QString> TrackDAO::getAllMissingTrackLocations() const {
     return collectTrackLocations(query);
 }
 
+QHash<TrackId, double> TrackDAO::getTrackDurationsSeconds(
+        const QSet<TrackId>& trackIds) const {
+    if (trackIds.isEmpty()) {
+        return {};
+    }
+    const QList<TrackId> trackIdList = trackIds.values();
+    QHash<TrackId, double> durations;
+    durations.reserve(trackIdList.size());
+    // The query is prepared again only for the last, smaller chunk
+    FwdSqlQuery query;
+    int placeholderCount = 0;
+    for (int first = 0; first < trackIdList.size(); first += kMaxTrackIdsPerQuery) {
+        const int count = math_min(
+                kMaxTrackIdsPerQuery, static_cast<int>(trackIdList.size()) - first);
+        if (count != placeholderCount) {
+            QStringList placeholders;
+            placeholders.reserve(count);
+            for (int i = 0; i < count; ++i) {
+                placeholders.append(QStringLiteral(":id%1").arg(i));
+            }
+            query = FwdSqlQuery(m_database,
+                    QStringLiteral("SELECT id,duration FROM library "
+                                   "WHERE duration>0 AND id IN (%1)")
+                            .arg(placeholders.join(QChar(','))));
+            placeholderCount = count;
+        }
+        for (int i = 0; i < count; ++i) {
+            query.bindValue(QStringLiteral(":id%1").arg(i), trackIdList[first + i]);
+        }
+        VERIFY_OR_DEBUG_ASSERT(!query.hasError() && query.execPrepared()) {
+            LOG_FAILED_QUERY(query);
+            return {};
+        }
+        const int idColumn = query.record().indexOf(LIBRARYTABLE_ID);
+        const int durationColumn = query.record().indexOf(LIBRARYTABLE_DURATION);
+        while (query.next()) {
+            durations.insert(
+                    TrackId(query.fieldValue(idColumn)),
+                    query.fieldValue(durationColumn).toDouble());
+        }
+    }
+    return durations;
+}
+
 // Some code (eg. drag and drop) needs to just get a track's location, and it's
 // not worth retrieving a whole Track.
 QString TrackDAO::getTrackLocation(TrackId trackId) const {
@@ -872,7 +930,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const QString& filePath,
-        bool unremove) {
+        bool unremove,
+        const TrackPointer& pPreparedTrack) {
     const auto fileAccess = mixxx::FileAccess(mixxx::FileInfo(filePath));
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
@@ -936,11 +995,20 @@ TrackPointer TrackDAO::addTracksAddFile(
     // Keep the GlobalTrackCache locked until the id of the Track
     // object is known and has been updated in the cache.
 
-    // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource(
-            SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+    if (cacheResolver.getLookupResult() == GlobalTrackCacheLookupResult::Miss &&
+            pPreparedTrack && canAdoptPreparedTrack(*pPreparedTrack)) {
+        // The metadata has already been imported from the file into a
+        // temporary track object by a worker thread.
+        pTrack->replaceRecord(
+                pPreparedTrack->getRecord(),
+                pPreparedTrack->getBeats());
+    } else {
+        // Initially (re-)import the metadata for the newly created track
+        // from the file.
+        SoundSourceProxy(pTrack).updateTrackFromSource(
+                SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+    }
     if (!pTrack->checkSourceSynchronized()) {
         kLogger.warning() << "addTracksAddFile:"
                           << "Failed to parse track metadata from file"
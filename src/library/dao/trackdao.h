@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QSet>
@@ -68,6 +69,9 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     // Return all tracks reported missing during last scan.
     QSet<QString> getAllMissingTrackLocations() const;
     QString getTrackLocation(TrackId trackId) const;
+    // Returns the durations of the given tracks in seconds. Tracks
+    // with an unknown duration are omitted.
+    QHash<TrackId, double> getTrackDurationsSeconds(const QSet<TrackId>& trackIds) const;
 
     // Only used by friend class LibraryScanner, but public for testing!
     bool detectMovedTracks(
@@ -159,9 +163,12 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// The metadata of new tracks is imported from the file, unless it has
+    /// already been imported into the optional, temporary track object.
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove);
+            bool unremove,
+            const TrackPointer& pPreparedTrack = nullptr);
     void addTracksFinish(bool rollback = false);
 
     bool updateTrack(const Track& track) const;
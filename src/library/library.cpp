@@ -289,6 +289,14 @@ class TrackAnalysisSchedulerEnvironmentImpl final : public TrackAnalysisSchedule
         return m_pLibrary->trackCollectionManager()->getTrackById(trackId);
     }
 
+    QHash<TrackId, double> loadTrackDurationsSeconds(
+            const QSet<TrackId>& trackIds) const final {
+        return m_pLibrary->trackCollectionManager()
+                ->internalCollection()
+                ->getTrackDAO()
+                .getTrackDurationsSeconds(trackIds);
+    }
+
   private:
     // TODO: Use std::shared_ptr or std::weak_ptr instead of a plain pointer?
     const Library* const m_pLibrary;
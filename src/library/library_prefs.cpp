@@ -23,6 +23,26 @@ const ConfigKey mixxx::library::prefs::kShowScanSummaryConfigKey =
                 mixxx::library::prefs::kConfigGroup,
                 QStringLiteral("show_library_scan_summary")};
 
+const ConfigKey mixxx::library::prefs::kScannerThreadCountConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("scanner_thread_count")};
+
+const ConfigKey mixxx::library::prefs::kIncrementalRescanConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("incremental_rescan")};
+
+const ConfigKey mixxx::library::prefs::kColumnarSearchIndexConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("columnar_search_index")};
+
+const ConfigKey mixxx::library::prefs::kFullTextSearchConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("full_text_search")};
+
 const ConfigKey mixxx::library::prefs::kKeyNotationConfigKey =
         ConfigKey{
                 mixxx::library::prefs::kConfigGroup,
@@ -16,6 +16,22 @@ extern const ConfigKey kRescanOnStartupConfigKey;
 
 extern const ConfigKey kShowScanSummaryConfigKey;
 
+extern const ConfigKey kScannerThreadCountConfigKey;
+
+const int kScannerThreadCountDefault = 1;
+
+extern const ConfigKey kIncrementalRescanConfigKey;
+
+const bool kIncrementalRescanDefault = false;
+
+extern const ConfigKey kColumnarSearchIndexConfigKey;
+
+const bool kColumnarSearchIndexDefault = false;
+
+extern const ConfigKey kFullTextSearchConfigKey;
+
+const bool kFullTextSearchDefault = false;
+
 extern const ConfigKey kKeyNotationConfigKey;
 
 extern const ConfigKey kTrackDoubleClickActionConfigKey;
@@ -8,6 +8,7 @@
 #include "library/basetrackcache.h"
 #include "library/dao/trackschema.h"
 #include "library/library.h"
+#include "library/library_prefs.h"
 #include "library/librarytablemodel.h"
 #include "library/missing_hidden/dlghidden.h"
 #include "library/missing_hidden/dlgmissing.h"
@@ -111,6 +112,11 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
             std::move(columns),
             std::move(searchColumns),
             true);
+    pBaseTrackCache->setColumnarIndexEnabled(m_pConfig->getValue(
+            mixxx::library::prefs::kColumnarSearchIndexConfigKey,
+            mixxx::library::prefs::kColumnarSearchIndexDefault));
+    // Falls back to LIKE clauses if the index is disabled or unavailable
+    pBaseTrackCache->setFullTextSearchEnabled(true);
     m_pBaseTrackCache = QSharedPointer<BaseTrackCache>(pBaseTrackCache);
     m_pTrackCollection->connectTrackSource(m_pBaseTrackCache);
 
@@ -1,6 +1,8 @@
 #include "library/scanner/importfilestask.h"
 
 #include "moc_importfilestask.cpp"
+#include "sources/soundsourceproxy.h"
+#include "track/track.h"
 #include "util/timer.h"
 
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
@@ -8,6 +10,7 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
         const QString& dirPath,
         const bool prevHashExists,
         const mixxx::cache_key_t newHash,
+        const QDateTime& modifiedAt,
         const std::list<QFileInfo>& filesToImport,
         const std::list<QFileInfo>& possibleCovers,
         SecurityTokenPointer pToken)
@@ -15,6 +18,7 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
           m_dirPath(dirPath),
           m_prevHashExists(prevHashExists),
           m_newHash(newHash),
+          m_modifiedAt(modifiedAt),
           m_filesToImport(filesToImport),
           m_possibleCovers(possibleCovers),
           m_pToken(pToken) {
@@ -49,10 +53,23 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            TrackPointer pPreparedTrack;
+            const auto& workerImportParams = m_scannerGlobal->workerImportParams();
+            if (workerImportParams) {
+                // Parse the file tags here instead of on the scanner thread,
+                // which has to add all new tracks to the database one after
+                // another.
+                pPreparedTrack = Track::newTemporary(
+                        mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken));
+                SoundSourceProxy(pPreparedTrack)
+                        .updateTrackFromSource(
+                                SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                                *workerImportParams);
+            }
+            emit addNewTrack(trackLocation, pPreparedTrack);
         }
     }
     // Insert or update the hash in the database.
-    emit directoryHashedAndScanned(m_dirPath, !m_prevHashExists, m_newHash);
+    emit directoryHashedAndScanned(m_dirPath, !m_prevHashExists, m_newHash, m_modifiedAt);
     setSuccess(true);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDateTime>
 #include <QFileInfo>
 
 #include "util/sandbox.h"
@@ -15,6 +16,7 @@ class ImportFilesTask : public ScannerTask {
             const QString& dirPath,
             const bool prevHashExists,
             const mixxx::cache_key_t newHash,
+            const QDateTime& modifiedAt,
             const std::list<QFileInfo>& filesToImport,
             const std::list<QFileInfo>& possibleCovers,
             SecurityTokenPointer pToken);
@@ -30,6 +32,7 @@ class ImportFilesTask : public ScannerTask {
     const QString m_dirPath;
     const bool m_prevHashExists;
     const mixxx::cache_key_t m_newHash;
+    const QDateTime m_modifiedAt;
     const std::list<QFileInfo> m_filesToImport;
     const std::list<QFileInfo> m_possibleCovers;
     SecurityTokenPointer m_pToken;
@@ -1,7 +1,9 @@
 #include "library/scanner/libraryscanner.h"
 
 #include "library/coverartutils.h"
+#include "library/dao/fulltextsearchdao.h"
 #include "library/library_decl.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/importfilestask.h"
 #include "library/scanner/libraryscannerdlg.h"
@@ -15,15 +17,13 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
-
 mixxx::Logger kLogger("LibraryScanner");
 
 QAtomicInt s_instanceCounter(0);
@@ -99,7 +99,8 @@ void updateQueryPlannerStatisticsForDatabase(const QSqlDatabase& database) {
 LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
-        : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+        : m_pConfig(pConfig),
+          m_pDbConnectionPool(std::move(pDbConnectionPool)),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao, m_analysisDao, m_libraryHashDao, pConfig),
           m_stateSema(1), // only one transaction is possible at a time
@@ -115,7 +116,10 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    const int numWorkerThreads = m_pConfig->getValue(
+            mixxx::library::prefs::kScannerThreadCountConfigKey,
+            mixxx::library::prefs::kScannerThreadCountDefault);
+    m_pool.setMaxThreadCount(math_max(1, numWorkerThreads));
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -190,6 +194,9 @@ void LibraryScanner::slotStartScan() {
     DEBUG_ASSERT(m_state == STARTING);
 
     cleanUpDatabase(m_libraryHashDao.database());
+    // The tracks that are added or modified during the scan need to be
+    // indexed for searching
+    FullTextSearchDAO::attachConnection(m_libraryHashDao.database());
 
     // Recursively scan each directory in the directories table.
     m_libraryRootDirs = m_directoryDao.loadAllDirectories();
@@ -206,6 +213,14 @@ void LibraryScanner::slotStartScan() {
     // of missing tracks in slotFinishUnhashedScan().
     m_previouslyMissingTracks = m_trackDao.getAllMissingTrackLocations();
     QHash<QString, mixxx::cache_key_t> directoryHashes = m_libraryHashDao.getDirectoryHashes();
+    QHash<QString, QDateTime> directoryModifiedTimes =
+            m_libraryHashDao.getDirectoryModifiedTimes();
+    // Directories that have not been modified since they have last been
+    // listed are skipped when rescanning incrementally. Their sub-directories
+    // are then taken from the hashes instead of listing the directory.
+    const bool skipUnmodifiedDirectories = m_pConfig->getValue(
+            mixxx::library::prefs::kIncrementalRescanConfigKey,
+            mixxx::library::prefs::kIncrementalRescanDefault);
     QRegularExpression extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
     QRegularExpression coverExtensionFilter =
             QRegularExpression(CoverArtUtils::supportedCoverArtExtensionsRegex(),
@@ -213,9 +228,24 @@ void LibraryScanner::slotStartScan() {
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
     m_numRelocatedTracks = 0;
 
+    // With more than one worker thread the expensive parsing of file tags
+    // is done concurrently by the worker threads. The scanner thread then
+    // only writes the new tracks into the database within the single
+    // transaction that spans the whole scan.
+    std::optional<SyncTrackMetadataParams> workerImportParams;
+    if (m_pool.maxThreadCount() > 1) {
+        workerImportParams = SyncTrackMetadataParams::readFromUserSettings(*m_pConfig);
+    }
+
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+            new ScannerGlobal(trackLocations,
+                    directoryHashes,
+                    directoryModifiedTimes,
+                    skipUnmodifiedDirectories,
+                    extensionFilter,
+                    coverExtensionFilter,
+                    directoryBlacklist,
+                    std::move(workerImportParams)));
 
     m_scannerGlobal->startTimer();
 
@@ -595,7 +625,9 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
 }
 
 void LibraryScanner::slotDirectoryHashedAndScanned(const QString& directoryPath,
-                                               bool newDirectory, mixxx::cache_key_t hash) {
+        bool newDirectory,
+        mixxx::cache_key_t hash,
+        const QDateTime& modifiedAt) {
     ScopedTimer timer(QStringLiteral("LibraryScanner::slotDirectoryHashedAndScanned"));
     //kLogger.debug() << "sloDirectoryHashedAndScanned" << directoryPath
     //          << newDirectory << hash;
@@ -607,19 +639,25 @@ void LibraryScanner::slotDirectoryHashedAndScanned(const QString& directoryPath,
     }
 
     if (newDirectory) {
-        m_libraryHashDao.saveDirectoryHash(directoryPath, hash);
+        m_libraryHashDao.saveDirectoryHash(directoryPath, hash, modifiedAt);
     } else {
-        m_libraryHashDao.updateDirectoryHash(directoryPath, hash, 0);
+        m_libraryHashDao.updateDirectoryHash(directoryPath, hash, 0, modifiedAt);
     }
     emit progressHashing(directoryPath);
 }
 
-void LibraryScanner::slotDirectoryUnchanged(const QString& directoryPath) {
+void LibraryScanner::slotDirectoryUnchanged(const QString& directoryPath,
+        const QDateTime& modifiedAt) {
     ScopedTimer timer(QStringLiteral("LibraryScanner::slotDirectoryUnchanged"));
     //kLogger.debug() << "slotDirectoryUnchanged" << directoryPath;
     if (m_scannerGlobal) {
         m_scannerGlobal->addVerifiedDirectory(directoryPath);
     }
+    if (modifiedAt.isValid()) {
+        // The list of files is unchanged, but the directory has been
+        // modified otherwise since it has last been listed.
+        m_libraryHashDao.updateDirectoryModifiedTime(directoryPath, modifiedAt);
+    }
     emit progressHashing(directoryPath);
 }
 
@@ -632,7 +670,8 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
 }
 
 // triggered by ScannerTask::addNewTrack / in ImportFilesTask::run()
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
+void LibraryScanner::slotAddNewTrack(const QString& trackPath,
+        TrackPointer pPreparedTrack) {
     // kLogger.debug() << "slotAddNewTrack" << trackPath;
     if (!m_scannerGlobal || m_scannerGlobal->shouldCancel()) {
         // Fix/workaround for Cancel not cancelling the entire scan process
@@ -649,7 +688,8 @@ void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            pPreparedTrack);
     if (!pTrack) {
         // This happens only when there is an issue with the database which
         // has been logged already. No need for yet another warning here.
@@ -71,10 +71,12 @@ class LibraryScanner : public QThread {
 
     // ScannerTask signal handlers.
     void slotDirectoryHashedAndScanned(const QString& directoryPath,
-                                   bool newDirectory, mixxx::cache_key_t hash);
-    void slotDirectoryUnchanged(const QString& directoryPath);
+            bool newDirectory,
+            mixxx::cache_key_t hash,
+            const QDateTime& modifiedAt);
+    void slotDirectoryUnchanged(const QString& directoryPath, const QDateTime& modifiedAt);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotAddNewTrack(const QString& trackPath, TrackPointer pPreparedTrack);
 
   private:
     enum ScannerState {
@@ -100,6 +102,8 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    const UserSettingsPointer m_pConfig;
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     // The pool of threads used for worker tasks.
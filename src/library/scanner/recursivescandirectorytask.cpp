@@ -30,6 +30,27 @@ void RecursiveScanDirectoryTask::run() {
     //qDebug() << "Burn CPU";
     //for (int i = 0;i < 1000000000; i++) asm("nop");
 
+    const QString dirLocation = m_dirAccess.info().location();
+
+    // Read the modification time before listing the directory. Files that
+    // are added or removed while listing will then be detected by the next
+    // scan.
+    const QDateTime modifiedAt = m_dirAccess.info().lastModified();
+    const QDateTime prevModifiedAt =
+            m_scannerGlobal->directoryModifiedTimeInDatabase(dirLocation);
+    if (!m_scanUnhashed &&
+            m_scannerGlobal->skipUnmodifiedDirectories() &&
+            modifiedAt.isValid() &&
+            modifiedAt == prevModifiedAt) {
+        // Adding, removing, or renaming files or sub-directories updates the
+        // modification time of the directory. Neither the hash of the list of
+        // files nor the list of sub-directories can have changed.
+        emit directoryUnchanged(dirLocation, QDateTime());
+        scanSubdirectories(m_scannerGlobal->knownSubdirectories(dirLocation));
+        setSuccess(true);
+        return;
+    }
+
     // Note, we save on filesystem operations (and random work) by initializing
     // a QDirIterator with a QDir instead of a QString -- but it inherits its
     // Filter from the QDir so we have to set it first. If the QDir has not done
@@ -84,8 +105,6 @@ void RecursiveScanDirectoryTask::run() {
     // Calculate a hash of the directory's file list.
     const mixxx::cache_key_t newHash = mixxx::cacheKeyFromMessageDigest(hasher.result());
 
-    QString dirLocation = m_dirAccess.info().location();
-
     // Try to retrieve a hash from the last time that directory was scanned.
     const mixxx::cache_key_t prevHash = m_scannerGlobal->directoryHashInDatabase(dirLocation);
     const bool prevHashExists = mixxx::isValidCacheKey(prevHash);
@@ -102,14 +121,17 @@ void RecursiveScanDirectoryTask::run() {
                         dirLocation,
                         prevHashExists,
                         newHash,
+                        modifiedAt,
                         filesToImport,
                         possibleCovers,
                         m_dirAccess.token()));
             } else {
-                emit directoryHashedAndScanned(dirLocation, !prevHashExists, newHash);
+                emit directoryHashedAndScanned(
+                        dirLocation, !prevHashExists, newHash, modifiedAt);
             }
         } else {
-            emit directoryUnchanged(dirLocation);
+            emit directoryUnchanged(dirLocation,
+                    modifiedAt != prevModifiedAt ? modifiedAt : QDateTime());
         }
     } else {
         m_scannerGlobal->addUnhashedDir(m_dirAccess);
@@ -117,17 +139,39 @@ void RecursiveScanDirectoryTask::run() {
 
     // Process all of the sub-directories.
     for (const mixxx::FileInfo& dirInfo : dirsToScan) {
-        // Atomically test and mark the directory as scanned to avoid
-        // that the same directory is scanned multiple times by different
-        // tasks.
-        if (!m_scannerGlobal->testAndMarkDirectoryScanned(dirInfo.toQDir())) {
-            m_pScanner->queueTask(
-                    new RecursiveScanDirectoryTask(
-                            m_pScanner,
-                            m_scannerGlobal,
-                            mixxx::FileAccess(dirInfo, m_dirAccess.token()),
-                            m_scanUnhashed));
-        }
+        scanSubdirectory(dirInfo);
     }
     setSuccess(true);
 }
+
+void RecursiveScanDirectoryTask::scanSubdirectories(const QStringList& dirLocations) {
+    for (const QString& dirLocation : dirLocations) {
+        // The sub-directory might have been recorded before it has been
+        // blacklisted. Check it like the listed sub-directories.
+        if (m_scannerGlobal->directoryBlacklisted(dirLocation)) {
+            continue;
+        }
+        const auto dirInfo = mixxx::FileInfo(dirLocation);
+        // The sub-directory might have been deleted since the last scan
+        // without updating the modification time of its parent, e.g. on
+        // network shares. It will be marked as deleted after the scan.
+        if (!dirInfo.isDir()) {
+            continue;
+        }
+        scanSubdirectory(dirInfo);
+    }
+}
+
+void RecursiveScanDirectoryTask::scanSubdirectory(const mixxx::FileInfo& dirInfo) {
+    // Atomically test and mark the directory as scanned to avoid
+    // that the same directory is scanned multiple times by different
+    // tasks.
+    if (!m_scannerGlobal->testAndMarkDirectoryScanned(dirInfo.toQDir())) {
+        m_pScanner->queueTask(
+                new RecursiveScanDirectoryTask(
+                        m_pScanner,
+                        m_scannerGlobal,
+                        mixxx::FileAccess(dirInfo, m_dirAccess.token()),
+                        m_scanUnhashed));
+    }
+}
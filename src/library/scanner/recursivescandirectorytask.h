@@ -6,8 +6,10 @@
 /// Recursively scan a music library. Doesn't import tracks for any directories
 /// that have already been scanned and have not changed. Changes are tracked by
 /// performing a hash of the directory's file list, and those hashes are stored
-/// in the database. Successful if the scan completed without being
-/// cancelled. False if the scan was cancelled part-way through.
+/// in the database. When rescanning incrementally, directories that have not
+/// been modified since they have last been listed are not listed again.
+/// Successful if the scan completed without being cancelled. False if the scan
+/// was cancelled part-way through.
 class RecursiveScanDirectoryTask : public ScannerTask {
     Q_OBJECT
   public:
@@ -20,6 +22,9 @@ class RecursiveScanDirectoryTask : public ScannerTask {
     void run() override;
 
   private:
+    void scanSubdirectories(const QStringList& dirLocations);
+    void scanSubdirectory(const mixxx::FileInfo& dirInfo);
+
     const mixxx::FileAccess m_dirAccess;
     const bool m_scanUnhashed;
 };
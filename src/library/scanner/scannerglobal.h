@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDateTime>
 #include <QDir>
 #include <QHash>
 #include <QMutex>
@@ -7,7 +8,9 @@
 #include <QSet>
 #include <QSharedPointer>
 #include <QStringList>
+#include <optional>
 
+#include "track/track_decl.h"
 #include "util/cache.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
@@ -18,19 +21,37 @@ class ScannerGlobal {
   public:
     ScannerGlobal(const QSet<QString>& trackLocations,
             const QHash<QString, mixxx::cache_key_t>& directoryHashes,
+            const QHash<QString, QDateTime>& directoryModifiedTimes,
+            bool skipUnmodifiedDirectories,
             const QRegularExpression& supportedExtensionsMatcher,
             const QRegularExpression& supportedCoverExtensionsMatcher,
-            const QStringList& directoriesBlacklist)
+            const QStringList& directoriesBlacklist,
+            std::optional<SyncTrackMetadataParams> workerImportParams = std::nullopt)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
+              m_directoryModifiedTimes(directoryModifiedTimes),
+              m_skipUnmodifiedDirectories(skipUnmodifiedDirectories),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_workerImportParams(std::move(workerImportParams)),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
               m_numScannedDirectories(0),
               m_numRelocatedTracks(0) {
+        if (m_skipUnmodifiedDirectories) {
+            for (auto it = m_directoryHashes.constBegin();
+                    it != m_directoryHashes.constEnd();
+                    ++it) {
+                const QString& directoryPath = it.key();
+                const int separatorIndex = directoryPath.lastIndexOf(QChar('/'));
+                if (separatorIndex > 0) {
+                    m_knownSubdirectories[directoryPath.left(separatorIndex)]
+                            .append(directoryPath);
+                }
+            }
+        }
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -47,6 +68,31 @@ class ScannerGlobal {
         return m_directoryHashes.value(directoryPath, mixxx::invalidCacheKey());
     }
 
+    /// Returns the parameters for importing the metadata of new tracks on
+    /// the worker threads, or std::nullopt if the metadata is imported on
+    /// the scanner thread while adding the track to the database.
+    const std::optional<SyncTrackMetadataParams>& workerImportParams() const {
+        return m_workerImportParams;
+    }
+
+    /// Returns the modification time of the directory that has been recorded
+    /// when it was last listed, or an invalid QDateTime if unknown.
+    QDateTime directoryModifiedTimeInDatabase(const QString& directoryPath) const {
+        return m_directoryModifiedTimes.value(directoryPath);
+    }
+
+    /// Directories that have not been modified since they have last been
+    /// listed don't need to be listed again.
+    bool skipUnmodifiedDirectories() const {
+        return m_skipUnmodifiedDirectories;
+    }
+
+    /// Returns the sub-directories of a directory that have been hashed by
+    /// a previous scan. Only available when skipping unmodified directories.
+    QStringList knownSubdirectories(const QString& directoryPath) const {
+        return m_knownSubdirectories.value(directoryPath);
+    }
+
     bool directoryBlacklisted(const QString& directoryPath) const {
         return m_directoriesBlacklist.contains(directoryPath);
     }
@@ -166,6 +212,9 @@ class ScannerGlobal {
 
     QSet<QString> m_trackLocations;
     QHash<QString, mixxx::cache_key_t> m_directoryHashes;
+    QHash<QString, QDateTime> m_directoryModifiedTimes;
+    const bool m_skipUnmodifiedDirectories;
+    QHash<QString, QStringList> m_knownSubdirectories;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
     QRegularExpression m_supportedExtensionsMatcher;
@@ -190,6 +239,8 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const std::optional<SyncTrackMetadataParams> m_workerImportParams;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
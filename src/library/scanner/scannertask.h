@@ -4,6 +4,7 @@
 #include <QRunnable>
 
 #include "library/scanner/scannerglobal.h"
+#include "track/track_decl.h"
 
 class LibraryScanner;
 
@@ -20,10 +21,16 @@ class ScannerTask : public QObject, public QRunnable {
     void taskDone(bool success);
     void queueTask(ScannerTask* pTask);
     void directoryHashedAndScanned(const QString& directoryPath,
-                                   bool newDirectory, mixxx::cache_key_t hash);
-    void directoryUnchanged(const QString& directoryPath);
+            bool newDirectory,
+            mixxx::cache_key_t hash,
+            const QDateTime& modifiedAt);
+    /// The modification time is invalid if it has not changed since the
+    /// last scan.
+    void directoryUnchanged(const QString& directoryPath, const QDateTime& modifiedAt);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    /// The optional track object is a temporary track with the metadata
+    /// that has already been imported from the file on a worker thread.
+    void addNewTrack(const QString& filePath, TrackPointer pPreparedTrack);
 
   protected:
     void setSuccess(bool success) {
@@ -3,12 +3,15 @@
 #include <QLocale>
 #include <QRegularExpression>
 
+#include "library/dao/fulltextsearchdao.h"
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
 #include "library/trackset/crate/crateschema.h"
 #include "library/trackset/crate/cratestorage.h" // for CrateTrackSelectResult
+#include "track/beats.h"
 #include "track/keyutils.h"
 #include "track/track.h"
+#include "util/datetime.h"
 #include "util/db/dbconnection.h"
 #include "util/db/sqllikewildcards.h"
 
@@ -80,6 +83,12 @@ QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& colum
         return static_cast<int>(pTrack->getKey());
     } else if (column == LIBRARYTABLE_BPM_LOCK) {
         return pTrack->isBpmLocked();
+    } else if (column == LIBRARYTABLE_BEATS_VERSION) {
+        const auto pBeats = pTrack->getBeats();
+        if (!pBeats) {
+            return QVariant();
+        }
+        return pBeats->getVersion();
     } else if (column == LIBRARYTABLE_ID) {
         return pTrack->getId().toVariant();
     }
@@ -87,6 +96,26 @@ QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& colum
     return QVariant();
 }
 
+/// Provides the current, possibly modified values of a loaded track
+class TrackPointerRecord : public TrackRecord {
+  public:
+    explicit TrackPointerRecord(const TrackPointer& pTrack)
+            : m_pTrack(pTrack) {
+        DEBUG_ASSERT(m_pTrack);
+    }
+
+    TrackId getId() const override {
+        return m_pTrack->getId();
+    }
+
+    QVariant getValue(const QString& column) const override {
+        return getTrackValueForColumn(m_pTrack, column);
+    }
+
+  private:
+    const TrackPointer& m_pTrack;
+};
+
 QString concatSqlClauses(
         const QStringList& sqlClauses, const QString& sqlConcatOp) {
     switch (sqlClauses.size()) {
@@ -107,9 +136,32 @@ QString concatSqlClauses(
 
 } // namespace
 
-bool AndNode::match(const TrackPointer& pTrack) const {
+std::optional<QString> TrackRecord::getLatinLowText(const QString& column) const {
+    const QVariant value = getValue(column);
+    if (!value.isValid() || !value.canConvert<QString>()) {
+        return std::nullopt;
+    }
+    QString text = value.toString();
+    mixxx::DbConnection::makeStringLatinLow(&text);
+    return text;
+}
+
+bool QueryNode::match(const TrackPointer& pTrack) const {
+    return match(TrackPointerRecord(pTrack));
+}
+
+bool GroupNode::prepareRecordMatching() const {
     for (const auto& pNode : m_nodes) {
-        if (!pNode->match(pTrack)) {
+        if (!pNode->prepareRecordMatching()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AndNode::match(const TrackRecord& record) const {
+    for (const auto& pNode : m_nodes) {
+        if (!pNode->match(record)) {
             return false;
         }
     }
@@ -130,9 +182,9 @@ QString AndNode::toSql() const {
     return concatSqlClauses(queryFragments, "AND");
 }
 
-bool OrNode::match(const TrackPointer& pTrack) const {
+bool OrNode::match(const TrackRecord& record) const {
     for (const auto& pNode : m_nodes) {
-        if (pNode->match(pTrack)) {
+        if (pNode->match(record)) {
             return true;
         }
     }
@@ -154,8 +206,8 @@ QString OrNode::toSql() const {
     return concatSqlClauses(queryFragments, "OR");
 }
 
-bool NotNode::match(const TrackPointer& pTrack) const {
-    return !m_pNode->match(pTrack);
+bool NotNode::match(const TrackRecord& record) const {
+    return !m_pNode->match(record);
 }
 
 QString NotNode::toSql() const {
@@ -173,29 +225,29 @@ QString NotNode::toSql() const {
 TextFilterNode::TextFilterNode(const QSqlDatabase& database,
         const QStringList& sqlColumns,
         const QString& argument,
-        const StringMatch matchMode)
+        const StringMatch matchMode,
+        const FullTextSearchDAO* pFullTextSearch)
         : m_database(database),
           m_sqlColumns(sqlColumns),
           m_argument(argument),
-          m_matchMode(matchMode) {
+          m_matchMode(matchMode),
+          m_pFullTextSearch(pFullTextSearch) {
     mixxx::DbConnection::makeStringLatinLow(&m_argument);
 }
 
-bool TextFilterNode::match(const TrackPointer& pTrack) const {
+bool TextFilterNode::match(const TrackRecord& record) const {
     for (const auto& sqlColumn : m_sqlColumns) {
-        QVariant value = getTrackValueForColumn(pTrack, sqlColumn);
-        if (!value.isValid() || !value.canConvert<QString>()) {
+        const std::optional<QString> strValue = record.getLatinLowText(sqlColumn);
+        if (!strValue) {
             continue;
         }
 
-        QString strValue = value.toString();
-        mixxx::DbConnection::makeStringLatinLow(&strValue);
         if (m_matchMode == StringMatch::Equals) {
-            if (strValue == m_argument) {
+            if (*strValue == m_argument) {
                 return true;
             }
         } else {
-            if (strValue.contains(m_argument)) {
+            if (strValue->contains(m_argument)) {
                 return true;
             }
         }
@@ -228,13 +280,23 @@ QString TextFilterNode::toSql() const {
     for (const auto& sqlColumn : m_sqlColumns) {
         searchClauses << QString("%1 IS NOT NULL AND %1 LIKE %2").arg(sqlColumn, escapedArgument);
     }
-    return concatSqlClauses(searchClauses, "OR");
+    const QString sql = concatSqlClauses(searchClauses, "OR");
+    if (m_pFullTextSearch) {
+        // The index only selects the candidates and avoids a full table
+        // scan. The LIKE clauses still decide which tracks match exactly.
+        const QString fullTextSearchSql = m_pFullTextSearch->selectTrackIdsSql(
+                LIBRARYTABLE_ID, m_sqlColumns, m_argument);
+        if (!fullTextSearchSql.isEmpty()) {
+            return concatSqlClauses({fullTextSearchSql, sql}, "AND");
+        }
+    }
+    return sql;
 }
 
-bool NullOrEmptyTextFilterNode::match(const TrackPointer& pTrack) const {
+bool NullOrEmptyTextFilterNode::match(const TrackRecord& record) const {
     if (!m_sqlColumns.isEmpty()) {
         // only use the major column
-        QVariant value = getTrackValueForColumn(pTrack, m_sqlColumns.first());
+        QVariant value = record.getValue(m_sqlColumns.first());
         if (!value.isValid() || !value.canConvert<QString>()) {
             return true;
         }
@@ -258,7 +320,7 @@ CrateFilterNode::CrateFilterNode(const CrateStorage* pCrateStorage,
           m_matchInitialized(false) {
 }
 
-bool CrateFilterNode::match(const TrackPointer& pTrack) const {
+bool CrateFilterNode::prepareRecordMatching() const {
     if (!m_matchInitialized) {
         CrateTrackSelectResult crateTracks(
                 m_pCrateStorage->selectTracksSortedByCrateNameLike(m_crateNameLike));
@@ -269,8 +331,12 @@ bool CrateFilterNode::match(const TrackPointer& pTrack) const {
 
         m_matchInitialized = true;
     }
+    return true;
+}
 
-    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+bool CrateFilterNode::match(const TrackRecord& record) const {
+    prepareRecordMatching();
+    return std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), record.getId());
 }
 
 QString CrateFilterNode::toSql() const {
@@ -284,7 +350,7 @@ NoCrateFilterNode::NoCrateFilterNode(const CrateStorage* pCrateStorage)
           m_matchInitialized(false) {
 }
 
-bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
+bool NoCrateFilterNode::prepareRecordMatching() const {
     if (!m_matchInitialized) {
         TrackSelectResult tracks(
                 m_pCrateStorage->selectAllTracksSorted());
@@ -295,8 +361,12 @@ bool NoCrateFilterNode::match(const TrackPointer& pTrack) const {
 
         m_matchInitialized = true;
     }
+    return true;
+}
 
-    return !std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), pTrack->getId());
+bool NoCrateFilterNode::match(const TrackRecord& record) const {
+    prepareRecordMatching();
+    return !std::binary_search(m_matchingTrackIds.begin(), m_matchingTrackIds.end(), record.getId());
 }
 
 QString NoCrateFilterNode::toSql() const {
@@ -358,9 +428,9 @@ double NumericFilterNode::parse(const QString& arg, bool* ok) {
     return arg.toDouble(ok);
 }
 
-bool NumericFilterNode::match(const TrackPointer& pTrack) const {
+bool NumericFilterNode::match(const TrackRecord& record) const {
     for (const auto& sqlColumn : m_sqlColumns) {
-        QVariant value = getTrackValueForColumn(pTrack, sqlColumn);
+        QVariant value = record.getValue(sqlColumn);
         if (!value.isValid() || !value.canConvert<double>()) {
             if (m_bNullQuery) {
                 return true;
@@ -424,10 +494,10 @@ NullNumericFilterNode::NullNumericFilterNode(const QStringList& sqlColumns)
         : m_sqlColumns(sqlColumns) {
 }
 
-bool NullNumericFilterNode::match(const TrackPointer& pTrack) const {
+bool NullNumericFilterNode::match(const TrackRecord& record) const {
     if (!m_sqlColumns.isEmpty()) {
         // only use the major column
-        QVariant value = getTrackValueForColumn(pTrack, m_sqlColumns.first());
+        QVariant value = record.getValue(m_sqlColumns.first());
         if (!value.isValid() || !value.canConvert<double>()) {
             return true;
         }
@@ -711,16 +781,19 @@ BpmFilterNode::BpmFilterNode(
     }
 }
 
-bool BpmFilterNode::match(const TrackPointer& pTrack) const {
+bool BpmFilterNode::match(const TrackRecord& record) const {
     if (m_matchMode == MatchMode::Locked) {
-        return pTrack->isBpmLocked();
+        return record.getValue(LIBRARYTABLE_BPM_LOCK).toBool();
     }
 
     if (m_matchMode == MatchMode::Constant) {
-        return pTrack->getBeats()->hasConstantTempo();
+        // Same as in toSql(), see there
+        return record.getValue(LIBRARYTABLE_BEATS_VERSION)
+                .toString()
+                .contains(QLatin1String("BeatGrid"));
     }
 
-    double value = pTrack->getBpm();
+    double value = record.getValue(LIBRARYTABLE_BPM).toDouble();
 
     switch (m_matchMode) {
     case MatchMode::Null: {
@@ -816,8 +889,13 @@ KeyFilterNode::KeyFilterNode(mixxx::track::io::key::ChromaticKey key,
     }
 }
 
-bool KeyFilterNode::match(const TrackPointer& pTrack) const {
-    return m_matchKeys.contains(pTrack->getKey());
+bool KeyFilterNode::match(const TrackRecord& record) const {
+    const QVariant keyId = record.getValue(LIBRARYTABLE_KEY_ID);
+    if (keyId.isNull()) {
+        return false;
+    }
+    return m_matchKeys.contains(
+            static_cast<mixxx::track::io::key::ChromaticKey>(keyId.toInt()));
 }
 
 QString KeyFilterNode::toSql() const {
@@ -930,13 +1008,21 @@ QString DateAddedFilterNode::dateStringIsoNoZ(const QDateTime& date) const {
     return dateStr;
 }
 
-bool DateAddedFilterNode::match(const TrackPointer& pTrack) const {
+bool DateAddedFilterNode::match(const TrackRecord& record) const {
     if (!m_operatorQuery && !m_equalsQuery) {
         // invalid query, don't filter
         return true;
     }
 
-    QDateTime trackDate = pTrack->getDateAdded();
+    const QVariant value = record.getValue(LIBRARYTABLE_DATETIMEADDED);
+    if (!value.isValid()) {
+        return true;
+    }
+    // The database stores UTC without a time zone, i.e. the text of the
+    // index and the date of a loaded track must be interpreted as UTC
+    // like in toSql().
+    const QDateTime trackDate = mixxx::localDateTimeFromUtc(
+            mixxx::convertVariantToDateTime(value));
     if (!trackDate.isValid()) {
         return true;
     }
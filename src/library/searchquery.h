@@ -6,16 +6,19 @@
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
+#include <QVariant>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "proto/keys.pb.h"
 #include "track/track_decl.h"
+#include "track/trackid.h"
 #include "util/assert.h"
 
 class CrateStorage;
-class TrackId;
+class FullTextSearchDAO;
 
 const QString kMissingFieldSearchTerm = "\"\""; // "" searches for an empty string
 
@@ -24,12 +27,43 @@ enum class StringMatch {
     Equals,
 };
 
+/// The column values of a single track, i.e. a row of the library table.
+///
+/// Queries are evaluated on these values, either read from a loaded track
+/// or from a cached row that doesn't require to load the track.
+class TrackRecord {
+  public:
+    virtual ~TrackRecord() = default;
+
+    virtual TrackId getId() const = 0;
+
+    /// Returns an invalid QVariant for NULL values and unknown columns.
+    virtual QVariant getValue(const QString& column) const = 0;
+
+    /// Returns the text value folded by DbConnection::makeStringLatinLow()
+    /// for matching search terms. Returns std::nullopt for NULL values and
+    /// unknown columns. Override this to provide a precomputed value.
+    virtual std::optional<QString> getLatinLowText(const QString& column) const;
+};
+
 class QueryNode {
   public:
     QueryNode(const QueryNode&) = delete; // prevent copying
     virtual ~QueryNode() = default;
 
-    virtual bool match(const TrackPointer& pTrack) const = 0;
+    bool match(const TrackPointer& pTrack) const;
+
+    /// Must only be invoked after prepareRecordMatching() returned true.
+    /// Then it may be invoked concurrently from multiple threads.
+    virtual bool match(const TrackRecord& record) const = 0;
+
+    /// Initializes all lazily loaded state on the calling thread, which
+    /// owns the database connection. Returns false if the node can only be
+    /// evaluated by SQLite, e.g. an SqlNode.
+    virtual bool prepareRecordMatching() const {
+        return true;
+    }
+
     virtual QString toSql() const = 0;
 
   protected:
@@ -43,6 +77,8 @@ class GroupNode : public QueryNode {
         m_nodes.push_back(std::move(pNode));
     }
 
+    bool prepareRecordMatching() const override;
+
   protected:
     // NOTE(uklotzde): std::vector is more suitable (efficiency)
     // than a QList for a private member. And QList from Qt 4
@@ -52,13 +88,13 @@ class GroupNode : public QueryNode {
 
 class OrNode : public GroupNode {
   public:
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 };
 
 class AndNode : public GroupNode {
   public:
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 };
 
@@ -69,7 +105,10 @@ class NotNode : public QueryNode {
         DEBUG_ASSERT(m_pNode);
     }
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
+    bool prepareRecordMatching() const override {
+        return m_pNode->prepareRecordMatching();
+    }
     QString toSql() const override;
 
   private:
@@ -78,12 +117,16 @@ class NotNode : public QueryNode {
 
 class TextFilterNode : public QueryNode {
   public:
+    /// If pFullTextSearch is given the columns are looked up in the
+    /// full-text search index first. This requires that the query is
+    /// executed on the library table or a view of it.
     TextFilterNode(const QSqlDatabase& database,
             const QStringList& sqlColumns,
             const QString& argument,
-            const StringMatch matchMode = StringMatch::Contains);
+            const StringMatch matchMode = StringMatch::Contains,
+            const FullTextSearchDAO* pFullTextSearch = nullptr);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
   private:
@@ -91,6 +134,7 @@ class TextFilterNode : public QueryNode {
     QStringList m_sqlColumns;
     QString m_argument;
     StringMatch m_matchMode;
+    const FullTextSearchDAO* m_pFullTextSearch;
 };
 
 class NullOrEmptyTextFilterNode : public QueryNode {
@@ -101,7 +145,7 @@ class NullOrEmptyTextFilterNode : public QueryNode {
               m_sqlColumns(sqlColumns) {
     }
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
   private:
@@ -114,7 +158,8 @@ class CrateFilterNode : public QueryNode {
     CrateFilterNode(const CrateStorage* pCrateStorage,
             const QString& crateNameLike);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
+    bool prepareRecordMatching() const override;
     QString toSql() const override;
 
   private:
@@ -128,7 +173,8 @@ class NoCrateFilterNode : public QueryNode {
   public:
     explicit NoCrateFilterNode(const CrateStorage* pCrateStorage);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
+    bool prepareRecordMatching() const override;
     QString toSql() const override;
 
   private:
@@ -142,7 +188,7 @@ class NumericFilterNode : public QueryNode {
   public:
     NumericFilterNode(const QStringList& sqlColumns, const QString& argument);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
   protected:
@@ -171,7 +217,7 @@ class NullNumericFilterNode : public QueryNode {
   public:
     explicit NullNumericFilterNode(const QStringList& sqlColumns);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
     QStringList m_sqlColumns;
@@ -222,7 +268,7 @@ class BpmFilterNode : public QueryNode {
     QString toSql() const override;
 
   private:
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
 
     QSqlDatabase m_database;
 
@@ -245,7 +291,7 @@ class KeyFilterNode : public QueryNode {
   public:
     KeyFilterNode(mixxx::track::io::key::ChromaticKey key, bool fuzzy);
 
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
   private:
@@ -261,13 +307,18 @@ class SqlNode : public QueryNode {
             : m_sql(sqlExpression) {
     }
 
-    bool match(const TrackPointer& pTrack) const override {
+    bool match(const TrackRecord& record) const override {
         // We are usually embedded in an AND node so if we don't match
         // everything then we block everything.
-        Q_UNUSED(pTrack);
+        Q_UNUSED(record);
         return true;
     }
 
+    bool prepareRecordMatching() const override {
+        // The SQL expression can only be evaluated by the database
+        return false;
+    }
+
     QString toSql() const override {
         return m_sql;
     }
@@ -285,7 +336,7 @@ class YearFilterNode : public NumericFilterNode {
 class DateAddedFilterNode : public QueryNode {
   public:
     DateAddedFilterNode(const QString& argument);
-    bool match(const TrackPointer& pTrack) const override;
+    bool match(const TrackRecord& record) const override;
     QString toSql() const override;
 
   private:
@@ -69,7 +69,8 @@ const QRegularExpression kSplitOnOrOperatorRegexp = QRegularExpression(
 
 SearchQueryParser::SearchQueryParser(TrackCollection* pTrackCollection, QStringList searchColumns)
         : m_pTrackCollection(pTrackCollection),
-          m_searchCrates(false) {
+          m_searchCrates(false),
+          m_fullTextSearch(false) {
     setSearchColumns(std::move(searchColumns));
 
     m_textFilters << "a" << "artist"
@@ -192,6 +193,9 @@ SearchQueryParser::TextArgumentResult SearchQueryParser::getTextArgument(QString
 
 void SearchQueryParser::parseTokens(QStringList tokens,
                                     AndNode* pQuery) const {
+    const FullTextSearchDAO* pFullTextSearch = m_fullTextSearch
+            ? &m_pTrackCollection->getFullTextSearchDAO()
+            : nullptr;
     while (tokens.size() > 0) {
         QString token = tokens.takeFirst().trimmed();
         if (token.length() == 0) {
@@ -228,7 +232,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                             m_pTrackCollection->database(),
                             m_fieldToSqlColumns[field],
                             argument,
-                            matchMode);
+                            matchMode,
+                            pFullTextSearch);
                 }
             }
         } else if (numericFilterMatch.hasMatch()) {
@@ -261,7 +266,11 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                                     m_pTrackCollection->database(), m_fieldToSqlColumns[field]);
                         } else {
                             pNode = std::make_unique<TextFilterNode>(
-                                    m_pTrackCollection->database(), m_fieldToSqlColumns[field], argument);
+                                    m_pTrackCollection->database(),
+                                    m_fieldToSqlColumns[field],
+                                    argument,
+                                    StringMatch::Contains,
+                                    pFullTextSearch);
                         }
                     } else {
                         pNode = std::make_unique<KeyFilterNode>(key, fuzzy);
@@ -306,11 +315,19 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     gNode->addNode(std::make_unique<CrateFilterNode>(
                                     &m_pTrackCollection->crates(), argument));
                     gNode->addNode(std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument));
+                            m_pTrackCollection->database(),
+                            m_queryColumns,
+                            argument,
+                            StringMatch::Contains,
+                            pFullTextSearch));
                     pNode = std::move(gNode);
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument);
+                            m_pTrackCollection->database(),
+                            m_queryColumns,
+                            argument,
+                            StringMatch::Contains,
+                            pFullTextSearch);
                 }
             }
         }
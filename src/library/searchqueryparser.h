@@ -17,6 +17,12 @@ class SearchQueryParser {
 
     void setSearchColumns(QStringList searchColumns);
 
+    /// Text searches use the full-text search index of the track collection
+    /// if available. Only enable this for queries on the library table!
+    void setFullTextSearchEnabled(bool enabled) {
+        m_fullTextSearch = enabled;
+    }
+
     std::unique_ptr<QueryNode> parseQuery(
             const QString& query,
             const QString& extraFilter) const;
@@ -45,6 +51,7 @@ class SearchQueryParser {
     TrackCollection* m_pTrackCollection;
     QStringList m_queryColumns;
     bool m_searchCrates;
+    bool m_fullTextSearch;
     QStringList m_textFilters;
     QStringList m_numericFilters;
     QStringList m_specialFilters;
@@ -11,6 +11,7 @@
 #include "soundio/soundmanagerutil.h"
 #include "util/denormalsarezero.h"
 #include "util/logger.h"
+#include "util/realtimetrace.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -122,6 +123,10 @@ SoundDeviceStatus SoundDeviceNetwork::close() {
 
     m_outputFifo.reset();
     m_inputFifo.reset();
+    // The clock reference thread is recreated when opening again, which
+    // needs to be set up and registered again.
+    m_denormals = false;
+    mixxx::RealtimeTrace::releaseThreads(this);
 
     return SoundDeviceStatus::Ok;
 }
@@ -446,6 +451,10 @@ void SoundDeviceNetwork::callbackProcessClkRef() {
     if (!m_denormals) {
         m_denormals = true;
 
+        if (mixxx::RealtimeTrace::isEnabled()) {
+            mixxx::RealtimeTrace::registerCurrentThread("Network sound", this);
+        }
+
         // This disables the denormals calculations, to avoid a
         // performance penalty of ~20
         // https://github.com/mixxxdj/mixxx/issues/7747
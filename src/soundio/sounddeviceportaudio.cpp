@@ -16,6 +16,7 @@
 #include "util/denormalsarezero.h"
 #include "util/fifo.h"
 #include "util/math.h"
+#include "util/realtimetrace.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -519,6 +520,8 @@ SoundDeviceStatus SoundDevicePortAudio::close() {
     m_outputFifo.reset();
     m_inputFifo.reset();
     m_bSetThreadPriority = false;
+    // The callback thread of the next stream registers again
+    mixxx::RealtimeTrace::releaseThreads(this);
 
     return SoundDeviceStatus::Ok;
 }
@@ -984,6 +987,10 @@ int SoundDevicePortAudio::callbackProcessClkRef(
 #endif
         m_bSetThreadPriority = true;
 
+        if (mixxx::RealtimeTrace::isEnabled()) {
+            mixxx::RealtimeTrace::registerCurrentThread("Audio callback", this);
+        }
+
         // This disables the denormals calculations, to avoid a
         // performance penalty of ~20
         // https://github.com/mixxxdj/mixxx/issues/7747
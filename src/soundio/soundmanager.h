@@ -13,6 +13,7 @@
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanagerconfig.h"
 #include "util/cmdlineargs.h"
+#include "util/realtimetrace.h"
 #include "util/types.h"
 
 class EngineMixer;
@@ -103,6 +104,7 @@ class SoundManager : public QObject {
 
     void underflowHappened(int code) {
         m_underflowHappened = 1;
+        mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, code);
         // Disable the engine warnings by default, because printing a warning is a
         // locking function that will make the problem worse
         if (CmdlineArgs::Instance().getDeveloper()) {
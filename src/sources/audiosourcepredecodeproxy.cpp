@@ -0,0 +1,143 @@
+#include "sources/audiosourcepredecodeproxy.h"
+
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/sample.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AudioSourcePreDecodeProxy");
+
+// Decoded samples may exceed 0 dBFS and must not be clipped before
+// ReplayGain and the EQs are applied. The 16-bit samples are stored
+// with 6 dB of headroom at the cost of 1 bit of resolution.
+constexpr CSAMPLE kInt16Headroom = 2;
+
+} // anonymous namespace
+
+AudioSourcePreDecodeProxy::AudioSourcePreDecodeProxy(
+        AudioSourcePointer pAudioSource,
+        SampleFormat sampleFormat)
+        : AudioSourceProxy(std::move(pAudioSource)),
+          m_sampleFormat(sampleFormat),
+          m_firstFrameIndex(frameIndexRange().start()),
+          m_decodedFrameCount(0),
+          m_decodingFinished(false) {
+    const auto sampleCount = static_cast<std::size_t>(
+            getSignalInfo().frames2samples(frameLength()));
+    switch (m_sampleFormat) {
+    case SampleFormat::Float32:
+        m_float32Samples.resize(sampleCount);
+        break;
+    case SampleFormat::Int16:
+        m_int16Samples.resize(sampleCount);
+        break;
+    }
+}
+
+SINT AudioSourcePreDecodeProxy::sizeInBytes() const {
+    return static_cast<SINT>(m_float32Samples.size() * sizeof(CSAMPLE) +
+            m_int16Samples.size() * sizeof(SAMPLE));
+}
+
+bool AudioSourcePreDecodeProxy::decodeNextFrames(SINT maxFrameCount) {
+    DEBUG_ASSERT(maxFrameCount > 0);
+    if (m_decodingFinished) {
+        return false;
+    }
+    const auto decodeFrameIndexRange = intersect(
+            IndexRange::forward(
+                    m_firstFrameIndex + m_decodedFrameCount,
+                    maxFrameCount),
+            frameIndexRange());
+    if (decodeFrameIndexRange.empty()) {
+        m_decodingFinished = true;
+        return false;
+    }
+
+    const SINT sampleOffset = getSignalInfo().frames2samples(m_decodedFrameCount);
+    const SINT sampleCount = getSignalInfo().frames2samples(decodeFrameIndexRange.length());
+    CSAMPLE* pDecodeBuffer;
+    if (m_sampleFormat == SampleFormat::Float32) {
+        pDecodeBuffer = &m_float32Samples[sampleOffset];
+    } else {
+        if (static_cast<SINT>(m_decodeBuffer.size()) < sampleCount) {
+            m_decodeBuffer.resize(sampleCount);
+        }
+        pDecodeBuffer = m_decodeBuffer.data();
+    }
+    const auto readableSampleFrames = m_pAudioSource->readSampleFrames(
+            WritableSampleFrames(
+                    decodeFrameIndexRange,
+                    SampleBuffer::WritableSlice(pDecodeBuffer, sampleCount)));
+
+    // Only frames that directly follow the decoded frames can be stored
+    SINT readFrameCount = 0;
+    if (readableSampleFrames.frameIndexRange().start() == decodeFrameIndexRange.start()) {
+        readFrameCount = readableSampleFrames.frameLength();
+    }
+    if (m_sampleFormat == SampleFormat::Int16 && readFrameCount > 0) {
+        const SINT readSampleCount = getSignalInfo().frames2samples(readFrameCount);
+        DEBUG_ASSERT(readableSampleFrames.readableData() == m_decodeBuffer.data());
+        SampleUtil::applyGain(m_decodeBuffer.data(), 1 / kInt16Headroom, readSampleCount);
+        SampleUtil::convertFloat32ToS16(
+                &m_int16Samples[sampleOffset],
+                m_decodeBuffer.data(),
+                readSampleCount);
+    }
+    m_decodedFrameCount += readFrameCount;
+
+    if (readFrameCount < decodeFrameIndexRange.length()) {
+        kLogger.warning()
+                << "Stopped decoding after"
+                << m_decodedFrameCount
+                << "frames: expected ="
+                << decodeFrameIndexRange
+                << ", actual ="
+                << readableSampleFrames.frameIndexRange();
+        m_decodingFinished = true;
+        // The wrapped source has shrunk its readable range
+        if (m_pAudioSource->frameIndexRange() != frameIndexRange()) {
+            adjustFrameIndexRange(m_pAudioSource->frameIndexRange());
+        }
+        return false;
+    }
+    if (decodeFrameIndexRange.end() >= frameIndexRange().end()) {
+        kLogger.debug()
+                << "Decoded all"
+                << m_decodedFrameCount
+                << "frames into"
+                << sizeInBytes()
+                << "bytes";
+        m_decodingFinished = true;
+    }
+    return true;
+}
+
+ReadableSampleFrames AudioSourcePreDecodeProxy::readSampleFramesClamped(
+        const WritableSampleFrames& sampleFrames) {
+    const auto readFrameIndexRange = sampleFrames.frameIndexRange();
+    if (!readFrameIndexRange.isSubrangeOf(decodedFrameIndexRange())) {
+        return readSampleFramesClampedOn(*m_pAudioSource, sampleFrames);
+    }
+    const SINT sampleOffset = getSignalInfo().frames2samples(
+            readFrameIndexRange.start() - m_firstFrameIndex);
+    const SINT sampleCount = getSignalInfo().frames2samples(readFrameIndexRange.length());
+    CSAMPLE* pDest = sampleFrames.writableData();
+    switch (m_sampleFormat) {
+    case SampleFormat::Float32:
+        SampleUtil::copy(pDest, &m_float32Samples[sampleOffset], sampleCount);
+        break;
+    case SampleFormat::Int16:
+        SampleUtil::convertS16ToFloat32(pDest, &m_int16Samples[sampleOffset], sampleCount);
+        SampleUtil::applyGain(pDest, kInt16Headroom, sampleCount);
+        break;
+    }
+    return ReadableSampleFrames(
+            readFrameIndexRange,
+            SampleBuffer::ReadableSlice(pDest, sampleCount));
+}
+
+} // namespace mixxx
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+
+#include "sources/audiosourceproxy.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+/// Decodes the whole audio source sequentially into memory, e.g. in the
+/// background after a track has been loaded into a deck.
+///
+/// Reads of frames that have already been decoded are served from memory
+/// without seeking or decoding. All other reads are delegated to the
+/// wrapped audio source. The decoding needs to be driven explicitly by
+/// invoking decodeNextFrames() from the same thread that reads from the
+/// audio source, i.e. no synchronization is needed.
+class AudioSourcePreDecodeProxy : public AudioSourceProxy {
+  public:
+    enum class SampleFormat {
+        Float32,
+        /// Halves the required memory at the cost of a slight quantization.
+        /// Samples are only clipped above +6 dBFS.
+        Int16,
+    };
+
+    static std::shared_ptr<AudioSourcePreDecodeProxy> create(
+            AudioSourcePointer pAudioSource,
+            SampleFormat sampleFormat) {
+        return std::make_shared<AudioSourcePreDecodeProxy>(
+                std::move(pAudioSource),
+                sampleFormat);
+    }
+
+    /// Allocates the memory for all samples
+    AudioSourcePreDecodeProxy(
+            AudioSourcePointer pAudioSource,
+            SampleFormat sampleFormat);
+    ~AudioSourcePreDecodeProxy() override = default;
+
+    /// Decodes up to the given number of frames that follow the frames that
+    /// have already been decoded. Returns false if there is nothing left to
+    /// decode, either because all frames have been decoded or because
+    /// decoding failed.
+    bool decodeNextFrames(SINT maxFrameCount);
+
+    bool isDecodingFinished() const {
+        return m_decodingFinished;
+    }
+
+    /// The range of frames that can be read from memory
+    IndexRange decodedFrameIndexRange() const {
+        return IndexRange::forward(m_firstFrameIndex, m_decodedFrameCount);
+    }
+
+    /// The memory allocated for decoded samples
+    SINT sizeInBytes() const;
+
+  protected:
+    ReadableSampleFrames readSampleFramesClamped(
+            const WritableSampleFrames& sampleFrames) override;
+
+  private:
+    const SampleFormat m_sampleFormat;
+
+    // The index of the first stored frame. The readable range of the
+    // audio source might shrink while decoding.
+    const SINT m_firstFrameIndex;
+
+    // Only one of them is allocated depending on the sample format
+    std::vector<CSAMPLE> m_float32Samples;
+    std::vector<SAMPLE> m_int16Samples;
+
+    // Temporary buffer for decoding into the 16-bit store
+    std::vector<CSAMPLE> m_decodeBuffer;
+
+    SINT m_decodedFrameCount;
+    bool m_decodingFinished;
+};
+
+} // namespace mixxx
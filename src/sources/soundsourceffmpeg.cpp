@@ -9,6 +9,16 @@ extern "C" {
 
 } // extern "C"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <limits>
+
 #include "util/logger.h"
 #include "util/sample.h"
 
@@ -55,6 +65,81 @@ constexpr SINT kMaxSamplesPerMP3Frame = 1152;
 
 const Logger kLogger("SoundSourceFFmpeg");
 
+// The MP3 bit reservoir may reference up to 511 bytes of main data in
+// preceding frames. The header, CRC, and side info are not part of it.
+constexpr int kMaxMP3BitReservoirSize = 511;
+constexpr int kMaxMP3HeaderAndSideInfoSize = 4 + 2 + 32;
+
+// File format of the persistent seek index
+constexpr quint32 kSeekIndexMagic = 0x4d585349; // "MXSI"
+constexpr quint32 kSeekIndexVersion = 1;
+constexpr qint64 kSeekIndexHeaderSize = 4 + 4 + 8 + 8 + 4 + 4 + 4;
+constexpr qint64 kSeekIndexEntrySize = 8 + 8 + 4 + 4 + 4;
+
+// An MP3 file of 5 minutes needs about 300 KiB, so this is enough
+// for the tracks of a few gigs.
+constexpr qint64 kSeekIndexMaxTotalSize = 256 * 1024 * 1024;
+constexpr int kSeekIndexMaxAgeDays = 180;
+
+const QString kSeekIndexFileSuffix = QStringLiteral(".idx");
+
+QString s_seekIndexDirPath;
+
+// Serializes pruning, which is done by all threads that store an index
+QMutex s_seekIndexPruneMutex;
+
+/// Only demuxers with a generic index build an exact index of all
+/// packets while reading. Others like MP4 read their index from the
+/// file or don't need one.
+bool hasGenericIndex(const AVFormatContext* pavFormatContext) {
+    return pavFormatContext->iformat->flags & AVFMT_GENERIC_INDEX;
+}
+
+int getIndexEntriesCount(AVStream* pavStream) {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100) // FFmpeg 4.4
+    return avformat_index_get_entries_count(pavStream);
+#else
+    return pavStream->nb_index_entries;
+#endif
+}
+
+const AVIndexEntry* getIndexEntry(AVStream* pavStream, int idx) {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100) // FFmpeg 4.4
+    return avformat_index_get_entry(pavStream, idx);
+#else
+    return &pavStream->index_entries[idx];
+#endif
+}
+
+/// Seeking with an exact index lands on the requested packet instead
+/// of an estimated position. For MP3 only the frames with the bit
+/// reservoir and the overlap with the previous frame need to be
+/// prerolled then.
+SINT getIndexedSeekPrerollFrameCount(
+        const AVStream& avStream,
+        int minPacketSize,
+        SINT seekPrerollFrameCount) {
+    switch (avStream.codecpar->codec_id) {
+    case AV_CODEC_ID_MP3:
+    case AV_CODEC_ID_MP3ON4: {
+        const int minMainDataSize = minPacketSize - kMaxMP3HeaderAndSideInfoSize;
+        if (minMainDataSize <= 0) {
+            return seekPrerollFrameCount;
+        }
+        const SINT codecFrameSize = avStream.codecpar->frame_size > 0
+                ? avStream.codecpar->frame_size
+                : kMaxSamplesPerMP3Frame;
+        const SINT prerollCodecFrames = 1 +
+                (kMaxMP3BitReservoirSize + minMainDataSize - 1) / minMainDataSize;
+        return math_max(
+                math_min(prerollCodecFrames * codecFrameSize, seekPrerollFrameCount),
+                static_cast<SINT>(avStream.codecpar->seek_preroll));
+    }
+    default:
+        return seekPrerollFrameCount;
+    }
+}
+
 int64_t getStreamStartTime(const AVStream& avStream) {
     auto start_time = avStream.start_time;
     if (start_time == AV_NOPTS_VALUE) {
@@ -268,6 +353,62 @@ bool SoundSourceFFmpeg::openDecodingContext(
     return true;
 }
 
+// Static
+void SoundSourceFFmpeg::setSeekIndexDirPath(const QString& dirPath) {
+    s_seekIndexDirPath = dirPath;
+}
+
+// Static
+QString SoundSourceFFmpeg::seekIndexFilePath(const QString& localFileName) {
+    if (s_seekIndexDirPath.isEmpty()) {
+        return QString();
+    }
+    const QByteArray hash = QCryptographicHash::hash(
+            localFileName.toUtf8(), QCryptographicHash::Sha1);
+    return QDir(s_seekIndexDirPath)
+            .filePath(QString::fromLatin1(hash.toHex()) + kSeekIndexFileSuffix);
+}
+
+// Static
+void SoundSourceFFmpeg::pruneSeekIndexes() {
+    if (s_seekIndexDirPath.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&s_seekIndexPruneMutex);
+    // Sorted by the time of their last use, most recent first.
+    // See restoreSeekIndex().
+    const QFileInfoList fileInfos = QDir(s_seekIndexDirPath)
+                                            .entryInfoList(
+                                                    QStringList{QChar('*') +
+                                                            kSeekIndexFileSuffix},
+                                                    QDir::Files,
+                                                    QDir::Time);
+    const QDateTime minLastModified =
+            QDateTime::currentDateTime().addDays(-kSeekIndexMaxAgeDays);
+    qint64 totalSize = 0;
+    int removedCount = 0;
+    for (const auto& fileInfo : fileInfos) {
+        if (fileInfo.lastModified() >= minLastModified &&
+                totalSize + fileInfo.size() <= kSeekIndexMaxTotalSize) {
+            totalSize += fileInfo.size();
+            continue;
+        }
+        if (QFile::remove(fileInfo.filePath())) {
+            ++removedCount;
+        } else {
+            kLogger.warning()
+                    << "Failed to remove seek index"
+                    << fileInfo.filePath();
+        }
+    }
+    if (removedCount > 0) {
+        kLogger.info()
+                << "Removed"
+                << removedCount
+                << "seek indexes that have not been used recently";
+    }
+}
+
 // Static
 QString SoundSourceFFmpeg::formatErrorString(int errnum) {
     // Allocate a static buffer on the stack and initialize it
@@ -486,6 +627,9 @@ SoundSourceFFmpeg::SoundSourceFFmpeg(const QUrl& url)
           m_pavStream(nullptr),
           m_pavDecodedFrame(nullptr),
           m_seekPrerollFrameCount(0),
+          m_seekIndexRestored(false),
+          m_seekIndexComplete(false),
+          m_seekIndexMinPacketSize(std::numeric_limits<int>::max()),
           m_pavPacket(av_packet_alloc()),
           m_pavResampledFrame(nullptr),
           m_avutilVersion(avutil_version()) {
@@ -764,6 +908,21 @@ SoundSource::OpenResult SoundSourceFFmpeg::tryOpen(
     kLogger.debug() << "Seek preroll frame count:" << m_seekPrerollFrameCount;
 #endif
 
+    m_seekIndexComplete = false;
+    m_seekIndexMinPacketSize = std::numeric_limits<int>::max();
+    m_seekIndexRestored = restoreSeekIndex();
+    if (m_seekIndexRestored) {
+        m_seekPrerollFrameCount = getIndexedSeekPrerollFrameCount(
+                *m_pavStream,
+                m_seekIndexMinPacketSize,
+                m_seekPrerollFrameCount);
+#if VERBOSE_DEBUG_LOG
+        kLogger.debug()
+                << "Seek preroll frame count with index:"
+                << m_seekPrerollFrameCount;
+#endif
+    }
+
     m_frameBuffer = ReadAheadFrameBuffer(
             getSignalInfo(),
             frameBufferCapacityForStream(*m_pavStream));
@@ -905,7 +1064,142 @@ bool SoundSourceFFmpeg::initResampling(
     return true;
 }
 
+bool SoundSourceFFmpeg::restoreSeekIndex() {
+    if (!hasGenericIndex(m_pavInputFormatContext)) {
+        return false;
+    }
+    const QString filePath = seekIndexFilePath(getLocalFileName());
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Not decoded completely yet
+        return false;
+    }
+    const QFileInfo fileInfo(getLocalFileName());
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 fileSize = 0;
+    qint64 lastModified = 0;
+    qint32 streamIndex = 0;
+    qint32 minPacketSize = 0;
+    quint32 entryCount = 0;
+    in >> magic >> version >> fileSize >> lastModified >> streamIndex >>
+            minPacketSize >> entryCount;
+    if (in.status() != QDataStream::Ok ||
+            magic != kSeekIndexMagic ||
+            version != kSeekIndexVersion ||
+            file.size() != kSeekIndexHeaderSize + entryCount * kSeekIndexEntrySize) {
+        kLogger.warning()
+                << "Discarding invalid seek index"
+                << filePath;
+        file.remove();
+        return false;
+    }
+    if (fileSize != fileInfo.size() ||
+            lastModified != fileInfo.lastModified().toMSecsSinceEpoch() ||
+            streamIndex != m_pavStream->index) {
+        kLogger.info()
+                << "Discarding outdated seek index of"
+                << getLocalFileName();
+        file.remove();
+        return false;
+    }
+    for (quint32 i = 0; i < entryCount; ++i) {
+        qint64 pos;
+        qint64 timestamp;
+        qint32 size;
+        qint32 distance;
+        qint32 flags;
+        in >> pos >> timestamp >> size >> distance >> flags;
+        if (av_add_index_entry(m_pavStream, pos, timestamp, size, distance, flags) < 0) {
+            kLogger.warning()
+                    << "Failed to restore seek index"
+                    << filePath;
+            return false;
+        }
+    }
+    m_seekIndexMinPacketSize = minPacketSize;
+    // Keeps the index when pruning the least recently used ones
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#if VERBOSE_DEBUG_LOG
+    kLogger.debug()
+            << "Restored seek index with"
+            << entryCount
+            << "entries";
+#endif
+    return true;
+}
+
+void SoundSourceFFmpeg::storeSeekIndex() const {
+    const QString filePath = seekIndexFilePath(getLocalFileName());
+    if (filePath.isEmpty()) {
+        return;
+    }
+    const int entryCount = getIndexEntriesCount(m_pavStream);
+    if (entryCount <= 0) {
+        return;
+    }
+    if (!QDir().mkpath(s_seekIndexDirPath)) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << s_seekIndexDirPath;
+        return;
+    }
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to open file"
+                << filePath
+                << file.errorString();
+        return;
+    }
+    // The packets that have been read while seeking are only
+    // visible in the index
+    int minPacketSize = std::numeric_limits<int>::max();
+    for (int i = 0; i < entryCount; ++i) {
+        minPacketSize = math_min(minPacketSize, getIndexEntry(m_pavStream, i)->size);
+    }
+    const QFileInfo fileInfo(getLocalFileName());
+    QDataStream out(&file);
+    out << kSeekIndexMagic
+        << kSeekIndexVersion
+        << static_cast<qint64>(fileInfo.size())
+        << static_cast<qint64>(fileInfo.lastModified().toMSecsSinceEpoch())
+        << static_cast<qint32>(m_pavStream->index)
+        << static_cast<qint32>(minPacketSize)
+        << static_cast<quint32>(entryCount);
+    for (int i = 0; i < entryCount; ++i) {
+        const AVIndexEntry* pEntry = getIndexEntry(m_pavStream, i);
+        out << static_cast<qint64>(pEntry->pos)
+            << static_cast<qint64>(pEntry->timestamp)
+            << static_cast<qint32>(pEntry->size)
+            << static_cast<qint32>(pEntry->min_distance)
+            << static_cast<qint32>(pEntry->flags);
+    }
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning()
+                << "Failed to write seek index"
+                << filePath;
+        return;
+    }
+#if VERBOSE_DEBUG_LOG
+    kLogger.debug()
+            << "Stored seek index with"
+            << entryCount
+            << "entries";
+#endif
+    // Batch analysis stores the indexes of many tracks at once
+    pruneSeekIndexes();
+}
+
 void SoundSourceFFmpeg::close() {
+    if (m_pavStream && m_seekIndexComplete && !m_seekIndexRestored) {
+        storeSeekIndex();
+    }
+    m_seekIndexComplete = false;
     av_frame_free(&m_pavResampledFrame);
     DEBUG_ASSERT(!m_pavResampledFrame);
     av_frame_free(&m_pavDecodedFrame);
@@ -1035,6 +1329,11 @@ bool SoundSourceFFmpeg::consumeNextAVPacket(
             m_frameBuffer.invalidate();
             return false;
         }
+        if (!m_pavPacket->data) {
+            // EOF: All packets have been added to the index, either
+            // while reading or while seeking
+            m_seekIndexComplete = true;
+        }
         *ppavNextPacket = m_pavPacket;
     }
     auto* pavNextPacket = *ppavNextPacket;
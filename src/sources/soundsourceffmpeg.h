@@ -22,6 +22,26 @@ class SoundSourceFFmpeg : public SoundSource {
 
     static QString formatErrorString(int errnum);
 
+    /// Directory for persisting the seek indexes of compressed streams.
+    /// Must be set before opening any sources, persistent seek indexes
+    /// are disabled if empty.
+    static void setSeekIndexDirPath(const QString& dirPath);
+
+    /// The file of the persistent seek index for the given file.
+    /// Empty if persistent seek indexes are disabled.
+    static QString seekIndexFilePath(const QString& localFileName);
+
+    /// Removes the seek indexes that have not been used for a long
+    /// time or exceed the total size limit, least recently used first.
+    /// Invoked on startup and after storing an index.
+    static void pruneSeekIndexes();
+
+    /// The seek index has been restored when opening the source, so
+    /// seeking jumps to the exact packet without reading the stream.
+    bool isSeekIndexRestored() const {
+        return m_seekIndexRestored;
+    }
+
   protected:
     ReadableSampleFrames readSampleFramesClamped(
             const WritableSampleFrames& sampleFrames) override;
@@ -41,6 +61,11 @@ class SoundSourceFFmpeg : public SoundSource {
     bool consumeNextAVPacket(
             AVPacket** ppavNextPacket);
 
+    /// Restores the index of the demuxer from a previous decoding
+    /// of the whole stream.
+    bool restoreSeekIndex();
+    void storeSeekIndex() const;
+
     // Takes ownership of an input format context and ensures that
     // the corresponding AVFormatContext is closed, either explicitly
     // or implicitly by the destructor. The wrapper can only be
@@ -157,6 +182,14 @@ class SoundSourceFFmpeg : public SoundSource {
     FrameCount m_seekPrerollFrameCount;
     ReadAheadFrameBuffer m_frameBuffer;
 
+    // The demuxer builds an exact index while reading the stream.
+    // Seeking beyond the indexed packets reads forward from the last
+    // one, so the index is complete when reaching the end of the
+    // stream, usually after analyzing the track.
+    bool m_seekIndexRestored;
+    bool m_seekIndexComplete;
+    int m_seekIndexMinPacketSize;
+
     // FFmpeg static constants
     static constexpr AVSampleFormat s_avSampleFormat = AV_SAMPLE_FMT_FLT;
 
@@ -0,0 +1,274 @@
+#include "controllers/midi/alsaseqcontroller.h"
+
+#include <alsa/asoundlib.h>
+#include <gtest/gtest.h>
+#include <poll.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "test/mixxxtest.h"
+#include "util/time.h"
+
+namespace {
+
+constexpr int kNumLatencyMessages = 200;
+constexpr int kLatencyMessageIntervalMillis = 2;
+constexpr int kReceiveTimeoutMillis = 2000;
+
+struct ShortMessage {
+    unsigned char status;
+    unsigned char control;
+    unsigned char value;
+    mixxx::Duration timestamp;
+};
+
+class RecordingAlsaSeqController : public AlsaSeqController {
+  public:
+    RecordingAlsaSeqController(const QString& deviceName, const snd_seq_addr_t& deviceAddress)
+            : AlsaSeqController(deviceName, deviceAddress, true, true) {
+    }
+
+    void receivedShortMessage(unsigned char status,
+            unsigned char control,
+            unsigned char value,
+            mixxx::Duration timestamp) override {
+        m_shortMessages.push_back({status, control, value, timestamp});
+    }
+
+    void receive(const QByteArray& data, mixxx::Duration timestamp) override {
+        Q_UNUSED(timestamp);
+        m_sysexMessages.append(data);
+    }
+
+    // These tests are unrelated to scripting.
+    void startEngine() override {
+    }
+    void stopEngine() override {
+    }
+
+    std::vector<ShortMessage> m_shortMessages;
+    QList<QByteArray> m_sysexMessages;
+};
+
+} // namespace
+
+/// Sends and receives MIDI messages through a virtual port of the ALSA
+/// sequencer, which behaves like the port of a physical controller.
+class AlsaSeqControllerTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        const int err = snd_seq_open(&m_pSeq, "default", SND_SEQ_OPEN_DUPLEX, SND_SEQ_NONBLOCK);
+        if (err < 0) {
+            m_pSeq = nullptr;
+            GTEST_SKIP() << "ALSA sequencer is not available: " << snd_strerror(err);
+        }
+        snd_seq_set_client_name(m_pSeq, "Mixxx Test");
+        m_port = snd_seq_create_simple_port(m_pSeq,
+                "Virtual Controller",
+                SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ |
+                        SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+                SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+        ASSERT_GE(m_port, 0) << snd_strerror(m_port);
+
+        const snd_seq_addr_t address = {
+                static_cast<unsigned char>(snd_seq_client_id(m_pSeq)),
+                static_cast<unsigned char>(m_port)};
+        m_pController = std::make_unique<RecordingAlsaSeqController>(
+                QStringLiteral("Virtual Controller"), address);
+        ASSERT_EQ(0, m_pController->open(QString()));
+    }
+
+    void TearDown() override {
+        if (m_pController) {
+            m_pController->close();
+            m_pController.reset();
+        }
+        if (m_pSeq) {
+            snd_seq_close(m_pSeq);
+        }
+    }
+
+    /// Sends an event from the virtual port to the controller
+    void sendEvent(snd_seq_event_t* pEvent) {
+        snd_seq_ev_set_source(pEvent, m_port);
+        snd_seq_ev_set_subs(pEvent);
+        snd_seq_ev_set_direct(pEvent);
+        ASSERT_GE(snd_seq_event_output_direct(m_pSeq, pEvent), 0);
+    }
+
+    /// Dispatches the queued signals of the input thread until the expected
+    /// number of messages has been received.
+    bool waitForShortMessages(std::size_t count) {
+        QElapsedTimer timer;
+        timer.start();
+        while (m_pController->m_shortMessages.size() < count &&
+                timer.elapsed() < kReceiveTimeoutMillis) {
+            application()->processEvents();
+            QThread::msleep(1);
+        }
+        return m_pController->m_shortMessages.size() == count;
+    }
+
+    bool waitForSysexMessages(int count) {
+        QElapsedTimer timer;
+        timer.start();
+        while (m_pController->m_sysexMessages.size() < count &&
+                timer.elapsed() < kReceiveTimeoutMillis) {
+            application()->processEvents();
+            QThread::msleep(1);
+        }
+        return m_pController->m_sysexMessages.size() == count;
+    }
+
+    void sendShortMsgFromController(
+            unsigned char status, unsigned char byte1, unsigned char byte2) {
+        m_pController->sendShortMsg(status, byte1, byte2);
+    }
+
+    bool sendSysexFromController(const QByteArray& data) {
+        return m_pController->sendBytes(data);
+    }
+
+    /// Reads the next event that the controller has sent to the virtual port
+    snd_seq_event_t* readEvent() {
+        const int numFds = snd_seq_poll_descriptors_count(m_pSeq, POLLIN);
+        std::vector<pollfd> fds(numFds);
+        snd_seq_poll_descriptors(m_pSeq, fds.data(), numFds, POLLIN);
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < kReceiveTimeoutMillis) {
+            snd_seq_event_t* pEvent = nullptr;
+            if (snd_seq_event_input(m_pSeq, &pEvent) >= 0) {
+                if (pEvent->type == SND_SEQ_EVENT_PORT_SUBSCRIBED ||
+                        pEvent->type == SND_SEQ_EVENT_PORT_UNSUBSCRIBED) {
+                    continue;
+                }
+                return pEvent;
+            }
+            ::poll(fds.data(), fds.size(), kReceiveTimeoutMillis);
+        }
+        return nullptr;
+    }
+
+    snd_seq_t* m_pSeq = nullptr;
+    int m_port = -1;
+    std::unique_ptr<RecordingAlsaSeqController> m_pController;
+};
+
+TEST_F(AlsaSeqControllerTest, ReceiveShortMessages) {
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_noteon(&event, 0, 60, 100);
+    sendEvent(&event);
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_controller(&event, 1, 7, 127);
+    sendEvent(&event);
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_pitchbend(&event, 2, 0);
+    sendEvent(&event);
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_pgmchange(&event, 3, 5);
+    sendEvent(&event);
+    snd_seq_ev_clear(&event);
+    event.type = SND_SEQ_EVENT_CLOCK;
+    sendEvent(&event);
+    // Note on with velocity 0 must not be turned into a note off
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_noteon(&event, 0, 60, 0);
+    sendEvent(&event);
+
+    ASSERT_TRUE(waitForShortMessages(6));
+    const auto& messages = m_pController->m_shortMessages;
+    const unsigned char expected[6][3] = {
+            {0x90, 60, 100},
+            {0xB1, 7, 127},
+            {0xE2, 0x00, 0x40},
+            {0xC3, 5, 0},
+            {0xF8, 0, 0},
+            {0x90, 60, 0},
+    };
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(expected[i][0], messages[i].status) << i;
+        EXPECT_EQ(expected[i][1], messages[i].control) << i;
+        EXPECT_EQ(expected[i][2], messages[i].value) << i;
+    }
+}
+
+TEST_F(AlsaSeqControllerTest, ReceiveSysex) {
+    const QByteArray sysex = QByteArray::fromHex("f07e7f0601f7");
+    snd_seq_event_t event;
+    snd_seq_ev_clear(&event);
+    snd_seq_ev_set_sysex(&event, sysex.size(), const_cast<char*>(sysex.constData()));
+    sendEvent(&event);
+
+    ASSERT_TRUE(waitForSysexMessages(1));
+    EXPECT_EQ(sysex, m_pController->m_sysexMessages.first());
+}
+
+TEST_F(AlsaSeqControllerTest, Send) {
+    sendShortMsgFromController(0x91, 64, 127);
+    snd_seq_event_t* pEvent = readEvent();
+    ASSERT_NE(nullptr, pEvent);
+    EXPECT_EQ(SND_SEQ_EVENT_NOTEON, pEvent->type);
+    EXPECT_EQ(1, pEvent->data.note.channel);
+    EXPECT_EQ(64, pEvent->data.note.note);
+    EXPECT_EQ(127, pEvent->data.note.velocity);
+
+    const QByteArray sysex = QByteArray::fromHex("f000202b7f4201f7");
+    EXPECT_TRUE(sendSysexFromController(sysex));
+    pEvent = readEvent();
+    ASSERT_NE(nullptr, pEvent);
+    EXPECT_EQ(SND_SEQ_EVENT_SYSEX, pEvent->type);
+    EXPECT_EQ(sysex,
+            QByteArray(static_cast<const char*>(pEvent->data.ext.ptr),
+                    static_cast<int>(pEvent->data.ext.len)));
+
+    // Unterminated SysEx messages are rejected
+    EXPECT_FALSE(sendSysexFromController(QByteArray::fromHex("f000202b")));
+}
+
+/// Measures the latency and jitter of the timestamps that arrive at the
+/// controller. The controller thread is kept busy while sending, so the
+/// timestamps must reflect when the messages have been sent and not when
+/// they have been processed.
+TEST_F(AlsaSeqControllerTest, TimestampLatencyAndJitter) {
+    std::vector<mixxx::Duration> sendTimes;
+    sendTimes.reserve(kNumLatencyMessages);
+    for (int i = 0; i < kNumLatencyMessages; ++i) {
+        snd_seq_event_t event;
+        snd_seq_ev_clear(&event);
+        snd_seq_ev_set_controller(&event, 0, 1, i % 128);
+        sendTimes.push_back(mixxx::Time::elapsed());
+        sendEvent(&event);
+        QThread::msleep(kLatencyMessageIntervalMillis);
+    }
+    ASSERT_TRUE(waitForShortMessages(kNumLatencyMessages));
+
+    const auto& messages = m_pController->m_shortMessages;
+    double sumMicros = 0;
+    double sumSquaredMicros = 0;
+    double maxMicros = 0;
+    for (int i = 0; i < kNumLatencyMessages; ++i) {
+        ASSERT_EQ(0xB0, messages[i].status);
+        ASSERT_EQ(i % 128, messages[i].value);
+        if (i > 0) {
+            // The events are stamped in the order they have been sent
+            EXPECT_LE(messages[i - 1].timestamp, messages[i].timestamp);
+        }
+        const double latencyMicros = (messages[i].timestamp - sendTimes[i]).toDoubleMicros();
+        sumMicros += latencyMicros;
+        sumSquaredMicros += latencyMicros * latencyMicros;
+        maxMicros = std::max(maxMicros, std::abs(latencyMicros));
+    }
+    const double meanMicros = sumMicros / kNumLatencyMessages;
+    const double jitterMicros = std::sqrt(std::max(0.0,
+            sumSquaredMicros / kNumLatencyMessages - meanMicros * meanMicros));
+    // Only logged, the wall-clock times depend on the load of the machine
+    qInfo() << "ALSA sequencer timestamp latency: mean" << meanMicros << "us, max"
+            << maxMicros << "us, jitter" << jitterMicros << "us";
+}
@@ -0,0 +1,56 @@
+#include "library/dao/analysisdao.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <memory>
+
+#include "test/librarytest.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+class AnalysisDaoTest : public LibraryTest {
+  protected:
+    AnalysisDao& analysisDao() const {
+        return internalCollection()->getAnalysisDAO();
+    }
+
+    QString rawFilePath(int analysisId) const {
+        return config()->getSettingsPath() +
+                QStringLiteral("/analysis/%1.raw").arg(analysisId);
+    }
+};
+
+TEST_F(AnalysisDaoTest, DeleteLoadedRawAnalysis) {
+    const TrackPointer pTrack = getOrAddTrackByLocation(
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test-jpg.mp3")));
+    ASSERT_TRUE(pTrack);
+
+    const Waveform waveform(44100, 44100 * 3, 441, -1, 0);
+    AnalysisDao::AnalysisInfo analysis;
+    analysis.trackId = pTrack->getId();
+    analysis.type = AnalysisDao::TYPE_WAVEFORM;
+    analysis.version = WaveformFactory::currentWaveformVersion();
+    analysis.dataFormat = AnalysisDao::DataFormat::Raw;
+    analysis.data = waveform.toRawByteArray();
+    ASSERT_TRUE(analysisDao().saveAnalysis(&analysis));
+    const QString filePath = rawFilePath(analysis.analysisId);
+    ASSERT_TRUE(QFile::exists(filePath));
+
+    // Like AnalyzerWaveform::shouldAnalyze(), which deletes outdated
+    // analyses while the loaded ones are still alive
+    const QList<AnalysisDao::AnalysisInfo> analyses =
+            analysisDao().getAnalysesForTrack(pTrack->getId());
+    ASSERT_EQ(1, analyses.size());
+    EXPECT_EQ(AnalysisDao::DataFormat::Raw, analyses.first().dataFormat);
+    const std::unique_ptr<Waveform> pLoadedWaveform(
+            WaveformFactory::loadWaveformFromAnalysis(analyses.first()));
+    EXPECT_EQ(waveform.getDataSize(), pLoadedWaveform->getDataSize());
+
+    EXPECT_TRUE(analysisDao().deleteAnalysis(analyses.first().analysisId));
+    EXPECT_FALSE(QFile::exists(filePath));
+    EXPECT_TRUE(analysisDao().getAnalysesForTrack(pTrack->getId()).isEmpty());
+}
+
+} // namespace
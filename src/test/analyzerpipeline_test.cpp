@@ -0,0 +1,240 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "analyzer/analyzertrack.h"
+#include "analyzer/constants.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+
+namespace {
+
+constexpr int kChannelCount = 2;
+constexpr int kChunkCount = 16;
+constexpr SINT kChunkLength = 1024; // in samples
+
+/// The shared results of a RecordingAnalyzer, that outlive the
+/// analyzer when it is owned by an AnalyzerWithState.
+struct AnalyzerLog {
+    // The sample value of each processed chunk
+    std::vector<CSAMPLE> chunks;
+    // Whether all samples of each processed chunk were equal
+    bool consistent = true;
+    int cleanupCount = 0;
+    int storeCount = 0;
+};
+
+/// Records the chunks that it receives. Each chunk is expected to be
+/// filled with a single value. Processing fails after the configured
+/// number of chunks.
+class RecordingAnalyzer : public Analyzer {
+  public:
+    RecordingAnalyzer(AnalyzerLog* pLog, int failAfterChunks = -1)
+            : m_pLog(pLog),
+              m_failAfterChunks(failAfterChunks) {
+    }
+
+    bool initialize(const AnalyzerTrack& track,
+            mixxx::audio::SampleRate sampleRate,
+            mixxx::audio::ChannelCount channelCount,
+            SINT frameLength) override {
+        Q_UNUSED(track);
+        Q_UNUSED(sampleRate);
+        Q_UNUSED(channelCount);
+        Q_UNUSED(frameLength);
+        return true;
+    }
+
+    bool processSamples(const CSAMPLE* pIn, SINT count) override {
+        if (static_cast<int>(m_pLog->chunks.size()) == m_failAfterChunks) {
+            return false;
+        }
+        // Give the decoding thread a chance to overwrite the chunk
+        // if it would not have been decoupled from the analyzers.
+        QThread::usleep(100);
+        m_pLog->chunks.push_back(pIn[0]);
+        if (!std::all_of(pIn, pIn + count, [pIn](CSAMPLE sample) {
+                return sample == pIn[0];
+            })) {
+            m_pLog->consistent = false;
+        }
+        return true;
+    }
+
+    void storeResults(TrackPointer pTrack) override {
+        Q_UNUSED(pTrack);
+        ++m_pLog->storeCount;
+    }
+
+    void cleanup() override {
+        ++m_pLog->cleanupCount;
+    }
+
+  private:
+    AnalyzerLog* const m_pLog;
+    const int m_failAfterChunks;
+};
+
+class AnalyzerPipelineTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pTrack = Track::newTemporary();
+        m_pTrack->setAudioProperties(
+                mixxx::audio::ChannelCount(kChannelCount),
+                mixxx::audio::SampleRate(44100),
+                mixxx::audio::Bitrate(),
+                mixxx::Duration::fromSeconds(
+                        kChunkCount * kChunkLength / kChannelCount / 44100.0));
+    }
+
+    void addAnalyzer(AnalyzerLog* pLog, int failAfterChunks = -1) {
+        m_analyzers.push_back(AnalyzerWithState(
+                std::make_unique<RecordingAnalyzer>(pLog, failAfterChunks)));
+    }
+
+    void initializeAnalyzers() {
+        for (auto&& analyzer : m_analyzers) {
+            ASSERT_TRUE(analyzer.initialize(AnalyzerTrack(m_pTrack),
+                    m_pTrack->getSampleRate(),
+                    mixxx::audio::ChannelCount(kChannelCount),
+                    kChunkCount * kChunkLength / kChannelCount));
+        }
+    }
+
+    /// Decodes the chunks like the AnalyzerThread into the next buffer
+    /// of the pipeline. The sample values are the chunk indices.
+    void processChunks(AnalyzerPipeline* pPipeline, int firstChunk, int lastChunk) {
+        for (int chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            mixxx::SampleBuffer& buffer = pPipeline->nextBuffer();
+            ASSERT_LE(kChunkLength, buffer.size());
+            std::fill(buffer.data(),
+                    buffer.data() + kChunkLength,
+                    static_cast<CSAMPLE>(chunk));
+            pPipeline->processSamples(buffer.data(), kChunkLength);
+        }
+    }
+
+    static std::vector<CSAMPLE> expectedChunks(int firstChunk, int lastChunk) {
+        std::vector<CSAMPLE> chunks;
+        for (int chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            chunks.push_back(static_cast<CSAMPLE>(chunk));
+        }
+        return chunks;
+    }
+
+    TrackPointer m_pTrack;
+    std::vector<AnalyzerWithState> m_analyzers;
+};
+
+TEST_F(AnalyzerPipelineTest, ChunksAreProcessedInOrder) {
+    AnalyzerLog logs[3];
+    for (auto& log : logs) {
+        addAnalyzer(&log);
+    }
+    initializeAnalyzers();
+
+    {
+        AnalyzerPipeline pipeline(&m_analyzers, QThread::NormalPriority);
+        processChunks(&pipeline, 0, kChunkCount);
+        pipeline.waitReady();
+        for (auto&& analyzer : m_analyzers) {
+            analyzer.finish(AnalyzerTrack(m_pTrack));
+        }
+    }
+
+    for (const auto& log : logs) {
+        // Each analyzer received all chunks in the decoded order, and no
+        // chunk has been overwritten while it was still being analyzed.
+        EXPECT_EQ(expectedChunks(0, kChunkCount), log.chunks);
+        EXPECT_TRUE(log.consistent);
+        EXPECT_EQ(1, log.storeCount);
+        EXPECT_EQ(1, log.cleanupCount);
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, DestructorWaitsForPendingChunks) {
+    AnalyzerLog log;
+    addAnalyzer(&log);
+    initializeAnalyzers();
+
+    {
+        AnalyzerPipeline pipeline(&m_analyzers, QThread::NormalPriority);
+        processChunks(&pipeline, 0, kChunkCount);
+        // The last chunk might still be in flight
+    }
+
+    EXPECT_EQ(expectedChunks(0, kChunkCount), log.chunks);
+    for (auto&& analyzer : m_analyzers) {
+        analyzer.cancel();
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, Cancel) {
+    AnalyzerLog logs[2];
+    for (auto& log : logs) {
+        addAnalyzer(&log);
+    }
+    initializeAnalyzers();
+
+    constexpr int kCancelledAfterChunks = kChunkCount / 2;
+    {
+        AnalyzerPipeline pipeline(&m_analyzers, QThread::NormalPriority);
+        processChunks(&pipeline, 0, kCancelledAfterChunks);
+        // Like the AnalyzerThread when stopping
+        pipeline.waitReady();
+        for (auto&& analyzer : m_analyzers) {
+            analyzer.cancel();
+        }
+        // Inactive analyzers ignore all subsequent chunks
+        processChunks(&pipeline, kCancelledAfterChunks, kChunkCount);
+        pipeline.waitReady();
+    }
+
+    for (auto&& analyzer : m_analyzers) {
+        EXPECT_FALSE(analyzer.isActive());
+    }
+    for (const auto& log : logs) {
+        EXPECT_EQ(expectedChunks(0, kCancelledAfterChunks), log.chunks);
+        EXPECT_TRUE(log.consistent);
+        EXPECT_EQ(0, log.storeCount);
+        EXPECT_EQ(1, log.cleanupCount);
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, ProcessingFails) {
+    constexpr int kFailAfterChunks = 3;
+    AnalyzerLog failingLog;
+    AnalyzerLog log;
+    addAnalyzer(&failingLog, kFailAfterChunks);
+    addAnalyzer(&log);
+    initializeAnalyzers();
+
+    {
+        AnalyzerPipeline pipeline(&m_analyzers, QThread::NormalPriority);
+        processChunks(&pipeline, 0, kChunkCount);
+        pipeline.waitReady();
+        // The failing analyzer has been cleaned up by the pool thread
+        // and is excluded from the results.
+        EXPECT_FALSE(m_analyzers[0].isActive());
+        EXPECT_TRUE(m_analyzers[1].isActive());
+        for (auto&& analyzer : m_analyzers) {
+            analyzer.finish(AnalyzerTrack(m_pTrack));
+        }
+    }
+
+    EXPECT_EQ(expectedChunks(0, kFailAfterChunks), failingLog.chunks);
+    EXPECT_EQ(0, failingLog.storeCount);
+    EXPECT_EQ(1, failingLog.cleanupCount);
+
+    // The other analyzers are not affected
+    EXPECT_EQ(expectedChunks(0, kChunkCount), log.chunks);
+    EXPECT_TRUE(log.consistent);
+    EXPECT_EQ(1, log.storeCount);
+    EXPECT_EQ(1, log.cleanupCount);
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+#include "engine/cachingreader/cachingreader.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "engine/engineworkerscheduler.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QString kGroup = QStringLiteral("[test]");
+
+// Fits into the cache of 10 minutes, so the whole track is preloaded
+constexpr SINT kNumChunks = 100;
+
+Hint hintForChunks(Hint::Type type, SINT firstChunkIndex, SINT numChunks = 1) {
+    return Hint{firstChunkIndex * CachingReaderChunk::kFrames,
+            numChunks * CachingReaderChunk::kFrames,
+            type};
+}
+
+} // namespace
+
+class CachingReaderTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        config()->setValue(ConfigKey(QStringLiteral("[App]"),
+                                   QStringLiteral("caching_reader_cache_minutes")),
+                10.0);
+        m_pReader = std::make_unique<CachingReader>(
+                kGroup, config(), mixxx::audio::ChannelCount::stereo());
+        // The scheduler is never started, so the worker doesn't take
+        // the requests from the FIFO and they can be inspected.
+        m_pReader->setScheduler(&m_scheduler);
+    }
+
+    void TearDown() override {
+        m_pReader.reset();
+    }
+
+    // Pretends that the worker has opened a track with the given number
+    // of chunks.
+    void loadTrack(SINT numChunks) {
+        m_pReader->m_state.storeRelease(CachingReader::STATE_TRACK_LOADING);
+        const ReaderStatusUpdate update = ReaderStatusUpdate::trackLoaded(
+                mixxx::IndexRange::forward(0, numChunks * CachingReaderChunk::kFrames));
+        ASSERT_EQ(1, m_pReader->m_readerStatusUpdateFIFO.write(&update, 1));
+        m_pReader->process();
+    }
+
+    bool isChunkRequested(SINT chunkIndex) {
+        return m_pReader->lookupChunk(chunkIndex) != nullptr;
+    }
+
+    // Takes all requests from the FIFO like the worker would do, in the
+    // order they have been submitted.
+    std::vector<std::pair<SINT, ReadRequestPriority>> takeReadRequests() {
+        std::vector<std::pair<SINT, ReadRequestPriority>> requests;
+        CachingReaderChunkReadRequest request;
+        while (m_pReader->m_chunkReadRequestFIFO.read(&request, 1) == 1) {
+            requests.emplace_back(request.chunk->getIndex(), request.priority);
+        }
+        return requests;
+    }
+
+    EngineWorkerScheduler m_scheduler;
+    std::unique_ptr<CachingReader> m_pReader;
+};
+
+TEST_F(CachingReaderTest, PreloadLeavesRoomForHints) {
+    loadTrack(kNumChunks);
+
+    // The preload requests are submitted with the hints of each callback
+    for (int i = 0; i < 10; ++i) {
+        m_pReader->hintAndMaybeWake(HintVector());
+    }
+    EXPECT_TRUE(isChunkRequested(0));
+    EXPECT_FALSE(isChunkRequested(kNumChunks / 2));
+
+    // The hints still get through although the worker hasn't caught up
+    HintVector hints;
+    hints.append(hintForChunks(Hint::Type::CurrentPosition, 90, 3));
+    hints.append(hintForChunks(Hint::Type::SlipPosition, 95));
+    hints.append(hintForChunks(Hint::Type::HotCue, 97));
+    m_pReader->hintAndMaybeWake(hints);
+    for (const SINT chunkIndex : {90, 91, 92, 95, 97}) {
+        EXPECT_TRUE(isChunkRequested(chunkIndex)) << "chunk " << chunkIndex;
+    }
+}
+
+TEST_F(CachingReaderTest, HintPriorities) {
+    // The play position is needed for the next callback, an enabled loop
+    // jumps back to its start when reaching the end, and the remaining
+    // cue points and markers are only needed when the user requests it.
+    EXPECT_EQ(ReadRequestPriority::Playback, Hint::priority(Hint::Type::SlipPosition));
+    EXPECT_EQ(ReadRequestPriority::Playback, Hint::priority(Hint::Type::CurrentPosition));
+    EXPECT_EQ(ReadRequestPriority::Loop, Hint::priority(Hint::Type::LoopStartEnabled));
+    EXPECT_EQ(ReadRequestPriority::Cue, Hint::priority(Hint::Type::MainCue));
+    EXPECT_EQ(ReadRequestPriority::Cue, Hint::priority(Hint::Type::HotCue));
+    EXPECT_EQ(ReadRequestPriority::Cue, Hint::priority(Hint::Type::LoopEndEnabled));
+    EXPECT_EQ(ReadRequestPriority::Cue, Hint::priority(Hint::Type::LoopStart));
+    EXPECT_EQ(ReadRequestPriority::Marker, Hint::priority(Hint::Type::FirstSound));
+    EXPECT_EQ(ReadRequestPriority::Marker, Hint::priority(Hint::Type::IntroStart));
+    EXPECT_EQ(ReadRequestPriority::Marker, Hint::priority(Hint::Type::IntroEnd));
+    EXPECT_EQ(ReadRequestPriority::Marker, Hint::priority(Hint::Type::OutroStart));
+}
+
+TEST_F(CachingReaderTest, HintsAreRequestedByPriority) {
+    loadTrack(kNumChunks);
+
+    // In reverse order of their priority
+    HintVector hints;
+    hints.append(hintForChunks(Hint::Type::OutroStart, 50));
+    hints.append(hintForChunks(Hint::Type::LoopEndEnabled, 40));
+    hints.append(hintForChunks(Hint::Type::HotCue, 30));
+    hints.append(hintForChunks(Hint::Type::LoopStartEnabled, 20));
+    hints.append(hintForChunks(Hint::Type::CurrentPosition, 10));
+    m_pReader->hintAndMaybeWake(hints);
+
+    const std::vector<std::pair<SINT, ReadRequestPriority>> expectedRequests = {
+            {10, ReadRequestPriority::Playback},
+            {20, ReadRequestPriority::Loop},
+            // Equal priorities keep the order of the hints
+            {40, ReadRequestPriority::Cue},
+            {30, ReadRequestPriority::Cue},
+            {50, ReadRequestPriority::Marker},
+    };
+    auto requests = takeReadRequests();
+    // Followed by the preload requests
+    ASSERT_LE(expectedRequests.size(), requests.size());
+    for (auto it = requests.begin() + expectedRequests.size(); it != requests.end(); ++it) {
+        EXPECT_EQ(ReadRequestPriority::Preload, it->second);
+    }
+    requests.resize(expectedRequests.size());
+    EXPECT_EQ(expectedRequests, requests);
+}
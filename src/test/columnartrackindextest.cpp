@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+#include <algorithm>
+
+#include "library/basetrackcache.h"
+#include "library/columnartrackindex.h"
+#include "library/columncache.h"
+#include "library/dao/trackschema.h"
+#include "library/searchquery.h"
+#include "library/searchqueryparser.h"
+#include "test/librarytest.h"
+
+namespace {
+
+using ColumnType = ColumnarTrackIndex::ColumnType;
+
+const QStringList kColumns = {
+        LIBRARYTABLE_ID,
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_YEAR,
+        LIBRARYTABLE_TRACKNUMBER,
+        LIBRARYTABLE_BPM,
+        LIBRARYTABLE_KEY,
+        LIBRARYTABLE_KEY_ID,
+        LIBRARYTABLE_DATETIMEADDED,
+};
+
+class ColumnarTrackIndexTest : public LibraryTest {
+  protected:
+    ColumnarTrackIndexTest()
+            : m_columnCache(kColumns),
+              m_parser(internalCollection(),
+                      {LIBRARYTABLE_ARTIST, LIBRARYTABLE_TITLE}),
+              m_index(m_columnCache,
+                      {
+                              ColumnType::Number,
+                              ColumnType::Text,
+                              ColumnType::Text,
+                              ColumnType::Text,
+                              ColumnType::IntegerText,
+                              ColumnType::Number,
+                              ColumnType::Key,
+                              ColumnType::Number,
+                              ColumnType::Text,
+                      }) {
+    }
+
+    void insertTrack(int id,
+            const QVariant& artist,
+            const QString& title,
+            const QString& year,
+            const QString& trackNumber,
+            const QVariant& bpm,
+            const QVariant& dateAdded = QVariant()) {
+        m_index.insertOrUpdate(TrackId(QVariant(id)),
+                {id,
+                        artist,
+                        title,
+                        year,
+                        trackNumber,
+                        bpm,
+                        QVariant(),
+                        QVariant(),
+                        dateAdded});
+        m_trackIds.insert(TrackId(QVariant(id)));
+    }
+
+    QVector<TrackId> filterAndSort(
+            const QString& query, const QList<SortColumn>& sortColumns = {}) {
+        const auto pQuery = m_parser.parseQuery(query, QString());
+        EXPECT_TRUE(pQuery->prepareRecordMatching());
+        return m_index.filterAndSort(
+                m_trackIds, *pQuery, sortColumns, KeyUtils::KeyNotation::Custom);
+    }
+
+    static QVector<TrackId> trackIds(std::initializer_list<int> ids) {
+        QVector<TrackId> trackIds;
+        for (const int id : ids) {
+            trackIds.append(TrackId(QVariant(id)));
+        }
+        return trackIds;
+    }
+
+    ColumnCache m_columnCache;
+    SearchQueryParser m_parser;
+    ColumnarTrackIndex m_index;
+    QSet<TrackId> m_trackIds;
+};
+
+TEST_F(ColumnarTrackIndexTest, Filter) {
+    insertTrack(1, "Daft Punk", "Around the World", "1997", "7", 121.0);
+    insertTrack(2, "Röyksopp", "Eple", "2001-03-05", "3/12", 105.0);
+    insertTrack(3, QVariant(), "Untitled", "", "", QVariant());
+
+    auto sorted = [this](const QString& query) {
+        auto result = filterAndSort(query);
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    EXPECT_EQ(trackIds({1, 2, 3}), sorted(QString()));
+    // Case and accent insensitive like the SQL LIKE of DbConnection
+    EXPECT_EQ(trackIds({2}), sorted("royk"));
+    EXPECT_EQ(trackIds({1}), sorted("WORLD"));
+    EXPECT_EQ(trackIds({1, 2}), sorted("bpm:>100"));
+    EXPECT_EQ(trackIds({2}), sorted("year:2001"));
+    EXPECT_EQ(trackIds({3}), sorted("artist:\"\""));
+    EXPECT_EQ(trackIds({1, 2}), sorted("-untitled"));
+    // Only the given tracks are filtered
+    m_trackIds.remove(TrackId(QVariant(1)));
+    EXPECT_EQ(trackIds({2}), sorted("bpm:>100"));
+}
+
+TEST_F(ColumnarTrackIndexTest, FilterDateAdded) {
+    // The database stores the UTC time without a time zone. The dates
+    // of the query are local dates like in the SQL query.
+    const auto utcText = [](const QDate& date, const QTime& time) {
+        QString text = QDateTime(date, time).toUTC().toString(Qt::ISODateWithMs);
+        text.chop(1); // 'Z'
+        return text;
+    };
+    const QDate date(2025, 10, 25);
+    insertTrack(1, "a", "x", "", "", QVariant(), utcText(date.addDays(-1), QTime(23, 30)));
+    insertTrack(2, "b", "y", "", "", QVariant(), utcText(date, QTime(0, 30)));
+    insertTrack(3, "c", "z", "", "", QVariant(), utcText(date, QTime(23, 30)));
+    insertTrack(4, "d", "w", "", "", QVariant(), utcText(date.addDays(1), QTime(0, 30)));
+
+    auto sorted = [this](const QString& query) {
+        auto result = filterAndSort(query);
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    EXPECT_EQ(trackIds({2, 3}), sorted("added:2025-10-25"));
+    EXPECT_EQ(trackIds({2, 3}), sorted("dateadded:2025-10-25"));
+    EXPECT_EQ(trackIds({1}), sorted("added:<2025-10-25"));
+    EXPECT_EQ(trackIds({4}), sorted("added:>2025-10-25"));
+    EXPECT_EQ(trackIds({2, 3, 4}), sorted("date_added:>=2025-10-25"));
+}
+
+TEST_F(ColumnarTrackIndexTest, SqlNodeIsNotPrepared) {
+    const auto pQuery = m_parser.parseQuery("artist:foo", "bpm > 100");
+    EXPECT_FALSE(pQuery->prepareRecordMatching());
+}
+
+TEST_F(ColumnarTrackIndexTest, Sort) {
+    insertTrack(1, "b", "x", "", "10", 120.0);
+    insertTrack(2, "A", "y", "", "9", QVariant());
+    insertTrack(3, QVariant(), "z", "", "", 90.0);
+    insertTrack(4, "c", "w", "", "2/3", 120.0);
+
+    const int artist = m_columnCache.fieldIndex(LIBRARYTABLE_ARTIST);
+    const int trackNumber = m_columnCache.fieldIndex(LIBRARYTABLE_TRACKNUMBER);
+    const int bpm = m_columnCache.fieldIndex(LIBRARYTABLE_BPM);
+
+    // NULL first and case insensitive
+    EXPECT_EQ(trackIds({3, 2, 1, 4}),
+            filterAndSort(QString(), {SortColumn(artist, Qt::AscendingOrder)}));
+    EXPECT_EQ(trackIds({4, 1, 2, 3}),
+            filterAndSort(QString(), {SortColumn(artist, Qt::DescendingOrder)}));
+    // By the leading number
+    EXPECT_EQ(trackIds({3, 4, 2, 1}),
+            filterAndSort(QString(), {SortColumn(trackNumber, Qt::AscendingOrder)}));
+    // The second column decides for equal values
+    EXPECT_EQ(trackIds({4, 1, 3, 2}),
+            filterAndSort(QString(),
+                    {SortColumn(bpm, Qt::DescendingOrder),
+                            SortColumn(artist, Qt::DescendingOrder)}));
+}
+
+TEST_F(ColumnarTrackIndexTest, UpdateAndRemove) {
+    const int artist = m_columnCache.fieldIndex(LIBRARYTABLE_ARTIST);
+    insertTrack(1, "a", "x", "", "", 120.0);
+    insertTrack(2, "b", "y", "", "", 120.0);
+    EXPECT_EQ(trackIds({1, 2}),
+            filterAndSort(QString(), {SortColumn(artist, Qt::AscendingOrder)}));
+
+    // The cached sort key is replaced
+    insertTrack(1, "c", "x", "", "", 120.0);
+    EXPECT_EQ(trackIds({2, 1}),
+            filterAndSort(QString(), {SortColumn(artist, Qt::AscendingOrder)}));
+    EXPECT_EQ(trackIds({1}), filterAndSort("artist:c"));
+
+    m_index.remove(TrackId(QVariant(1)));
+    EXPECT_EQ(1, m_index.size());
+    EXPECT_EQ(trackIds({2}), filterAndSort(QString()));
+
+    // Reuses the row of the removed track
+    insertTrack(3, "a", "z", "", "", 120.0);
+    EXPECT_EQ(2, m_index.size());
+    EXPECT_EQ(trackIds({3, 2}),
+            filterAndSort(QString(), {SortColumn(artist, Qt::AscendingOrder)}));
+}
+
+TEST_F(ColumnarTrackIndexTest, SortManyTracksConcurrently) {
+    constexpr int kNumTracks = 100000;
+    for (int id = 1; id <= kNumTracks; ++id) {
+        // Many duplicate values to test the order of equal values
+        insertTrack(id,
+                QStringLiteral("Artist %1").arg(id % 1000),
+                QString(),
+                QString(),
+                QString(),
+                static_cast<double>((id * 7919) % 200));
+    }
+    const int bpm = m_columnCache.fieldIndex(LIBRARYTABLE_BPM);
+
+    const auto sorted = filterAndSort(
+            "artist:9", {SortColumn(bpm, Qt::AscendingOrder)});
+
+    QVector<TrackId> expected;
+    for (int id = 1; id <= kNumTracks; ++id) {
+        if (QString::number(id % 1000).contains('9')) {
+            expected.append(TrackId(QVariant(id)));
+        }
+    }
+    std::sort(expected.begin(), expected.end(), [](TrackId lhs, TrackId rhs) {
+        const int lhsBpm = (lhs.toVariant().toInt() * 7919) % 200;
+        const int rhsBpm = (rhs.toVariant().toInt() * 7919) % 200;
+        if (lhsBpm != rhsBpm) {
+            return lhsBpm < rhsBpm;
+        }
+        return lhs < rhs;
+    });
+    EXPECT_EQ(expected, sorted);
+}
+
+} // namespace
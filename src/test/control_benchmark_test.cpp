@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "control/control.h"
+#include "control/controlobject.h"
+
+namespace {
+
+// Benchmarks of ControlDoublePrivate::getControl() from multiple threads,
+// like controller scripts and skins that look up controls by key.
+
+constexpr int kNumControls = 4096;
+
+// Only created and destroyed by the first thread. The other threads wait
+// for it at the start and the end of the benchmark loop.
+std::vector<std::unique_ptr<ControlObject>> s_controls;
+std::vector<ConfigKey> s_keys;
+
+void setUpControls(const benchmark::State& state) {
+    if (state.thread_index() != 0) {
+        return;
+    }
+    s_controls.reserve(kNumControls);
+    s_keys.reserve(kNumControls);
+    for (int i = 0; i < kNumControls; ++i) {
+        const ConfigKey key(QStringLiteral("[Channel%1]").arg(i % 8 + 1),
+                QStringLiteral("control%1").arg(i));
+        s_controls.push_back(std::make_unique<ControlObject>(key));
+        s_keys.push_back(key);
+    }
+}
+
+void tearDownControls(const benchmark::State& state) {
+    if (state.thread_index() != 0) {
+        return;
+    }
+    s_controls.clear();
+    s_keys.clear();
+}
+
+void BM_ControlLookup(benchmark::State& state) {
+    setUpControls(state);
+    // Each thread starts at a different key
+    int index = state.thread_index() * 97;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ControlDoublePrivate::getControl(
+                s_keys[index % kNumControls]));
+        ++index;
+    }
+    state.SetItemsProcessed(state.iterations());
+    tearDownControls(state);
+}
+BENCHMARK(BM_ControlLookup)->ThreadRange(1, 8)->UseRealTime();
+
+// The first thread keeps creating and deleting controls like while
+// loading a skin, the other threads only look up existing controls.
+void BM_ControlLookupWhileCreating(benchmark::State& state) {
+    setUpControls(state);
+    int index = state.thread_index() * 97;
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            ControlObject control(ConfigKey(
+                    QStringLiteral("[Skin]"),
+                    QStringLiteral("control%1").arg(index % kNumControls)));
+            benchmark::DoNotOptimize(control.get());
+        } else {
+            benchmark::DoNotOptimize(ControlDoublePrivate::getControl(
+                    s_keys[index % kNumControls]));
+        }
+        ++index;
+    }
+    state.SetItemsProcessed(state.iterations());
+    tearDownControls(state);
+}
+BENCHMARK(BM_ControlLookupWhileCreating)->ThreadRange(2, 8)->UseRealTime();
+
+} // namespace
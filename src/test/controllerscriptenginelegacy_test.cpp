@@ -1073,6 +1073,100 @@ TEST_F(ControllerScriptEngineLegacyTest, screenWillSentRawDataIfConfigured) {
 
     ASSERT_ALL_EXPECTED_MSG();
 }
+
+TEST_F(ControllerScriptEngineLegacyTest, screenTransformReceivesChangedAreas) {
+    LegacyControllerMapping::ScreenInfo dummyScreen{
+            "",                                                    // identifier
+            QSize(4, 3),                                           // size
+            10,                                                    // target_fps
+            1,                                                     // msaa
+            std::chrono::milliseconds(10),                         // splash_off
+            QImage::Format_RGB16,                                  // pixelFormat
+            LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
+            false,                                                 // reversedColor
+            false                                                  // rawData
+    };
+    // Allocate screen on the heap as it need to outlive the this function,
+    // since the engine will take ownership of it
+    std::shared_ptr<MockScreenRender> pDummyRender =
+            std::make_shared<MockScreenRender>(dummyScreen);
+    EXPECT_CALL(*pDummyRender, requestSendingFrameData(_, QByteArray())).Times(3);
+
+    renderingScreens().insert(dummyScreen.identifier, pDummyRender);
+    auto pRootItem = std::make_unique<mixxx::qml::QmlMixxxControllerScreen>();
+    pRootItem->setTransform(evaluate(
+            "(function(input, timestamp, changedAreas) {"
+            "    lastChangedAreas = JSON.stringify(changedAreas);"
+            "    return new ArrayBuffer(0);"
+            "})"));
+    rootItems().emplace(dummyScreen.identifier, std::move(pRootItem));
+
+    QImage frame(dummyScreen.size, dummyScreen.pixelFormat);
+    frame.fill(Qt::black);
+    testHandleScreen(dummyScreen, frame, QDateTime::currentDateTime());
+    EXPECT_QSTRING_EQ(
+            QStringLiteral(R"([{"x":0,"y":0,"width":4,"height":3}])"),
+            evaluate("lastChangedAreas").toString());
+
+    QImage changedFrame = frame.copy();
+    changedFrame.setPixelColor(2, 1, Qt::white);
+    testHandleScreen(dummyScreen, changedFrame, QDateTime::currentDateTime());
+    EXPECT_QSTRING_EQ(
+            QStringLiteral(R"([{"x":0,"y":1,"width":4,"height":1}])"),
+            evaluate("lastChangedAreas").toString());
+
+    testHandleScreen(dummyScreen, changedFrame.copy(), QDateTime::currentDateTime());
+    EXPECT_QSTRING_EQ(QStringLiteral("[]"), evaluate("lastChangedAreas").toString());
+}
+
+TEST_F(ControllerScriptEngineLegacyTest, screenChangedAreasAfterFailedTransform) {
+    LegacyControllerMapping::ScreenInfo dummyScreen{
+            "",                                                    // identifier
+            QSize(4, 3),                                           // size
+            10,                                                    // target_fps
+            1,                                                     // msaa
+            std::chrono::milliseconds(10),                         // splash_off
+            QImage::Format_RGB16,                                  // pixelFormat
+            LegacyControllerMapping::ScreenInfo::ColorEndian::Big, // endian
+            false,                                                 // reversedColor
+            false                                                  // rawData
+    };
+    // Allocate screen on the heap as it need to outlive the this function,
+    // since the engine will take ownership of it
+    std::shared_ptr<MockScreenRender> pDummyRender =
+            std::make_shared<MockScreenRender>(dummyScreen);
+    EXPECT_CALL(*pDummyRender, requestSendingFrameData(_, QByteArray())).Times(2);
+
+    renderingScreens().insert(dummyScreen.identifier, pDummyRender);
+    auto pRootItem = std::make_unique<mixxx::qml::QmlMixxxControllerScreen>();
+    pRootItem->setTransform(evaluate(
+            "(function(input, timestamp, changedAreas) {"
+            "    lastChangedAreas = JSON.stringify(changedAreas);"
+            "    if (failTransform) {"
+            "        return undefined;"
+            "    }"
+            "    return new ArrayBuffer(0);"
+            "})"));
+    rootItems().emplace(dummyScreen.identifier, std::move(pRootItem));
+
+    QImage frame(dummyScreen.size, dummyScreen.pixelFormat);
+    frame.fill(Qt::black);
+    evaluate("failTransform = false;");
+    testHandleScreen(dummyScreen, frame, QDateTime::currentDateTime());
+
+    QImage changedFrame = frame.copy();
+    changedFrame.setPixelColor(2, 1, Qt::white);
+    evaluate("failTransform = true;");
+    testHandleScreen(dummyScreen, changedFrame, QDateTime::currentDateTime());
+
+    // The changes are still reported relative to the last frame that has
+    // been transformed successfully
+    evaluate("failTransform = false;");
+    testHandleScreen(dummyScreen, changedFrame.copy(), QDateTime::currentDateTime());
+    EXPECT_QSTRING_EQ(
+            QStringLiteral(R"([{"x":0,"y":1,"width":4,"height":1}])"),
+            evaluate("lastChangedAreas").toString());
+}
 #endif
 
 TEST_F(ControllerScriptEngineLegacyTimerTest, beginTimer_repeatedTimer) {
@@ -37,6 +37,22 @@ TEST_F(ControlObjectTest, getControl) {
             (ControlObject*)nullptr);
 }
 
+TEST_F(ControlObjectTest, getControlAfterRecreation) {
+    // The first lookup caches the control for this thread
+    EXPECT_EQ(ControlObject::getControl(ck2), co2.get());
+    co2.reset();
+    co2 = std::make_unique<ControlObject>(ck2);
+    EXPECT_EQ(ControlObject::getControl(ck2), co2.get());
+}
+
+TEST_F(ControlObjectTest, getControlAfterTakeAllInstances) {
+    EXPECT_EQ(ControlObject::getControl(ck1), co1.get());
+    // The controls are still alive, but must not be found anymore
+    const auto controls = ControlDoublePrivate::takeAllInstances();
+    EXPECT_EQ(ControlObject::getControl(ck1, ControlFlag::NoAssertIfMissing),
+            (ControlObject*)nullptr);
+}
+
 TEST_F(ControlObjectTest, AliasRetrieval) {
     ConfigKey ck("[Microphone1]", "volume");
     ConfigKey ckAlias("[Microphone]", "volume");
@@ -0,0 +1,62 @@
+#include "effects/backends/effectstatepool.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace {
+
+class TestState {
+  public:
+    explicit TestState(int* pLiveCount)
+            : m_pLiveCount(pLiveCount) {
+        ++(*m_pLiveCount);
+    }
+    ~TestState() {
+        --(*m_pLiveCount);
+    }
+
+    void clear() {
+        value = 0;
+    }
+
+    int value = 0;
+
+  private:
+    int* m_pLiveCount;
+};
+
+static_assert(RecyclableEffectState<TestState>);
+static_assert(!RecyclableEffectState<int>);
+
+TEST(EffectStatePoolTest, RecyclesReleasedStates) {
+    int liveCount = 0;
+    {
+        EffectStatePool<TestState> pool;
+        EXPECT_EQ(nullptr, pool.acquire());
+
+        auto* pState = new TestState(&liveCount);
+        pool.release(pState);
+        EXPECT_EQ(1, pool.size());
+        EXPECT_EQ(pState, pool.acquire());
+        EXPECT_EQ(0, pool.size());
+        EXPECT_EQ(nullptr, pool.acquire());
+        pool.release(pState);
+    }
+    // The pool deletes the retained states
+    EXPECT_EQ(0, liveCount);
+}
+
+TEST(EffectStatePoolTest, DeletesStatesWhenFull) {
+    int liveCount = 0;
+    auto pPool = std::make_unique<EffectStatePool<TestState>>();
+    for (int i = 0; i < EffectStatePool<TestState>::kCapacity + 3; ++i) {
+        pPool->release(new TestState(&liveCount));
+    }
+    EXPECT_EQ(EffectStatePool<TestState>::kCapacity, pPool->size());
+    EXPECT_EQ(EffectStatePool<TestState>::kCapacity, liveCount);
+    pPool.reset();
+    EXPECT_EQ(0, liveCount);
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <QTest>
+#include <QThread>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "test/signalpathtest.h"
+#include "track/beats.h"
+
+namespace {
+
+constexpr int kNumWarmUpBuffers = 8;
+constexpr int kNumBuffers = 32;
+
+/// Three sync enabled decks with different tempos and rates, that are processed
+/// either serially or in parallel by the EngineChannelWorkerPool.
+class SyncedDecksSignalPath : public BaseSignalPathTest {
+  public:
+    explicit SyncedDecksSignalPath(bool multithreadedChannels)
+            : BaseSignalPathTest(multithreadedChannels) {
+        SetUp();
+        loadTrackWithTempo(m_pMixerDeck1, mixxx::Bpm(120));
+        loadTrackWithTempo(m_pMixerDeck2, mixxx::Bpm(124));
+        loadTrackWithTempo(m_pMixerDeck3, mixxx::Bpm(128));
+    }
+
+    ~SyncedDecksSignalPath() override {
+        TearDown();
+    }
+
+    /// Returns the main output of all callbacks
+    std::vector<CSAMPLE> play() {
+        const double rates[] = {0.05, -0.02, 0.0};
+        const QString groups[] = {m_sGroup1, m_sGroup2, m_sGroup3};
+        for (int i = 0; i < 3; ++i) {
+            ControlObject::set(ConfigKey(groups[i], QStringLiteral("rate")), rates[i]);
+            // The sync requests of paused decks are processed immediately,
+            // so both modes start from the same sync state.
+            ControlObject::set(ConfigKey(groups[i], QStringLiteral("sync_enabled")), 1.0);
+        }
+        // Give the reader threads a chance to fill the caches, so that both
+        // modes play the same audio.
+        for (int i = 0; i < kNumWarmUpBuffers; ++i) {
+            ProcessBuffer();
+            QTest::qSleep(5);
+        }
+        for (const auto& group : groups) {
+            ControlObject::set(ConfigKey(group, QStringLiteral("play")), 1.0);
+        }
+
+        std::vector<CSAMPLE> output;
+        output.reserve(kNumBuffers * kProcessBufferSize);
+        for (int i = 0; i < kNumBuffers; ++i) {
+            ProcessBuffer();
+            const auto buffer = m_pEngineMixer->getMainBuffer();
+            output.insert(output.end(), buffer.begin(), buffer.begin() + kProcessBufferSize);
+            QTest::qSleep(5);
+        }
+        return output;
+    }
+
+  protected:
+    void TestBody() override {
+    }
+
+  private:
+    void loadTrackWithTempo(Deck* pDeck, mixxx::Bpm bpm) {
+        TrackPointer pTrack = Track::newTemporary(
+                getTestDir().filePath(QStringLiteral("sine-30.wav")));
+        loadTrack(pDeck, pTrack);
+        pTrack->trySetBeats(mixxx::Beats::fromConstTempo(
+                pTrack->getSampleRate(), mixxx::audio::kStartFramePos, bpm));
+    }
+};
+
+} // namespace
+
+TEST(EngineChannelWorkerPoolTest, ParallelProcessingMatchesSerialWithSync) {
+    if (QThread::idealThreadCount() < 2) {
+        GTEST_SKIP() << "Channels are only processed in parallel with multiple cores";
+    }
+    std::vector<CSAMPLE> serialOutput;
+    {
+        SyncedDecksSignalPath signalPath(false);
+        serialOutput = signalPath.play();
+    }
+    std::vector<CSAMPLE> parallelOutput;
+    {
+        SyncedDecksSignalPath signalPath(true);
+        parallelOutput = signalPath.play();
+    }
+
+    ASSERT_EQ(serialOutput.size(), parallelOutput.size());
+    for (std::size_t i = 0; i < serialOutput.size(); ++i) {
+        ASSERT_NEAR(serialOutput[i], parallelOutput[i], 0.0001) << "at sample " << i;
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "engine/filters/enginefilterbessel4.h"
+#include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterlinkwitzriley8.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+constexpr auto kSampleRate = mixxx::audio::SampleRate(44100);
+constexpr std::size_t kBufferSize = 1024;
+constexpr int kBufferCount = 8;
+
+/// Processes both channels one after another with the scalar
+/// implementation of the filter, like before processing them
+/// in parallel lanes.
+template<class Filter>
+class ScalarFilter : public Filter {
+  public:
+    using Filter::Filter;
+
+    void processScalar(const CSAMPLE* pIn, CSAMPLE* pOutput, std::size_t bufferSize) {
+        for (std::size_t i = 0; i < bufferSize; i += 2) {
+            pOutput[i] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_buf1, static_cast<double>(pIn[i])));
+            pOutput[i + 1] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, m_buf2, static_cast<double>(pIn[i + 1])));
+        }
+    }
+
+  private:
+    // Large enough for all filters
+    double m_buf1[16]{};
+    double m_buf2[16]{};
+};
+
+class EngineFilterIIRTest : public testing::Test {
+  protected:
+    EngineFilterIIRTest()
+            : m_input(kBufferSize * kBufferCount) {
+        // Different signals on both channels
+        std::mt19937 gen; // explicitly don't seed for reproducibility
+        std::uniform_real_distribution<CSAMPLE> dis(-1.0f, 1.0f);
+        for (SINT i = 0; i < m_input.size(); i += 2) {
+            m_input[i] = static_cast<CSAMPLE>(std::sin(i * 0.01));
+            m_input[i + 1] = dis(gen);
+        }
+    }
+
+    template<class Filter>
+    void expectEqualsScalar(ScalarFilter<Filter>* pFilter, ScalarFilter<Filter>* pReference) {
+        // No cross fading from the initial state
+        pFilter->assumeSettled();
+        mixxx::SampleBuffer output(kBufferSize);
+        mixxx::SampleBuffer expected(kBufferSize);
+        for (int i = 0; i < kBufferCount; ++i) {
+            const CSAMPLE* pIn = &m_input[i * kBufferSize];
+            pFilter->process(pIn, output.data(), kBufferSize);
+            pReference->processScalar(pIn, expected.data(), kBufferSize);
+            for (std::size_t j = 0; j < kBufferSize; ++j) {
+                ASSERT_FLOAT_EQ(expected[j], output[j]) << "buffer " << i << " sample " << j;
+            }
+        }
+    }
+
+    mixxx::SampleBuffer m_input;
+};
+
+TEST_F(EngineFilterIIRTest, Bessel4LowEqualsScalar) {
+    ScalarFilter<EngineFilterBessel4Low> filter(kSampleRate, 250);
+    ScalarFilter<EngineFilterBessel4Low> reference(kSampleRate, 250);
+    expectEqualsScalar(&filter, &reference);
+}
+
+TEST_F(EngineFilterIIRTest, Bessel4BandEqualsScalar) {
+    ScalarFilter<EngineFilterBessel4Band> filter(kSampleRate, 250, 2500);
+    ScalarFilter<EngineFilterBessel4Band> reference(kSampleRate, 250, 2500);
+    expectEqualsScalar(&filter, &reference);
+}
+
+TEST_F(EngineFilterIIRTest, Bessel4HighEqualsScalar) {
+    ScalarFilter<EngineFilterBessel4High> filter(kSampleRate, 2500);
+    ScalarFilter<EngineFilterBessel4High> reference(kSampleRate, 2500);
+    expectEqualsScalar(&filter, &reference);
+}
+
+TEST_F(EngineFilterIIRTest, LinkwitzRiley8EqualsScalar) {
+    ScalarFilter<EngineFilterLinkwitzRiley8Low> low(kSampleRate, 250);
+    ScalarFilter<EngineFilterLinkwitzRiley8Low> lowReference(kSampleRate, 250);
+    expectEqualsScalar(&low, &lowReference);
+    ScalarFilter<EngineFilterLinkwitzRiley8High> high(kSampleRate, 2500);
+    ScalarFilter<EngineFilterLinkwitzRiley8High> highReference(kSampleRate, 2500);
+    expectEqualsScalar(&high, &highReference);
+}
+
+TEST_F(EngineFilterIIRTest, Biquad1PeakingEqualsScalar) {
+    ScalarFilter<EngineFilterBiquad1Peaking> filter(kSampleRate, 1000, 1.75);
+    ScalarFilter<EngineFilterBiquad1Peaking> reference(kSampleRate, 1000, 1.75);
+    expectEqualsScalar(&filter, &reference);
+}
+
+} // namespace
@@ -0,0 +1,311 @@
+#include <benchmark/benchmark.h>
+
+#include <QTest>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "engine/engine.h"
+#include "test/signalpathtest.h"
+#include "track/beats.h"
+
+namespace {
+
+// End-to-end benchmarks of the engine callback. Each benchmark iteration
+// is one EngineMixer::process() call with all decks playing a short loop,
+// like the sound device would request it. Besides the mean reported by the
+// benchmark library the latency percentiles of the individual callbacks are
+// reported as counters, because the realtime behavior is determined by the
+// outliers and not by the average.
+
+const QString kAppGroup = QStringLiteral("[App]");
+
+const QString kTrackFile = QStringLiteral("sine-30.wav");
+#ifdef __STEM__
+const QString kStemFile = QStringLiteral("stems/sin_ALAC_24bit.stem.mp4");
+#endif
+
+// The loop must be short enough to fit into the CachingReader cache,
+// otherwise the callbacks would measure cache misses that are answered
+// with silence instead of the actual processing.
+constexpr double kLoopBeats = 4;
+constexpr double kBaseBpm = 120;
+
+// The warm up runs with paced callbacks to give the reader threads a chance
+// to fill the caches.
+constexpr SINT kWarmUpFrames = 1024;
+constexpr int kWarmUpLoops = 2;
+
+enum class Scenario {
+    Plain,
+    KeylockSoundTouch,
+#ifdef __RUBBERBAND__
+    KeylockRubberBandFaster,
+    KeylockRubberBandFiner,
+#endif
+    Sync,
+    Effects,
+#ifdef __STEM__
+    Stems,
+#endif
+};
+
+class EngineCallbackBenchmark : public BaseSignalPathTest {
+  public:
+    EngineCallbackBenchmark(Scenario scenario, int numDecks)
+            : m_scenario(scenario) {
+        SetUp();
+        m_decks = {m_pMixerDeck1, m_pMixerDeck2, m_pMixerDeck3};
+        for (int i = static_cast<int>(m_decks.size()); i < numDecks; ++i) {
+            addExtraDeck(QStringLiteral("[Channel%1]").arg(i + 1));
+        }
+        m_decks.resize(numDecks);
+
+        if (m_scenario == Scenario::Effects) {
+            setupEffects();
+        }
+#ifdef __STEM__
+        if (m_scenario == Scenario::Stems) {
+            setupStemHandles();
+        }
+#endif
+        for (int i = 0; i < numDecks; ++i) {
+            loadLoopingTrack(m_decks[i], i);
+        }
+        warmUp();
+    }
+
+    ~EngineCallbackBenchmark() override {
+        // The extra decks must be deleted before the base class deletes the
+        // engine mixer, just like the regular decks
+        m_extraDecks.clear();
+        TearDown();
+    }
+
+    void process(SINT frames) {
+        m_pEngineMixer->process(frames * mixxx::kEngineChannelOutputCount);
+    }
+
+    double sampleRate() const {
+        return ControlObject::get(ConfigKey(kAppGroup, QStringLiteral("samplerate")));
+    }
+
+  protected:
+    void TestBody() override {
+    }
+
+  private:
+    void addExtraDeck(const QString& group) {
+        auto pDeck = std::make_unique<Deck>(nullptr,
+                m_pConfig,
+                m_pEngineMixer,
+                m_pEffectsManager,
+                EngineChannel::CENTER,
+                m_pEngineMixer->registerChannelGroup(group));
+        addDeck(pDeck->getEngineDeck());
+        m_decks.push_back(pDeck.get());
+        m_extraDecks.push_back(std::move(pDeck));
+    }
+
+    void setupEffects() {
+        // Same order as in PlayerManager and CoreServices: the EQ and
+        // QuickEffect chains of all decks are created before the default
+        // chain presets are loaded.
+        for (const auto* pDeck : m_decks) {
+            m_pEffectsManager->addDeck(
+                    m_pEngineMixer->registerChannelGroup(pDeck->getGroup()));
+        }
+        m_pEffectsManager->setup();
+        for (const auto* pDeck : m_decks) {
+            const QString& group = pDeck->getGroup();
+            ControlObject::set(ConfigKey(QStringLiteral("[QuickEffectRack1_%1]")
+                                               .arg(group),
+                                       QStringLiteral("enabled")),
+                    1.0);
+            ControlObject::set(ConfigKey(QStringLiteral("[EffectRack1_EffectUnit1]"),
+                                       QStringLiteral("group_%1_enable").arg(group)),
+                    1.0);
+        }
+        ControlObject::set(ConfigKey(QStringLiteral("[EffectRack1_EffectUnit1]"),
+                                   QStringLiteral("enabled")),
+                1.0);
+    }
+
+#ifdef __STEM__
+    void setupStemHandles() {
+        for (const auto* pDeck : m_decks) {
+            const QString& group = pDeck->getGroup();
+            for (int i = 1; i <= mixxx::kMaxSupportedStems; ++i) {
+                const ChannelHandleAndGroup stemHandleGroup =
+                        m_pEngineMixer->registerChannelGroup(group.chopped(1) +
+                                QStringLiteral("_Stem%1]").arg(i));
+                pDeck->getEngineDeck()->addStemHandle(stemHandleGroup);
+                m_pEffectsManager->addStem(stemHandleGroup);
+            }
+        }
+    }
+#endif
+
+    void loadLoopingTrack(Deck* pDeck, int deckIndex) {
+        QString fileName = kTrackFile;
+#ifdef __STEM__
+        if (m_scenario == Scenario::Stems) {
+            fileName = kStemFile;
+        }
+#endif
+        TrackPointer pTrack = Track::newTemporary(getTestDir().filePath(fileName));
+        loadTrack(pDeck, pTrack);
+
+        // Use different tempos per deck to let sync actually adjust the
+        // rate of the followers
+        const double bpm = m_scenario == Scenario::Sync
+                ? kBaseBpm + 2 * deckIndex
+                : kBaseBpm;
+        pTrack->trySetBeats(mixxx::Beats::fromConstTempo(pTrack->getSampleRate(),
+                mixxx::audio::kStartFramePos,
+                mixxx::Bpm(bpm)));
+
+        const QString& group = pDeck->getGroup();
+        switch (m_scenario) {
+        case Scenario::KeylockSoundTouch:
+#ifdef __RUBBERBAND__
+        case Scenario::KeylockRubberBandFaster:
+        case Scenario::KeylockRubberBandFiner:
+#endif
+            ControlObject::set(ConfigKey(kAppGroup, QStringLiteral("keylock_engine")),
+                    static_cast<double>(keylockEngine()));
+            ControlObject::set(ConfigKey(group, QStringLiteral("keylock")), 1.0);
+            // Keylock is bypassed at the original tempo
+            ControlObject::set(ConfigKey(group, QStringLiteral("rate")),
+                    getRateSliderValue(1.04));
+            break;
+        case Scenario::Sync:
+            ControlObject::set(ConfigKey(group, QStringLiteral("sync_enabled")), 1.0);
+            break;
+        default:
+            break;
+        }
+
+        ControlObject::set(ConfigKey(group, QStringLiteral("beatloop_size")), kLoopBeats);
+        ControlObject::set(ConfigKey(group, QStringLiteral("beatloop_activate")), 1.0);
+        ControlObject::set(ConfigKey(group, QStringLiteral("beatloop_activate")), 0.0);
+        ControlObject::set(ConfigKey(group, QStringLiteral("play")), 1.0);
+    }
+
+    EngineBuffer::KeylockEngine keylockEngine() const {
+        switch (m_scenario) {
+#ifdef __RUBBERBAND__
+        case Scenario::KeylockRubberBandFaster:
+            return EngineBuffer::KeylockEngine::RubberBandFaster;
+        case Scenario::KeylockRubberBandFiner:
+            return EngineBuffer::KeylockEngine::RubberBandFiner;
+#endif
+        default:
+            return EngineBuffer::KeylockEngine::SoundTouch;
+        }
+    }
+
+    void warmUp() {
+        const double loopSeconds = kLoopBeats * 60 / kBaseBpm;
+        const auto loopFrames = static_cast<SINT>(loopSeconds * sampleRate());
+        for (SINT frames = 0; frames < kWarmUpLoops * loopFrames;
+                frames += kWarmUpFrames) {
+            process(kWarmUpFrames);
+            QTest::qSleep(1);
+        }
+    }
+
+    const Scenario m_scenario;
+    std::vector<Deck*> m_decks;
+    std::vector<std::unique_ptr<Deck>> m_extraDecks;
+};
+
+double percentile(std::vector<double>* pSorted, double fraction) {
+    DEBUG_ASSERT(!pSorted->empty());
+    const auto index = static_cast<std::size_t>(
+            fraction * static_cast<double>(pSorted->size() - 1));
+    return (*pSorted)[index];
+}
+
+void runEngineCallbackBenchmark(benchmark::State& state, Scenario scenario) {
+    const auto numDecks = static_cast<int>(state.range(0));
+    const auto frames = static_cast<SINT>(state.range(1));
+    EngineCallbackBenchmark engine(scenario, numDecks);
+
+    std::vector<double> latenciesMicros;
+    latenciesMicros.reserve(100000);
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        engine.process(frames);
+        const auto end = std::chrono::steady_clock::now();
+        latenciesMicros.push_back(
+                std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    if (latenciesMicros.empty()) {
+        return;
+    }
+
+    std::sort(latenciesMicros.begin(), latenciesMicros.end());
+    state.counters["p50_us"] = percentile(&latenciesMicros, 0.5);
+    state.counters["p99_us"] = percentile(&latenciesMicros, 0.99);
+    state.counters["max_us"] = latenciesMicros.back();
+    // The time available for a callback before the sound device runs dry
+    state.counters["budget_us"] =
+            1000000.0 * frames / engine.sampleRate();
+    state.SetItemsProcessed(state.iterations() * frames);
+}
+
+void engineCallbackArgs(benchmark::internal::Benchmark* b) {
+    for (int numDecks : {2, 4, 8}) {
+        for (int frames = 64; frames <= 1024; frames *= 2) {
+            b->Args({numDecks, frames});
+        }
+    }
+}
+
+void BM_EngineCallbackPlain(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::Plain);
+}
+BENCHMARK(BM_EngineCallbackPlain)->Apply(engineCallbackArgs)->UseRealTime();
+
+void BM_EngineCallbackKeylockSoundTouch(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::KeylockSoundTouch);
+}
+BENCHMARK(BM_EngineCallbackKeylockSoundTouch)->Apply(engineCallbackArgs)->UseRealTime();
+
+#ifdef __RUBBERBAND__
+void BM_EngineCallbackKeylockRubberBandFaster(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::KeylockRubberBandFaster);
+}
+BENCHMARK(BM_EngineCallbackKeylockRubberBandFaster)
+        ->Apply(engineCallbackArgs)
+        ->UseRealTime();
+
+void BM_EngineCallbackKeylockRubberBandFiner(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::KeylockRubberBandFiner);
+}
+BENCHMARK(BM_EngineCallbackKeylockRubberBandFiner)
+        ->Apply(engineCallbackArgs)
+        ->UseRealTime();
+#endif
+
+void BM_EngineCallbackSync(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::Sync);
+}
+BENCHMARK(BM_EngineCallbackSync)->Apply(engineCallbackArgs)->UseRealTime();
+
+void BM_EngineCallbackEffects(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::Effects);
+}
+BENCHMARK(BM_EngineCallbackEffects)->Apply(engineCallbackArgs)->UseRealTime();
+
+#ifdef __STEM__
+void BM_EngineCallbackStems(benchmark::State& state) {
+    runEngineCallbackBenchmark(state, Scenario::Stems);
+}
+BENCHMARK(BM_EngineCallbackStems)->Apply(engineCallbackArgs)->UseRealTime();
+#endif
+
+} // anonymous namespace
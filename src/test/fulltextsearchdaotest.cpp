@@ -0,0 +1,188 @@
+#include "library/dao/fulltextsearchdao.h"
+
+#include <gtest/gtest.h>
+
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QtDebug>
+
+#include "library/dao/trackschema.h"
+#include "library/searchquery.h"
+#include "library/searchqueryparser.h"
+#include "test/librarytest.h"
+
+namespace {
+
+const QString kViewName = QStringLiteral("fulltextsearch_test_view");
+
+class FullTextSearchDAOTest : public LibraryTest {
+  protected:
+    FullTextSearchDAOTest()
+            : m_parser(internalCollection(),
+                      {LIBRARYTABLE_ARTIST,
+                              LIBRARYTABLE_TITLE,
+                              TRACKLOCATIONSTABLE_LOCATION}) {
+        m_parser.setFullTextSearchEnabled(true);
+    }
+
+    void SetUp() override {
+        // Disabled by default
+        internalCollection()->getFullTextSearchDAO().setEnabled(true);
+
+        // The search results must not depend on the availability of the
+        // index, only the tests of the generated SQL require it.
+        // Like the view of MixxxLibraryFeature
+        QSqlQuery query(internalCollection()->database());
+        ASSERT_TRUE(query.exec(QStringLiteral(
+                "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+                "SELECT library.id, library.artist, library.title, "
+                "library.composer, track_locations.location FROM library "
+                "INNER JOIN track_locations ON library.location = track_locations.id")
+                                       .arg(kViewName)))
+                << query.lastError().text().toStdString();
+
+        m_trackA = addTrack(QStringLiteral("id3-test-data/cover-test-jpg.mp3"));
+        m_trackB = addTrack(QStringLiteral("id3-test-data/cover-test-png.mp3"));
+    }
+
+    TrackId addTrack(const QString& fileName) {
+        const TrackPointer pTrack = getOrAddTrackByLocation(getTestDir().filePath(fileName));
+        EXPECT_TRUE(pTrack);
+        return pTrack ? pTrack->getId() : TrackId();
+    }
+
+    void setArtist(TrackId trackId, const QString& artist) {
+        QSqlQuery query(internalCollection()->database());
+        query.prepare(QStringLiteral("UPDATE library SET artist=:artist WHERE id=:id"));
+        query.bindValue(":artist", artist);
+        query.bindValue(":id", trackId.toVariant());
+        ASSERT_TRUE(query.exec()) << query.lastError().text().toStdString();
+    }
+
+    bool isIndexAvailable() const {
+        return internalCollection()->getFullTextSearchDAO().isAvailable();
+    }
+
+    QString toSql(const QString& searchQuery) {
+        return m_parser.parseQuery(searchQuery, QString())->toSql();
+    }
+
+    QList<TrackId> search(const QString& searchQuery) {
+        QSqlQuery query(internalCollection()->database());
+        EXPECT_TRUE(query.exec(
+                QStringLiteral("SELECT id FROM %1 WHERE %2 ORDER BY id")
+                        .arg(kViewName, toSql(searchQuery))))
+                << query.lastError().text().toStdString();
+        QList<TrackId> trackIds;
+        while (query.next()) {
+            trackIds.append(TrackId(query.value(0)));
+        }
+        return trackIds;
+    }
+
+    SearchQueryParser m_parser;
+    TrackId m_trackA;
+    TrackId m_trackB;
+};
+
+TEST_F(FullTextSearchDAOTest, UsesIndexForLongTerms) {
+    if (!isIndexAvailable()) {
+        GTEST_SKIP() << "SQLite doesn't support the full-text search index";
+    }
+    EXPECT_TRUE(toSql("asdf").startsWith("(id IN (SELECT rowid FROM library_fts"));
+    EXPECT_TRUE(toSql("artist:asdf").contains("library_fts MATCH '{artist} : \"asdf\"'"));
+    // Too short for the trigram tokenizer
+    EXPECT_FALSE(toSql("as").contains("library_fts"));
+    // LIKE wildcards
+    EXPECT_FALSE(toSql("as%df").contains("library_fts"));
+    // Not indexed
+    EXPECT_FALSE(toSql("composer:asdf").contains("library_fts"));
+    // Folded like the indexed text
+    EXPECT_TRUE(toSql("artist:ЖУК").contains("library_fts MATCH '{artist} : \"жук\"'"));
+    EXPECT_TRUE(toSql("artist:Röyk").contains("library_fts MATCH '{artist} : \"royk\"'"));
+    EXPECT_TRUE(toSql("ガイド").contains("library_fts"));
+}
+
+TEST_F(FullTextSearchDAOTest, MatchesFoldedText) {
+    // Folding decomposes these characters, which the tokenizer
+    // alone would keep as they are
+    setArtist(m_trackA, QStringLiteral("Άλφα"));
+    setArtist(m_trackB, QStringLiteral("ガイド"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("αλφα"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("artist:ΆΛΦΑ"));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("カイド"));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("artist:ガイド"));
+
+    setArtist(m_trackA, QStringLiteral("ＴＥＣＨＮＯ"));
+    setArtist(m_trackB, QStringLiteral("한국어 노래"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("techno"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("ＴＥＣＨＮＯ"));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("한국어"));
+
+    setArtist(m_trackA, QStringLiteral("Жук"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("ЖУК"));
+
+    if (isIndexAvailable()) {
+        EXPECT_TRUE(toSql("techno").contains("library_fts"));
+        EXPECT_TRUE(toSql("αλφα").contains("library_fts"));
+    }
+}
+
+TEST_F(FullTextSearchDAOTest, TriggersUpdateIndex) {
+    setArtist(m_trackA, QStringLiteral("Röyksopp"));
+    setArtist(m_trackB, QStringLiteral("Daft Punk"));
+
+    // Case and accent insensitive like the LIKE of DbConnection
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("ROYK"));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("=\"daft punk\""));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("-royk"));
+
+    setArtist(m_trackA, QStringLiteral("Daft Punk"));
+    EXPECT_EQ(QList<TrackId>(), search("royk"));
+    EXPECT_EQ((QList<TrackId>{m_trackA, m_trackB}), search("daft"));
+
+    // Both tracks are located in the same directory
+    EXPECT_EQ((QList<TrackId>{m_trackA, m_trackB}), search("id3-test-data"));
+    EXPECT_EQ(QList<TrackId>{m_trackB}, search("location:png"));
+
+    QSqlQuery query(internalCollection()->database());
+    query.prepare(QStringLiteral(
+            "UPDATE track_locations SET location=:location WHERE id="
+            "(SELECT location FROM library WHERE id=:id)"));
+    query.bindValue(":location", QStringLiteral("/relocated/track.mp3"));
+    query.bindValue(":id", m_trackA.toVariant());
+    ASSERT_TRUE(query.exec()) << query.lastError().text().toStdString();
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("relocated"));
+
+    ASSERT_TRUE(query.exec(QStringLiteral("DELETE FROM library WHERE id=%1")
+                                   .arg(m_trackB.toString())));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("daft"));
+}
+
+TEST_F(FullTextSearchDAOTest, TriggersAreNotStored) {
+    if (!isIndexAvailable()) {
+        GTEST_SKIP() << "SQLite doesn't support the full-text search index";
+    }
+    const auto countTriggers = [this](const QString& schema) {
+        QSqlQuery query(internalCollection()->database());
+        EXPECT_TRUE(query.exec(
+                QStringLiteral("SELECT COUNT(*) FROM %1.sqlite_master "
+                               "WHERE type='trigger' AND name LIKE 'library_fts_%'")
+                        .arg(schema)))
+                << query.lastError().text().toStdString();
+        return query.next() ? query.value(0).toInt() : -1;
+    };
+    // Other applications must be able to modify the library
+    // without the latinlow() function of DbConnection
+    EXPECT_EQ(0, countTriggers(QStringLiteral("main")));
+    EXPECT_EQ(4, countTriggers(QStringLiteral("temp")));
+
+    internalCollection()->getFullTextSearchDAO().setEnabled(false);
+    EXPECT_FALSE(isIndexAvailable());
+    EXPECT_EQ(0, countTriggers(QStringLiteral("temp")));
+    EXPECT_FALSE(toSql("asdf").contains("library_fts"));
+    setArtist(m_trackA, QStringLiteral("Röyksopp"));
+    EXPECT_EQ(QList<TrackId>{m_trackA}, search("royk"));
+}
+
+} // namespace
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "library/scanner/importfilestask.h"
+#include "library/scanner/scannerglobal.h"
+#include "sources/soundsourceproxy.h"
+#include "test/librarytest.h"
+
+namespace {
+
+// Measures the throughput of adding new files to the library, like the
+// LibraryScanner does it: The ImportFilesTasks run on a pool of worker
+// threads and hand the new tracks over to a single thread that inserts
+// them into the database within one transaction. With more than one
+// worker thread the file tags are parsed by the workers, otherwise they
+// are parsed by the database writer.
+
+constexpr int kNumDirs = 16;
+constexpr int kNumCopiesPerDir = 4;
+
+/// A directory tree with copies of the test files.
+class GeneratedLibraryTree {
+  public:
+    GeneratedLibraryTree(int numDirs, int numCopiesPerDir) {
+        const QDir sourceDir(MixxxTest::getOrInitTestDir().filePath(
+                QStringLiteral("id3-test-data")));
+        const QFileInfoList sourceFiles = sourceDir.entryInfoList(
+                SoundSourceProxy::getSupportedFileNamePatterns(),
+                QDir::Files);
+        for (int i = 0; i < numDirs; ++i) {
+            const QString dirPath = m_rootDir.filePath(QString::number(i));
+            QDir().mkpath(dirPath);
+            std::list<QFileInfo> files;
+            for (int j = 0; j < numCopiesPerDir; ++j) {
+                for (const QFileInfo& sourceFile : sourceFiles) {
+                    const QString filePath = QDir(dirPath).filePath(
+                            QString::number(j) + sourceFile.fileName());
+                    QFile::copy(sourceFile.filePath(), filePath);
+                    files.push_back(QFileInfo(filePath));
+                }
+            }
+            m_dirs.push_back(std::make_pair(dirPath, std::move(files)));
+        }
+    }
+
+    int numFiles() const {
+        int numFiles = 0;
+        for (const auto& dir : m_dirs) {
+            numFiles += static_cast<int>(dir.second.size());
+        }
+        return numFiles;
+    }
+
+    const std::vector<std::pair<QString, std::list<QFileInfo>>>& dirs() const {
+        return m_dirs;
+    }
+
+  private:
+    const QTemporaryDir m_rootDir;
+    std::vector<std::pair<QString, std::list<QFileInfo>>> m_dirs;
+};
+
+class ImportFilesBenchmark : public LibraryTest {
+  public:
+    explicit ImportFilesBenchmark(int numThreads) {
+        m_pool.setMaxThreadCount(numThreads);
+    }
+
+    /// Imports all files of the tree and returns the number of tracks
+    /// that have been added to the database.
+    int importFiles(const GeneratedLibraryTree& tree) {
+        // Same as in LibraryScanner::slotStartScan()
+        std::optional<SyncTrackMetadataParams> workerImportParams;
+        if (m_pool.maxThreadCount() > 1) {
+            workerImportParams = SyncTrackMetadataParams();
+        }
+        auto pScannerGlobal = ScannerGlobalPointer(new ScannerGlobal(
+                QSet<QString>(),
+                QHash<QString, mixxx::cache_key_t>(),
+                QHash<QString, QDateTime>(),
+                false,
+                SoundSourceProxy::getSupportedFileNamesRegex(),
+                QRegularExpression(),
+                QStringList(),
+                std::move(workerImportParams)));
+
+        TrackDAO& trackDao = internalCollection()->getTrackDAO();
+        int numAddedTracks = 0;
+        // The new tracks are queued to this thread, just like they are
+        // queued to the scanner thread by LibraryScanner.
+        QObject receiver;
+        trackDao.addTracksPrepare();
+        for (const auto& [dirPath, files] : tree.dirs()) {
+            auto* pTask = new ImportFilesTask(nullptr,
+                    pScannerGlobal,
+                    dirPath,
+                    false,
+                    mixxx::invalidCacheKey(),
+                    QDateTime(),
+                    files,
+                    std::list<QFileInfo>(),
+                    SecurityTokenPointer());
+            QObject::connect(pTask,
+                    &ScannerTask::addNewTrack,
+                    &receiver,
+                    [&trackDao, &numAddedTracks](const QString& filePath,
+                            const TrackPointer& pPreparedTrack) {
+                        if (trackDao.addTracksAddFile(
+                                    filePath, false, pPreparedTrack)) {
+                            ++numAddedTracks;
+                        }
+                    },
+                    Qt::QueuedConnection);
+            pScannerGlobal->getTaskWatcher().watchTask();
+            m_pool.start(pTask);
+        }
+        while (!m_pool.waitForDone(1)) {
+            QCoreApplication::processEvents();
+        }
+        QCoreApplication::processEvents();
+        trackDao.addTracksFinish();
+        return numAddedTracks;
+    }
+
+  protected:
+    void TestBody() override {
+    }
+
+  private:
+    QThreadPool m_pool;
+};
+
+} // namespace
+
+static void BM_ImportFilesConcurrently(benchmark::State& state) {
+    ImportFilesBenchmark bench(static_cast<int>(state.range(0)));
+    std::unique_ptr<GeneratedLibraryTree> pTree;
+    int numAddedTracks = 0;
+    for (auto _ : state) {
+        // Each iteration needs new files, otherwise they would already
+        // be in the library. Neither creating nor deleting them must be
+        // measured.
+        state.PauseTiming();
+        pTree.reset();
+        pTree = std::make_unique<GeneratedLibraryTree>(kNumDirs, kNumCopiesPerDir);
+        state.ResumeTiming();
+        const int numAddedTracksInIteration = bench.importFiles(*pTree);
+        numAddedTracks += numAddedTracksInIteration;
+        if (numAddedTracksInIteration != pTree->numFiles()) {
+            state.SkipWithError("Not all files have been added to the library");
+            break;
+        }
+    }
+    state.SetItemsProcessed(numAddedTracks);
+}
+BENCHMARK(BM_ImportFilesConcurrently)->DenseRange(1, 4)->UseRealTime();
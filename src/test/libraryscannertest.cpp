@@ -1,18 +1,166 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QTemporaryDir>
+
 #include "test/librarytest.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "library/scanner/recursivescandirectorytask.h"
 
 class LibraryScannerTest : public LibraryTest {
   protected:
     LibraryScannerTest()
             : m_libraryScanner(dbConnectionPooler(), config()) {
     }
+
+    struct ScanResult {
+        QStringList unchangedDirs;
+        QList<QDateTime> unchangedModifiedTimes;
+        QStringList hashedDirs;
+        QList<QDateTime> hashedModifiedTimes;
+    };
+
+    /// Runs the task for a single directory without sub-directories
+    /// synchronously
+    ScanResult scanDirectory(const QString& dirLocation,
+            mixxx::cache_key_t prevHash,
+            const QDateTime& prevModifiedAt,
+            bool skipUnmodifiedDirectories) {
+        const auto pScannerGlobal = ScannerGlobalPointer::create(
+                QSet<QString>(),
+                QHash<QString, mixxx::cache_key_t>{{dirLocation, prevHash}},
+                QHash<QString, QDateTime>{{dirLocation, prevModifiedAt}},
+                skipUnmodifiedDirectories,
+                QRegularExpression(QStringLiteral("\\.mp3$")),
+                QRegularExpression(QStringLiteral("\\.jpg$")),
+                QStringList());
+        pScannerGlobal->getTaskWatcher().watchTask();
+        ScanResult result;
+        RecursiveScanDirectoryTask task(&m_libraryScanner,
+                pScannerGlobal,
+                mixxx::FileAccess(mixxx::FileInfo(dirLocation)),
+                false);
+        QObject::connect(&task,
+                &ScannerTask::directoryUnchanged,
+                [&result](const QString& directoryPath, const QDateTime& modifiedAt) {
+                    result.unchangedDirs.append(directoryPath);
+                    result.unchangedModifiedTimes.append(modifiedAt);
+                });
+        QObject::connect(&task,
+                &ScannerTask::directoryHashedAndScanned,
+                [&result](const QString& directoryPath,
+                        bool /*newDirectory*/,
+                        mixxx::cache_key_t /*hash*/,
+                        const QDateTime& modifiedAt) {
+                    result.hashedDirs.append(directoryPath);
+                    result.hashedModifiedTimes.append(modifiedAt);
+                });
+        task.run();
+        return result;
+    }
+
+    /// The hash of a directory without any audio files
+    static mixxx::cache_key_t emptyDirectoryHash() {
+        return mixxx::cacheKeyFromMessageDigest(
+                QCryptographicHash::hash(QByteArray(), QCryptographicHash::Sha256));
+    }
+
     LibraryScanner m_libraryScanner;
 };
 
+TEST_F(LibraryScannerTest, SkipUnmodifiedDirectory) {
+    const QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const auto dirInfo = mixxx::FileInfo(tempDir.path());
+    const QString dirLocation = dirInfo.location();
+    const QDateTime modifiedAt = dirInfo.lastModified();
+    ASSERT_TRUE(modifiedAt.isValid());
+
+    // The recorded hash doesn't match, i.e. the directory would be
+    // imported again if it was listed
+    constexpr mixxx::cache_key_t kOutdatedHash = 1;
+    ASSERT_NE(kOutdatedHash, emptyDirectoryHash());
+
+    const auto result = scanDirectory(dirLocation, kOutdatedHash, modifiedAt, true);
+    EXPECT_EQ(QStringList{dirLocation}, result.unchangedDirs);
+    // Unchanged, so the recorded modification time is kept
+    EXPECT_EQ(QList<QDateTime>{QDateTime()}, result.unchangedModifiedTimes);
+    EXPECT_TRUE(result.hashedDirs.isEmpty());
+}
+
+TEST_F(LibraryScannerTest, RescanModifiedDirectory) {
+    const QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const auto dirInfo = mixxx::FileInfo(tempDir.path());
+    const QString dirLocation = dirInfo.location();
+    const QDateTime modifiedAt = dirInfo.lastModified();
+    ASSERT_TRUE(modifiedAt.isValid());
+    constexpr mixxx::cache_key_t kOutdatedHash = 1;
+
+    // The changed modification time forces listing and hashing
+    const auto result = scanDirectory(
+            dirLocation, kOutdatedHash, modifiedAt.addSecs(-60), true);
+    EXPECT_TRUE(result.unchangedDirs.isEmpty());
+    EXPECT_EQ(QStringList{dirLocation}, result.hashedDirs);
+    EXPECT_EQ(QList<QDateTime>{modifiedAt}, result.hashedModifiedTimes);
+
+    // Only the modification time has changed, but not the list of files
+    const auto touchedResult = scanDirectory(
+            dirLocation, emptyDirectoryHash(), modifiedAt.addSecs(-60), true);
+    EXPECT_EQ(QStringList{dirLocation}, touchedResult.unchangedDirs);
+    EXPECT_EQ(QList<QDateTime>{modifiedAt}, touchedResult.unchangedModifiedTimes);
+    EXPECT_TRUE(touchedResult.hashedDirs.isEmpty());
+}
+
+TEST_F(LibraryScannerTest, ListUnmodifiedDirectoryIfDisabled) {
+    const QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const auto dirInfo = mixxx::FileInfo(tempDir.path());
+    const QString dirLocation = dirInfo.location();
+    const QDateTime modifiedAt = dirInfo.lastModified();
+    constexpr mixxx::cache_key_t kOutdatedHash = 1;
+
+    const auto result = scanDirectory(dirLocation, kOutdatedHash, modifiedAt, false);
+    EXPECT_TRUE(result.unchangedDirs.isEmpty());
+    EXPECT_EQ(QStringList{dirLocation}, result.hashedDirs);
+}
+
+TEST_F(LibraryScannerTest, SkipBlacklistedSubdirectoryOfUnmodifiedDirectory) {
+    const QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    ASSERT_TRUE(QDir(tempDir.path()).mkdir(QStringLiteral("blacklisted")));
+    const auto dirInfo = mixxx::FileInfo(tempDir.path());
+    const QString dirLocation = dirInfo.location();
+    const QDateTime modifiedAt = dirInfo.lastModified();
+    ASSERT_TRUE(modifiedAt.isValid());
+    const QString subdirLocation = dirLocation + QStringLiteral("/blacklisted");
+
+    // The sub-directory has been hashed by a previous scan before it
+    // has been blacklisted
+    const auto pScannerGlobal = ScannerGlobalPointer::create(
+            QSet<QString>(),
+            QHash<QString, mixxx::cache_key_t>{
+                    {dirLocation, emptyDirectoryHash()},
+                    {subdirLocation, emptyDirectoryHash()}},
+            QHash<QString, QDateTime>{{dirLocation, modifiedAt}},
+            true,
+            QRegularExpression(QStringLiteral("\\.mp3$")),
+            QRegularExpression(QStringLiteral("\\.jpg$")),
+            QStringList{subdirLocation});
+    pScannerGlobal->getTaskWatcher().watchTask();
+    RecursiveScanDirectoryTask task(&m_libraryScanner,
+            pScannerGlobal,
+            mixxx::FileAccess(dirInfo),
+            false);
+    task.run();
+
+    // No task has been queued for the blacklisted sub-directory
+    EXPECT_FALSE(pScannerGlobal->testAndMarkDirectoryScanned(QDir(subdirLocation)));
+}
+
 TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     // Normal flow:
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
@@ -0,0 +1,235 @@
+#include <benchmark/benchmark.h>
+
+#include <QCoreApplication>
+#include <QJSEngine>
+#include <memory>
+#include <vector>
+
+#include "control/controlpotmeter.h"
+#include "controllers/midi/legacymidicontrollermapping.h"
+#include "controllers/midi/midicontroller.h"
+#include "controllers/midi/midiutils.h"
+#include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
+#include "test/mixxxtest.h"
+#include "util/time.h"
+
+namespace {
+
+// Benchmarks of the input path of MidiController, from receiving a short
+// message to setting the control or calling the script function of its
+// mapping. The replayed stream is that of two 14-bit jog wheels like those
+// of many DJ controllers, which send the MSB and the LSB of their position
+// as two control change messages whenever they move.
+
+constexpr unsigned char kJogMsbControl = 0x06;
+constexpr unsigned char kJogLsbControl = 0x26;
+constexpr int kNumDecks = 2;
+constexpr int kMessagesPerTick = 2 * kNumDecks;
+// A second of the stream of wheels that are spun at different speeds,
+// updated once per millisecond.
+constexpr int kNumTicks = 1000;
+
+const QString kScriptCode = QStringLiteral(
+        "var BenchmarkMapping = { position: {} };"
+        "BenchmarkMapping.jog = function(channel, control, value, status, group) {"
+        "    BenchmarkMapping.position[group] = value;"
+        "};");
+
+enum class Binding {
+    Control,
+    Script,
+    /// Runs the event loop after each tick for the coalescing timer
+    CoalescedScript,
+};
+
+struct ShortMessage {
+    unsigned char status;
+    unsigned char control;
+    unsigned char value;
+};
+
+std::vector<ShortMessage> recordJogWheels() {
+    std::vector<ShortMessage> messages;
+    messages.reserve(kNumTicks * kMessagesPerTick);
+    int positions[kNumDecks] = {0, 0x2000};
+    const int speeds[kNumDecks] = {7, -5};
+    for (int tick = 0; tick < kNumTicks; ++tick) {
+        for (int deck = 0; deck < kNumDecks; ++deck) {
+            positions[deck] = (positions[deck] + speeds[deck]) & 0x3FFF;
+            const unsigned char status = MidiUtils::statusFromOpCodeAndChannel(
+                    MidiOpCode::ControlChange, static_cast<unsigned char>(deck));
+            messages.push_back({status,
+                    kJogMsbControl,
+                    static_cast<unsigned char>(positions[deck] >> 7)});
+            messages.push_back({status,
+                    kJogLsbControl,
+                    static_cast<unsigned char>(positions[deck] & 0x7F)});
+        }
+    }
+    return messages;
+}
+
+class BenchmarkMidiController : public MidiController {
+  public:
+    BenchmarkMidiController()
+            : MidiController(QStringLiteral("benchmark")) {
+    }
+
+    void start(std::shared_ptr<LegacyMidiControllerMapping> pMapping) {
+        setMapping(pMapping);
+        startEngine();
+        getScriptEngine()->initialize();
+        getScriptEngine()->jsEngine()->evaluate(kScriptCode);
+    }
+
+    void replay(const ShortMessage& message, mixxx::Duration timestamp) {
+        receivedShortMessage(message.status, message.control, message.value, timestamp);
+    }
+
+    PhysicalTransportProtocol getPhysicalTransportProtocol() const override {
+        return PhysicalTransportProtocol::UNKNOWN;
+    }
+    QString getVendorString() const override {
+        return QString();
+    }
+    std::optional<uint16_t> getVendorId() const override {
+        return std::nullopt;
+    }
+    QString getProductString() const override {
+        return QString();
+    }
+    std::optional<uint16_t> getProductId() const override {
+        return std::nullopt;
+    }
+    QString getSerialNumber() const override {
+        return QString();
+    }
+    std::optional<uint8_t> getUsbInterfaceNumber() const override {
+        return std::nullopt;
+    }
+    bool sendBytes(const QByteArray& data) override {
+        Q_UNUSED(data);
+        return true;
+    }
+
+  protected:
+    void sendShortMsg(unsigned char status, unsigned char byte1, unsigned char byte2) override {
+        Q_UNUSED(status);
+        Q_UNUSED(byte1);
+        Q_UNUSED(byte2);
+    }
+
+  private:
+    int open(const QString& resourcePath) override {
+        Q_UNUSED(resourcePath);
+        return 0;
+    }
+    int close() override {
+        return 0;
+    }
+};
+
+class MidiInputBenchmark : public MixxxTest {
+  public:
+    /// The buttons of all other channels are mapped as well, so that the
+    /// mapping has the size of a typical mapping for a 4 deck controller.
+    MidiInputBenchmark(Binding binding, int numOtherMappings)
+            : m_binding(binding),
+              m_messages(recordJogWheels()) {
+        auto pMapping = std::make_shared<LegacyMidiControllerMapping>();
+        for (int deck = 0; deck < kNumDecks; ++deck) {
+            const QString group = QStringLiteral("[Channel%1]").arg(deck + 1);
+            const unsigned char status = MidiUtils::statusFromOpCodeAndChannel(
+                    MidiOpCode::ControlChange, static_cast<unsigned char>(deck));
+            if (binding != Binding::Control) {
+                const ConfigKey target(group, QStringLiteral("BenchmarkMapping.jog"));
+                MidiOptions options = MidiOption::Script;
+                options.setFlag(MidiOption::Coalesce, binding == Binding::CoalescedScript);
+                addMapping(pMapping.get(),
+                        MidiInputMapping(MidiKey(status, kJogMsbControl), options, target));
+                addMapping(pMapping.get(),
+                        MidiInputMapping(MidiKey(status, kJogLsbControl), options, target));
+            } else {
+                const ConfigKey target(group, QStringLiteral("benchmark_jog"));
+                m_controls.push_back(std::make_unique<ControlPotmeter>(target, 0.0, 1.0));
+                addMapping(pMapping.get(),
+                        MidiInputMapping(MidiKey(status, kJogMsbControl),
+                                MidiOption::FourteenBitMSB,
+                                target));
+                addMapping(pMapping.get(),
+                        MidiInputMapping(MidiKey(status, kJogLsbControl),
+                                MidiOption::FourteenBitLSB,
+                                target));
+            }
+        }
+        const ConfigKey buttonTarget(QStringLiteral("[Benchmark]"), QStringLiteral("button"));
+        m_controls.push_back(std::make_unique<ControlPotmeter>(buttonTarget, 0.0, 1.0));
+        for (int i = 0; i < numOtherMappings; ++i) {
+            const unsigned char status = MidiUtils::statusFromOpCodeAndChannel(
+                    MidiOpCode::NoteOn, static_cast<unsigned char>(kNumDecks + i / 128));
+            addMapping(pMapping.get(),
+                    MidiInputMapping(MidiKey(status, static_cast<unsigned char>(i % 128)),
+                            MidiOption::Button,
+                            buttonTarget));
+        }
+
+        m_pController = std::make_unique<BenchmarkMidiController>();
+        m_pController->start(pMapping);
+    }
+
+    /// Replays one tick of both jog wheels
+    void replayTick(int tick) {
+        const mixxx::Duration timestamp = mixxx::Time::elapsed();
+        const int first = (tick % kNumTicks) * kMessagesPerTick;
+        for (int i = first; i < first + kMessagesPerTick; ++i) {
+            m_pController->replay(m_messages[i], timestamp);
+        }
+        if (m_binding == Binding::CoalescedScript) {
+            QCoreApplication::processEvents();
+        }
+    }
+
+  protected:
+    void TestBody() override {
+    }
+
+  private:
+    static void addMapping(LegacyMidiControllerMapping* pMapping,
+            const MidiInputMapping& mapping) {
+        pMapping->addInputMapping(mapping.key.key, mapping);
+    }
+
+    const Binding m_binding;
+    const std::vector<ShortMessage> m_messages;
+    std::vector<std::unique_ptr<ControlPotmeter>> m_controls;
+    std::unique_ptr<BenchmarkMidiController> m_pController;
+};
+
+void runMidiInputBenchmark(benchmark::State& state, Binding binding) {
+    MidiInputBenchmark benchmark(binding, static_cast<int>(state.range(0)));
+    // Compiles the mapping
+    benchmark.replayTick(0);
+
+    int tick = 1;
+    for (auto _ : state) {
+        benchmark.replayTick(tick++);
+    }
+    state.SetItemsProcessed(state.iterations() * kMessagesPerTick);
+}
+
+void BM_MidiInputJogWheels14Bit(benchmark::State& state) {
+    runMidiInputBenchmark(state, Binding::Control);
+}
+BENCHMARK(BM_MidiInputJogWheels14Bit)->Arg(0)->Arg(256)->Arg(1024);
+
+void BM_MidiInputJogWheelsScript(benchmark::State& state) {
+    runMidiInputBenchmark(state, Binding::Script);
+}
+BENCHMARK(BM_MidiInputJogWheelsScript)->Arg(0)->Arg(256)->Arg(1024);
+
+void BM_MidiInputJogWheelsCoalescedScript(benchmark::State& state) {
+    runMidiInputBenchmark(state, Binding::CoalescedScript);
+}
+BENCHMARK(BM_MidiInputJogWheelsCoalescedScript)->Arg(0)->Arg(256)->Arg(1024);
+
+} // namespace
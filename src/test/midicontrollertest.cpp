@@ -92,6 +92,14 @@ class MidiControllerTest : public MixxxTest {
         return m_pController->m_pScriptEngineLegacy->jsEngine()->evaluate(code).isError();
     }
 
+    QString evaluateToString(const QString& code) {
+        return m_pController->m_pScriptEngineLegacy->jsEngine()->evaluate(code).toString();
+    }
+
+    void flushCoalescedInputMappings() {
+        m_pController->flushCoalescedInputMappings();
+    }
+
     int getInputMappingCount() {
         return m_pController->m_pMapping->getInputMappings().count();
     }
@@ -646,6 +654,127 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
 
+TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_CreatedAfterMappingLoaded) {
+    ConfigKey key("[Channel3]", "playposition");
+
+    unsigned char channel = 0x02;
+    unsigned char control = 0x10;
+
+    addMapping(MidiInputMapping(
+            MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                            MidiOpCode::ControlChange, channel),
+                    control),
+            MidiOptions(),
+            key));
+    m_pController->setMapping(m_pMapping);
+
+    // The control doesn't exist yet, e.g. because the deck has not been added
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+
+    {
+        auto pPotmeter = std::make_unique<ControlPotmeter>(key, 0.0, 1.0);
+        receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x7F);
+        EXPECT_DOUBLE_EQ(1.0, pPotmeter->get());
+    }
+
+    // The control has been deleted and created again
+    ControlPotmeter potmeter(key, 0.0, 1.0);
+    receivedShortMessage(MidiOpCode::ControlChange, channel, control, 0x00);
+    EXPECT_DOUBLE_EQ(0.0, potmeter.get());
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScriptBinding_Coalesce) {
+    mixxx::Time::setTestMode(true);
+    mixxx::Time::addTestTime(std::chrono::seconds(1));
+    // The jog wheel sends its deltas as 7-bit two's complement, each value
+    // must be decoded before summing them up.
+    evaluateAndAssert(
+            "var CoalesceTest = { calls: [] };"
+            "CoalesceTest.jog = function(channel, control, value, status, group, values) {"
+            "    CoalesceTest.calls.push([value, values.length, "
+            "        values.reduce((sum, value) => sum + (value < 0x40 ? value : value - 0x80), 0)]);"
+            "};"
+            "CoalesceTest.touch = function(channel, control, value, status, group) {"
+            "    CoalesceTest.calls.push(['touch', value]);"
+            "};");
+    const auto calls = [this]() {
+        return evaluateToString(QStringLiteral("JSON.stringify(CoalesceTest.calls)"));
+    };
+
+    addMapping(MidiInputMapping(MidiKey(0xB0, 0x10),
+            MidiOption::Script | MidiOption::Coalesce,
+            ConfigKey("[Channel1]", "CoalesceTest.jog")));
+    addMapping(MidiInputMapping(MidiKey(0x80, 0x11),
+            MidiOption::Script,
+            ConfigKey("[Channel1]", "CoalesceTest.touch")));
+    m_pController->setMapping(m_pMapping);
+
+    // The first message is passed on immediately
+    receivedShortMessage(0xB0, 0x10, 0x01);
+    EXPECT_EQ(QStringLiteral("[[1,1,1]]"), calls());
+
+    // Messages within the interval are passed on together
+    receivedShortMessage(0xB0, 0x10, 0x7F);
+    receivedShortMessage(0xB0, 0x10, 0x7E);
+    receivedShortMessage(0xB0, 0x10, 0x02);
+    EXPECT_EQ(QStringLiteral("[[1,1,1]]"), calls());
+    mixxx::Time::addTestTime(std::chrono::milliseconds(10));
+    flushCoalescedInputMappings();
+    EXPECT_EQ(QStringLiteral("[[1,1,1],[2,3,-1]]"), calls());
+
+    // After a pause the next message is passed on immediately again
+    mixxx::Time::addTestTime(std::chrono::milliseconds(10));
+    receivedShortMessage(0xB0, 0x10, 0x7D);
+    EXPECT_EQ(QStringLiteral("[[1,1,1],[2,3,-1],[125,1,-3]]"), calls());
+
+    // Pending values are passed on before any other mapping is processed,
+    // otherwise releasing the jog wheel would overtake its last movements.
+    receivedShortMessage(0xB0, 0x10, 0x7F);
+    receivedShortMessage(0xB0, 0x10, 0x7F);
+    receivedShortMessage(0x80, 0x11, 0x00);
+    EXPECT_EQ(QStringLiteral("[[1,1,1],[2,3,-1],[125,1,-3],[127,2,-2],[\"touch\",0]]"),
+            calls());
+    mixxx::Time::setTestMode(false);
+}
+
+TEST_F(MidiControllerTest, ReceiveMessage_ScriptBinding_CoalesceKeepsOrder) {
+    mixxx::Time::setTestMode(true);
+    mixxx::Time::addTestTime(std::chrono::seconds(1));
+    evaluateAndAssert(
+            "var CoalesceTest = { calls: [] };"
+            "CoalesceTest.jog = function(channel, control, value, status, group, values) {"
+            "    CoalesceTest.calls.push([control, values]);"
+            "};");
+    const auto calls = [this]() {
+        return evaluateToString(QStringLiteral("JSON.stringify(CoalesceTest.calls)"));
+    };
+
+    addMapping(MidiInputMapping(MidiKey(0xB0, 0x10),
+            MidiOption::Script | MidiOption::Coalesce,
+            ConfigKey("[Channel1]", "CoalesceTest.jog")));
+    addMapping(MidiInputMapping(MidiKey(0xB0, 0x11),
+            MidiOption::Script | MidiOption::Coalesce,
+            ConfigKey("[Channel2]", "CoalesceTest.jog")));
+    m_pController->setMapping(m_pMapping);
+
+    receivedShortMessage(0xB0, 0x10, 0x01);
+    mixxx::Time::addTestTime(std::chrono::milliseconds(5));
+    receivedShortMessage(0xB0, 0x11, 0x02);
+    EXPECT_EQ(QStringLiteral("[[16,[1]],[17,[2]]]"), calls());
+
+    // Pending, the interval of the first mapping has not elapsed yet
+    mixxx::Time::addTestTime(std::chrono::milliseconds(1));
+    receivedShortMessage(0xB0, 0x10, 0x03);
+    EXPECT_EQ(QStringLiteral("[[16,[1]],[17,[2]]]"), calls());
+
+    // The interval of the second mapping has elapsed, but the pending value
+    // of the first mapping has been received before.
+    mixxx::Time::addTestTime(std::chrono::milliseconds(10));
+    receivedShortMessage(0xB0, 0x11, 0x04);
+    EXPECT_EQ(QStringLiteral("[[16,[1]],[17,[2]],[16,[3]],[17,[4]]]"), calls());
+    mixxx::Time::setTestMode(false);
+}
+
 TEST_F(MidiControllerTest, JSInputHandler_BindHandler) {
     constexpr double kMinValue = -1234.5;
     constexpr double kMaxValue = 678.9;
@@ -663,6 +792,41 @@ TEST_F(MidiControllerTest, JSInputHandler_BindHandler) {
     EXPECT_DOUBLE_EQ(potmeter.get(), kMaxValue);
 }
 
+TEST_F(MidiControllerTest, JSInputHandler_Disconnect) {
+    constexpr double kMinValue = -1234.5;
+    constexpr double kMaxValue = 678.9;
+    ControlPotmeter potmeter(ConfigKey("[Channel1]", "test_pot"), kMinValue, kMaxValue);
+    m_pController->setMapping(m_pMapping);
+    evaluateAndAssert(
+            "var connection = midi.makeInputHandler(0x90, 0x43, "
+            "(channel, control, value, status) => {"
+            "engine.setParameter('[Channel1]', 'test_pot', value);"
+            "})");
+    receivedShortMessage(0x90, 0x43, 0x7F);
+    EXPECT_DOUBLE_EQ(potmeter.get(), kMaxValue);
+
+    evaluateAndAssert("connection.disconnect()");
+    EXPECT_EQ(getInputMappingCount(), 0);
+    receivedShortMessage(0x90, 0x43, 0x00);
+    EXPECT_DOUBLE_EQ(potmeter.get(), kMaxValue);
+}
+
+TEST_F(MidiControllerTest, JSInputHandler_BindHandlerAfterFirstMessage) {
+    constexpr double kMinValue = -1234.5;
+    constexpr double kMaxValue = 678.9;
+    ControlPotmeter potmeter(ConfigKey("[Channel1]", "test_pot"), kMinValue, kMaxValue);
+    m_pController->setMapping(m_pMapping);
+    receivedShortMessage(0x90, 0x43, 0x7F);
+    EXPECT_DOUBLE_EQ(potmeter.get(), potmeter.defaultValue());
+
+    evaluateAndAssert(
+            "midi.makeInputHandler(0x90, 0x43, (channel, control, value, status) => {"
+            "engine.setParameter('[Channel1]', 'test_pot', value);"
+            "})");
+    receivedShortMessage(0x90, 0x43, 0x7F);
+    EXPECT_DOUBLE_EQ(potmeter.get(), kMaxValue);
+}
+
 TEST_F(MidiControllerTest, JSInputHandler_ControllerShutdownSlot) {
     m_pController->setMapping(m_pMapping);
     EXPECT_EQ(getInputMappingCount(), 0);
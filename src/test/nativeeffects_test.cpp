@@ -1,3 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "engine/filters/enginefilterbessel4.h"
+#include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterlinkwitzriley8.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+// The IIR filters of the EQs process every deck all the time and the
+// waveform analyzer splits every track into three bands.
+
+constexpr auto kFilterSampleRate = mixxx::audio::SampleRate(44100);
+
+mixxx::SampleBuffer filterInput(SINT bufferSize) {
+    mixxx::SampleBuffer input(bufferSize);
+    for (SINT i = 0; i < bufferSize; ++i) {
+        input[i] = static_cast<CSAMPLE>(std::sin(i * 0.01));
+    }
+    return input;
+}
+
+template<class Filter, typename... Args>
+void benchmarkFilter(benchmark::State& state, Args... args) {
+    const SINT bufferSize = state.range(0);
+    Filter filter(kFilterSampleRate, args...);
+    filter.assumeSettled();
+    const mixxx::SampleBuffer input = filterInput(bufferSize);
+    mixxx::SampleBuffer output(bufferSize);
+    for (auto _ : state) {
+        filter.process(input.data(), output.data(), bufferSize);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * bufferSize);
+}
+
+void BM_EngineFilterBessel4Low(benchmark::State& state) {
+    benchmarkFilter<EngineFilterBessel4Low>(state, 250.0);
+}
+BENCHMARK(BM_EngineFilterBessel4Low)->RangeMultiplier(4)->Range(64, 4096);
+
+void BM_EngineFilterBessel4Band(benchmark::State& state) {
+    benchmarkFilter<EngineFilterBessel4Band>(state, 250.0, 2500.0);
+}
+BENCHMARK(BM_EngineFilterBessel4Band)->RangeMultiplier(4)->Range(64, 4096);
+
+void BM_EngineFilterLinkwitzRiley8Low(benchmark::State& state) {
+    benchmarkFilter<EngineFilterLinkwitzRiley8Low>(state, 250.0);
+}
+BENCHMARK(BM_EngineFilterLinkwitzRiley8Low)->RangeMultiplier(4)->Range(64, 4096);
+
+void BM_EngineFilterBiquad1Peaking(benchmark::State& state) {
+    benchmarkFilter<EngineFilterBiquad1Peaking>(state, 1000.0, 1.75);
+}
+BENCHMARK(BM_EngineFilterBiquad1Peaking)->RangeMultiplier(4)->Range(64, 4096);
+
+// Like AnalyzerWaveform
+void BM_EngineFilterBessel4ThreeBands(benchmark::State& state) {
+    const SINT bufferSize = state.range(0);
+    EngineFilterBessel4Low low(kFilterSampleRate, 600);
+    EngineFilterBessel4Band band(kFilterSampleRate, 600, 4000);
+    EngineFilterBessel4High high(kFilterSampleRate, 4000);
+    low.assumeSettled();
+    band.assumeSettled();
+    high.assumeSettled();
+    const mixxx::SampleBuffer input = filterInput(bufferSize);
+    mixxx::SampleBuffer output(bufferSize);
+    for (auto _ : state) {
+        low.process(input.data(), output.data(), bufferSize);
+        band.process(input.data(), output.data(), bufferSize);
+        high.process(input.data(), output.data(), bufferSize);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * bufferSize);
+}
+BENCHMARK(BM_EngineFilterBessel4ThreeBands)->RangeMultiplier(4)->Range(64, 4096);
+
+} // namespace
+
 #if 0
 // TODO: make this work again
 #include <benchmark/benchmark.h>
@@ -0,0 +1,183 @@
+#include "util/realtimetrace.h"
+
+#include <gtest/gtest.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <thread>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+class RealtimeTraceTest : public MixxxTest {
+  protected:
+    void TearDown() override {
+        mixxx::RealtimeTrace::releaseThreads(this);
+        mixxx::RealtimeTrace::setEnabled(false);
+    }
+
+    /// Each thread gets its own trace buffer, so the tests record in a new
+    /// thread to start with an empty buffer.
+    template<typename Func>
+    void recordInNewThread(Func func, bool registerThread = true) {
+        std::thread thread([this, func, registerThread] {
+            if (registerThread) {
+                EXPECT_TRUE(mixxx::RealtimeTrace::registerCurrentThread("Test", this));
+            }
+            func();
+        });
+        thread.join();
+    }
+
+    /// Returns the exported events with the given arg in the recorded order
+    QJsonArray exportedEvents(int arg) {
+        const QTemporaryDir tempDir;
+        const QString fileName = tempDir.filePath(QStringLiteral("trace.json"));
+        EXPECT_TRUE(mixxx::RealtimeTrace::writeChromeTrace(fileName));
+
+        QFile file(fileName);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        EXPECT_EQ(QJsonParseError::NoError, error.error) << error.errorString().toStdString();
+
+        QJsonArray events;
+        const QJsonArray traceEvents = doc.object().value(QStringLiteral("traceEvents")).toArray();
+        for (const auto& value : traceEvents) {
+            const QJsonObject event = value.toObject();
+            if (event.value(QStringLiteral("args"))
+                            .toObject()
+                            .value(QStringLiteral("arg"))
+                            .toInt(-1) == arg) {
+                events.append(event);
+            }
+        }
+        return events;
+    }
+};
+
+TEST_F(RealtimeTraceTest, NestedEvents) {
+    constexpr int kArg = 4201;
+    mixxx::RealtimeTrace::setEnabled(true);
+    recordInNewThread([] {
+        mixxx::ScopedRealtimeTrace outer(mixxx::RealtimeTraceEvent::EngineProcess, kArg);
+        {
+            mixxx::ScopedRealtimeTrace inner(mixxx::RealtimeTraceEvent::ChannelProcess, kArg);
+        }
+        mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, kArg);
+    });
+
+    const QJsonArray events = exportedEvents(kArg);
+    ASSERT_EQ(5, events.size());
+    const char* expectedNames[] = {
+            "EngineMixer::process",
+            "EngineChannel::process",
+            "EngineChannel::process",
+            "Underflow",
+            "EngineMixer::process",
+    };
+    const char* expectedPhases[] = {"B", "B", "E", "i", "E"};
+    double lastTimestamp = 0;
+    for (int i = 0; i < events.size(); ++i) {
+        const QJsonObject event = events.at(i).toObject();
+        EXPECT_EQ(QString(expectedNames[i]), event.value(QStringLiteral("name")).toString());
+        EXPECT_EQ(QString(expectedPhases[i]), event.value(QStringLiteral("ph")).toString());
+        const double timestamp = event.value(QStringLiteral("ts")).toDouble();
+        EXPECT_LE(lastTimestamp, timestamp);
+        lastTimestamp = timestamp;
+    }
+}
+
+TEST_F(RealtimeTraceTest, DisabledRecordsNothing) {
+    constexpr int kArg = 4202;
+    // Allocates a buffer for the thread
+    mixxx::RealtimeTrace::setEnabled(true);
+    mixxx::RealtimeTrace::setEnabled(false);
+    recordInNewThread([] {
+        mixxx::ScopedRealtimeTrace trace(mixxx::RealtimeTraceEvent::EngineProcess, kArg);
+    });
+
+    EXPECT_TRUE(exportedEvents(kArg).isEmpty());
+}
+
+TEST_F(RealtimeTraceTest, UnregisteredThreadRecordsNothing) {
+    constexpr int kArg = 4204;
+    mixxx::RealtimeTrace::setEnabled(true);
+    recordInNewThread(
+            [] {
+                mixxx::ScopedRealtimeTrace trace(
+                        mixxx::RealtimeTraceEvent::EngineProcess, kArg);
+            },
+            false);
+
+    EXPECT_TRUE(exportedEvents(kArg).isEmpty());
+}
+
+TEST_F(RealtimeTraceTest, ReleasedBuffersAreReused) {
+    constexpr int kArg = 4205;
+    // Like restarting the sound devices many times
+    constexpr int kNumThreads = 300;
+    mixxx::RealtimeTrace::setEnabled(true);
+    for (int i = 0; i < kNumThreads; ++i) {
+        recordInNewThread([] {
+            mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, kArg);
+        });
+        mixxx::RealtimeTrace::releaseThreads(this);
+    }
+
+    // The events of the released threads are kept
+    EXPECT_EQ(kNumThreads, exportedEvents(kArg).size());
+}
+
+TEST_F(RealtimeTraceTest, ReleasedThreadRecordsNothing) {
+    constexpr int kArg = 4206;
+    mixxx::RealtimeTrace::setEnabled(true);
+    recordInNewThread([this] {
+        mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, kArg);
+        mixxx::RealtimeTrace::releaseThreads(this);
+        // The buffer might already be assigned to another thread
+        mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, kArg);
+        // Until the thread registers again
+        EXPECT_TRUE(mixxx::RealtimeTrace::registerCurrentThread("Test", this));
+        mixxx::RealtimeTrace::instant(mixxx::RealtimeTraceEvent::Underflow, kArg);
+    });
+
+    EXPECT_EQ(2, exportedEvents(kArg).size());
+}
+
+TEST_F(RealtimeTraceTest, OverwritesOldestEvents) {
+    constexpr int kArg = 4203;
+    constexpr int kNumCallbacks = 100000;
+    mixxx::RealtimeTrace::setEnabled(true);
+    recordInNewThread([] {
+        for (int i = 0; i < kNumCallbacks; ++i) {
+            mixxx::ScopedRealtimeTrace outer(mixxx::RealtimeTraceEvent::EngineProcess, kArg);
+            mixxx::ScopedRealtimeTrace inner(mixxx::RealtimeTraceEvent::ChannelProcess, kArg);
+        }
+    });
+
+    const QJsonArray events = exportedEvents(kArg);
+    ASSERT_FALSE(events.isEmpty());
+    EXPECT_LT(events.size(), 4 * kNumCallbacks);
+    // End events whose begin event has been overwritten are skipped
+    int depth = 0;
+    for (const auto& value : events) {
+        const QString phase = value.toObject().value(QStringLiteral("ph")).toString();
+        if (phase == QStringLiteral("B")) {
+            ++depth;
+        } else {
+            ASSERT_EQ(QStringLiteral("E"), phase);
+            --depth;
+            ASSERT_LE(0, depth);
+        }
+    }
+    EXPECT_EQ(0, depth);
+    // The most recent events are preserved
+    EXPECT_EQ(QStringLiteral("EngineMixer::process"),
+            events.last().toObject().value(QStringLiteral("name")).toString());
+}
+
+} // namespace
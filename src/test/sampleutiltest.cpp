@@ -4,9 +4,11 @@
 #include <QList>
 #include <QPair>
 #include <QtDebug>
+#include <random>
 #include <vector>
 
 #include "util/sample.h"
+#include "util/samplekernels.h"
 #include "util/timer.h"
 
 namespace {
@@ -466,6 +468,208 @@ TEST_F(SampleUtilTest, mixMultichannelToStereo) {
     EXPECT_FLOAT_EQ(destination[3], 0.9f + 1.1f + 1.3f /* + 1.5f*/);
 }
 
+const mixxx::SimdLevel kSimdLevels[] = {
+        mixxx::SimdLevel::Scalar,
+        mixxx::SimdLevel::Sse2,
+        mixxx::SimdLevel::Avx2,
+        mixxx::SimdLevel::Avx512,
+        mixxx::SimdLevel::Neon,
+};
+
+// Random samples that exceed the peak amplitude occasionally
+std::vector<CSAMPLE> randomSamples(SINT numSamples, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<CSAMPLE> distribution(-1.1f, 1.1f);
+    std::vector<CSAMPLE> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = distribution(generator);
+    }
+    return samples;
+}
+
+void expectSamplesNear(const std::vector<CSAMPLE>& expected,
+        const std::vector<CSAMPLE>& actual,
+        CSAMPLE tolerance) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], tolerance) << "at index " << i;
+    }
+}
+
+// The SIMD kernels are verified against the scalar kernels. Products must
+// match exactly, sums might differ slightly due to a different order of
+// summation. The odd sizes exercise the remainder loops.
+TEST_F(SampleUtilTest, simdKernelsMatchScalarKernels) {
+    constexpr CSAMPLE kProductTolerance = 0.0f;
+    constexpr CSAMPLE kSumTolerance = 1e-5f;
+    const mixxx::SampleKernels& scalar = mixxx::samplekernels::scalar();
+    QList<int> numFramesList = {0, 1, 3, 4, 7, 8, 15, 16, 17, 33};
+    numFramesList.append(sizes);
+    for (const auto level : kSimdLevels) {
+        const mixxx::SampleKernels* pKernels = mixxx::samplekernels::forSimdLevel(level);
+        if (!pKernels || level == mixxx::SimdLevel::Scalar) {
+            continue;
+        }
+        const mixxx::SampleKernels& simd = *pKernels;
+        SCOPED_TRACE(mixxx::simdLevelName(level));
+        for (const int numFrames : std::as_const(numFramesList)) {
+            SCOPED_TRACE(numFrames);
+            const SINT numSamples = numFrames * 2;
+            const auto src1 = randomSamples(numSamples, 1);
+            const auto src2 = randomSamples(numSamples, 2);
+            const auto src3 = randomSamples(numSamples, 3);
+            const auto stems = randomSamples(numFrames * 8, 4);
+            const auto dest = randomSamples(numSamples, 5);
+
+            auto expected = dest;
+            auto actual = dest;
+            scalar.applyGain(expected.data(), 0.7f, numSamples);
+            simd.applyGain(actual.data(), 0.7f, numSamples);
+            expectSamplesNear(expected, actual, kProductTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.applyRampingGain(expected.data(), 0.1f, 0.001f, numFrames);
+            simd.applyRampingGain(actual.data(), 0.1f, 0.001f, numFrames);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.copyWithGain(expected.data(), src1.data(), 0.7f, numSamples);
+            simd.copyWithGain(actual.data(), src1.data(), 0.7f, numSamples);
+            expectSamplesNear(expected, actual, kProductTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.copyWithRampingGain(expected.data(), src1.data(), 0.1f, 0.001f, numFrames);
+            simd.copyWithRampingGain(actual.data(), src1.data(), 0.1f, 0.001f, numFrames);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.addWithGain(expected.data(), src1.data(), 0.7f, numSamples);
+            simd.addWithGain(actual.data(), src1.data(), 0.7f, numSamples);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.addWithRampingGain(expected.data(), src1.data(), 0.1f, 0.001f, numFrames);
+            simd.addWithRampingGain(actual.data(), src1.data(), 0.1f, 0.001f, numFrames);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.add2WithGain(expected.data(),
+                    src1.data(),
+                    0.7f,
+                    src2.data(),
+                    0.3f,
+                    numSamples);
+            simd.add2WithGain(actual.data(),
+                    src1.data(),
+                    0.7f,
+                    src2.data(),
+                    0.3f,
+                    numSamples);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.add3WithGain(expected.data(),
+                    src1.data(),
+                    0.7f,
+                    src2.data(),
+                    0.3f,
+                    src3.data(),
+                    0.5f,
+                    numSamples);
+            simd.add3WithGain(actual.data(),
+                    src1.data(),
+                    0.7f,
+                    src2.data(),
+                    0.3f,
+                    src3.data(),
+                    0.5f,
+                    numSamples);
+            expectSamplesNear(expected, actual, kSumTolerance);
+
+            CSAMPLE expectedSumAbsL = 0;
+            CSAMPLE expectedSumAbsR = 0;
+            bool expectedClippingL = false;
+            bool expectedClippingR = false;
+            scalar.sumAbsPerChannel(&expectedSumAbsL,
+                    &expectedSumAbsR,
+                    &expectedClippingL,
+                    &expectedClippingR,
+                    src1.data(),
+                    numFrames);
+            CSAMPLE actualSumAbsL = 0;
+            CSAMPLE actualSumAbsR = 0;
+            bool actualClippingL = false;
+            bool actualClippingR = false;
+            simd.sumAbsPerChannel(&actualSumAbsL,
+                    &actualSumAbsR,
+                    &actualClippingL,
+                    &actualClippingR,
+                    src1.data(),
+                    numFrames);
+            // The sums grow with the number of frames
+            EXPECT_NEAR(expectedSumAbsL, actualSumAbsL, kSumTolerance * numFrames);
+            EXPECT_NEAR(expectedSumAbsR, actualSumAbsR, kSumTolerance * numFrames);
+            EXPECT_EQ(expectedClippingL, actualClippingL);
+            EXPECT_EQ(expectedClippingR, actualClippingR);
+
+            expected = dest;
+            actual = dest;
+            scalar.interleaveStereo(expected.data(), src1.data(), src2.data(), numFrames);
+            simd.interleaveStereo(actual.data(), src1.data(), src2.data(), numFrames);
+            expectSamplesNear(expected, actual, kProductTolerance);
+
+            auto expected2 = dest;
+            auto actual2 = dest;
+            expected = dest;
+            actual = dest;
+            scalar.deinterleaveStereo(
+                    expected.data(), expected2.data(), src1.data(), numFrames);
+            simd.deinterleaveStereo(actual.data(), actual2.data(), src1.data(), numFrames);
+            expectSamplesNear(expected, actual, kProductTolerance);
+            expectSamplesNear(expected2, actual2, kProductTolerance);
+
+            expected = dest;
+            actual = dest;
+            scalar.mixStemsToStereo(expected.data(), stems.data(), numFrames);
+            simd.mixStemsToStereo(actual.data(), stems.data(), numFrames);
+            expectSamplesNear(expected, actual, kSumTolerance);
+        }
+    }
+}
+
+TEST_F(SampleUtilTest, sumAbsPerChannelClipping) {
+    for (const auto level : kSimdLevels) {
+        const mixxx::SampleKernels* pKernels = mixxx::samplekernels::forSimdLevel(level);
+        if (!pKernels) {
+            continue;
+        }
+        SCOPED_TRACE(mixxx::simdLevelName(level));
+        for (int i = 0; i < evenBuffers.size(); ++i) {
+            int j = evenBuffers[i];
+            CSAMPLE* buffer = buffers[j];
+            int size = sizes[j];
+            FillBuffer(buffer, 0.5f, size);
+            // A single clipping sample in the last frame of the right channel
+            buffer[size - 1] = -1.5f;
+            CSAMPLE fSumL = 0, fSumR = 0;
+            bool clippingL = true;
+            bool clippingR = false;
+            pKernels->sumAbsPerChannel(&fSumL, &fSumR, &clippingL, &clippingR, buffer, size / 2);
+            EXPECT_FALSE(clippingL);
+            EXPECT_TRUE(clippingR);
+            EXPECT_FLOAT_EQ(fSumL, 0.5f * size / 2);
+            EXPECT_FLOAT_EQ(fSumR, 0.5f * (size / 2 - 1) + 1.5f);
+        }
+    }
+}
+
 static void BM_MemCpy(benchmark::State& state) {
     SINT size = static_cast<SINT>(state.range(0));
     CSAMPLE* buffer = SampleUtil::alloc(size);
@@ -652,4 +856,221 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
 }
 BENCHMARK(BM_Copy2WithRampingGain)->Range(64, 4096);
 
+// Benchmarks for the kernels of all instruction sets. The first argument
+// is the SimdLevel, the second the number of samples.
+void simdLevelArgs(benchmark::internal::Benchmark* b) {
+    for (const auto level : kSimdLevels) {
+        for (int size = 64; size <= 4096; size *= 8) {
+            b->Args({static_cast<int>(level), size});
+        }
+    }
+}
+
+const mixxx::SampleKernels* kernelsForBenchmark(benchmark::State& state) {
+    const auto level = static_cast<mixxx::SimdLevel>(state.range(0));
+    const mixxx::SampleKernels* pKernels = mixxx::samplekernels::forSimdLevel(level);
+    if (pKernels) {
+        state.SetLabel(mixxx::simdLevelName(level));
+    } else {
+        state.SkipWithError("Not supported");
+    }
+    return pKernels;
+}
+
+static void BM_KernelApplyGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto buffer = randomSamples(size, 1);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->applyGain(buffer.data(), 0.9999f, size);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_KernelApplyGain)->Apply(simdLevelArgs);
+
+static void BM_KernelApplyRampingGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto buffer = randomSamples(size, 1);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->applyRampingGain(buffer.data(), 0.9999f, 0.00001f, size / 2);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_KernelApplyRampingGain)->Apply(simdLevelArgs);
+
+static void BM_KernelCopyWithGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src = randomSamples(size, 2);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->copyWithGain(dest.data(), src.data(), 0.5f, size);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelCopyWithGain)->Apply(simdLevelArgs);
+
+static void BM_KernelCopyWithRampingGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src = randomSamples(size, 2);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->copyWithRampingGain(dest.data(), src.data(), 0.5f, 0.0001f, size / 2);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelCopyWithRampingGain)->Apply(simdLevelArgs);
+
+static void BM_KernelAddWithGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src = randomSamples(size, 2);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->addWithGain(dest.data(), src.data(), 0.0001f, size);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelAddWithGain)->Apply(simdLevelArgs);
+
+static void BM_KernelAddWithRampingGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src = randomSamples(size, 2);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->addWithRampingGain(dest.data(), src.data(), 0.0001f, 0.0000001f, size / 2);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelAddWithRampingGain)->Apply(simdLevelArgs);
+
+static void BM_KernelAdd2WithGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src1 = randomSamples(size, 2);
+    const auto src2 = randomSamples(size, 3);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->add2WithGain(dest.data(), src1.data(), 0.0001f, src2.data(), 0.0001f, size);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelAdd2WithGain)->Apply(simdLevelArgs);
+
+static void BM_KernelAdd3WithGain(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src1 = randomSamples(size, 2);
+    const auto src2 = randomSamples(size, 3);
+    const auto src3 = randomSamples(size, 4);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->add3WithGain(dest.data(),
+                src1.data(),
+                0.0001f,
+                src2.data(),
+                0.0001f,
+                src3.data(),
+                0.0001f,
+                size);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelAdd3WithGain)->Apply(simdLevelArgs);
+
+static void BM_KernelSumAbsPerChannel(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    const auto buffer = randomSamples(size, 1);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        CSAMPLE sumAbsL;
+        CSAMPLE sumAbsR;
+        bool clippingL;
+        bool clippingR;
+        pKernels->sumAbsPerChannel(
+                &sumAbsL, &sumAbsR, &clippingL, &clippingR, buffer.data(), size / 2);
+        benchmark::DoNotOptimize(sumAbsL);
+        benchmark::DoNotOptimize(sumAbsR);
+    }
+}
+BENCHMARK(BM_KernelSumAbsPerChannel)->Apply(simdLevelArgs);
+
+static void BM_KernelInterleaveStereo(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src1 = randomSamples(size / 2, 2);
+    const auto src2 = randomSamples(size / 2, 3);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->interleaveStereo(dest.data(), src1.data(), src2.data(), size / 2);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelInterleaveStereo)->Apply(simdLevelArgs);
+
+static void BM_KernelDeinterleaveStereo(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest1 = randomSamples(size / 2, 1);
+    auto dest2 = randomSamples(size / 2, 2);
+    const auto src = randomSamples(size, 3);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->deinterleaveStereo(dest1.data(), dest2.data(), src.data(), size / 2);
+        benchmark::DoNotOptimize(dest1.data());
+        benchmark::DoNotOptimize(dest2.data());
+    }
+}
+BENCHMARK(BM_KernelDeinterleaveStereo)->Apply(simdLevelArgs);
+
+static void BM_KernelMixStemsToStereo(benchmark::State& state) {
+    const mixxx::SampleKernels* pKernels = kernelsForBenchmark(state);
+    const SINT size = static_cast<SINT>(state.range(1));
+    auto dest = randomSamples(size, 1);
+    const auto src = randomSamples(size * 4, 2);
+    for (auto _ : state) {
+        if (!pKernels) {
+            break;
+        }
+        pKernels->mixStemsToStereo(dest.data(), src.data(), size / 2);
+        benchmark::DoNotOptimize(dest.data());
+    }
+}
+BENCHMARK(BM_KernelMixStemsToStereo)->Apply(simdLevelArgs);
+
 }  // namespace
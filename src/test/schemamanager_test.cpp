@@ -91,3 +91,54 @@ TEST_F(SchemaManagerTest, UpgradeFailed) {
             MixxxDb::kRequiredSchemaVersion, MixxxDb::kDefaultSchemaFile);
     EXPECT_EQ(SchemaManager::Result::UpgradeFailed, result);
 }
+
+TEST_F(SchemaManagerTest, UpgradeDirectoryHashesToVersion41) {
+    {
+        SchemaManager schemaManager(dbConnection());
+        ASSERT_EQ(SchemaManager::Result::UpgradeSucceeded,
+                schemaManager.upgradeToSchemaVersion(40, MixxxDb::kDefaultSchemaFile));
+        QSqlQuery query(dbConnection());
+        ASSERT_TRUE(query.exec(
+                "INSERT INTO LibraryHashes "
+                "(directory_path, hash, directory_deleted, needs_verification) "
+                "VALUES ('/music', 1234, 0, 0)"));
+    }
+
+    SchemaManager schemaManager(dbConnection());
+    ASSERT_EQ(SchemaManager::Result::UpgradeSucceeded,
+            schemaManager.upgradeToSchemaVersion(41, MixxxDb::kDefaultSchemaFile));
+    EXPECT_EQ(41, schemaManager.readCurrentVersion());
+
+    // Existing directories have no modification time until they are
+    // listed again by the next scan
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "SELECT hash, modified_ms FROM LibraryHashes "
+            "WHERE directory_path='/music'"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(1234, query.value(0).toInt());
+    EXPECT_TRUE(query.value(1).isNull());
+}
+
+TEST_F(SchemaManagerTest, DropFullTextSearchTriggersInVersion42) {
+    {
+        SchemaManager schemaManager(dbConnection());
+        ASSERT_EQ(SchemaManager::Result::UpgradeSucceeded,
+                schemaManager.upgradeToSchemaVersion(41, MixxxDb::kDefaultSchemaFile));
+        // Like the triggers that were created at runtime
+        QSqlQuery query(dbConnection());
+        ASSERT_TRUE(query.exec(
+                "CREATE TRIGGER library_fts_delete AFTER DELETE ON library "
+                "BEGIN SELECT 1; END"));
+    }
+
+    SchemaManager schemaManager(dbConnection());
+    ASSERT_EQ(SchemaManager::Result::UpgradeSucceeded,
+            schemaManager.upgradeToSchemaVersion(42, MixxxDb::kDefaultSchemaFile));
+
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "SELECT name FROM sqlite_master WHERE type='trigger' "
+            "AND name LIKE 'library_fts_%'"));
+    EXPECT_FALSE(query.next());
+}
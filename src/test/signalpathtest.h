@@ -69,7 +69,16 @@ class TestEngineMixer : public EngineMixer {
 
 class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
   protected:
-    BaseSignalPathTest() {
+    BaseSignalPathTest()
+            : BaseSignalPathTest(false) {
+    }
+
+    /// @param multithreadedChannels whether the EngineMixer processes the
+    /// channels in parallel
+    explicit BaseSignalPathTest(bool multithreadedChannels) {
+        m_pConfig->setValue(ConfigKey(QStringLiteral("[App]"),
+                                    QStringLiteral("multithreaded_channels")),
+                multithreadedChannels);
         m_pControlIndicatorTimer = std::make_unique<mixxx::ControlIndicatorTimer>();
         m_pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
         m_pNumDecks = new ControlObject(ConfigKey(
@@ -3,7 +3,11 @@
 #include <QtDebug>
 
 #include "analyzer/analyzersilence.h"
+#include "sources/audiosourcepredecodeproxy.h"
 #include "sources/audiosourcestereoproxy.h"
+#ifdef __FFMPEG__
+#include "sources/soundsourceffmpeg.h"
+#endif
 #include "sources/soundsourceproxy.h"
 #include "test/mixxxtest.h"
 #include "test/soundsourceproviderregistration.h"
@@ -701,6 +705,178 @@ TEST_F(SoundSourceProxyTest, readBeyondEnd) {
     }
 }
 
+TEST_F(SoundSourceProxyTest, preDecode) {
+    constexpr SINT kReadFrameCount = 1000;
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        ASSERT_TRUE(SoundSourceProxy::isFileNameSupported(filePath));
+        qDebug() << "pre-decode test:" << filePath;
+
+        const auto fileUrl = QUrl::fromLocalFile(filePath);
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(fileUrl);
+        for (const auto& providerRegistration : providerRegistrations) {
+            for (const auto sampleFormat :
+                    {mixxx::AudioSourcePreDecodeProxy::SampleFormat::Float32,
+                            mixxx::AudioSourcePreDecodeProxy::SampleFormat::Int16}) {
+                mixxx::AudioSourcePointer pContReadSource = openAudioSource(
+                        filePath,
+                        providerRegistration.getProvider());
+                // Obtaining an AudioSource may fail for unsupported file formats,
+                // even if the corresponding file extension is supported, e.g.
+                // AAC vs. ALAC in .m4a files
+                if (!pContReadSource) {
+                    // skip test file
+                    continue;
+                }
+                const auto pPreDecodeProxy = mixxx::AudioSourcePreDecodeProxy::create(
+                        openAudioSource(filePath, providerRegistration.getProvider()),
+                        sampleFormat);
+                while (pPreDecodeProxy->decodeNextFrames(kReadFrameCount)) {
+                }
+                ASSERT_TRUE(pPreDecodeProxy->isDecodingFinished());
+                EXPECT_EQ(pContReadSource->frameIndexRange(),
+                        pPreDecodeProxy->decodedFrameIndexRange());
+
+                // Read backwards, like when scratching
+                mixxx::SampleBuffer contReadData(
+                        pContReadSource->getSignalInfo().frames2samples(kReadFrameCount));
+                mixxx::SampleBuffer preDecodedData(
+                        pPreDecodeProxy->getSignalInfo().frames2samples(kReadFrameCount));
+                for (SINT frameIndex = pContReadSource->frameIndexMax() - kReadFrameCount;
+                        frameIndex >= pContReadSource->frameIndexMin();
+                        frameIndex -= 3 * kReadFrameCount) {
+                    const auto readFrameIndexRange =
+                            mixxx::IndexRange::forward(frameIndex, kReadFrameCount);
+                    const auto contSampleFrames = pContReadSource->readSampleFrames(
+                            mixxx::WritableSampleFrames(readFrameIndexRange,
+                                    mixxx::SampleBuffer::WritableSlice(contReadData)));
+                    const auto preDecodedSampleFrames = pPreDecodeProxy->readSampleFrames(
+                            mixxx::WritableSampleFrames(readFrameIndexRange,
+                                    mixxx::SampleBuffer::WritableSlice(preDecodedData)));
+                    ASSERT_EQ(contSampleFrames.frameIndexRange(),
+                            preDecodedSampleFrames.frameIndexRange());
+                    const SINT sampleCount = contSampleFrames.readableLength();
+                    for (SINT i = 0; i < sampleCount; ++i) {
+                        EXPECT_NEAR(contSampleFrames.readableData()[i],
+                                preDecodedSampleFrames.readableData()[i],
+                                kMaxDecodingError);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#ifdef __FFMPEG__
+TEST_F(SoundSourceProxyTest, seekIndex) {
+    constexpr SINT kReadFrameCount = 4096;
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    mixxx::SoundSourceFFmpeg::setSeekIndexDirPath(tempDir.path());
+
+    const QStringList filePaths = getFilePaths();
+    for (const auto& filePath : filePaths) {
+        ASSERT_TRUE(SoundSourceProxy::isFileNameSupported(filePath));
+        qDebug() << "Seek index test:" << filePath;
+
+        const auto fileUrl = QUrl::fromLocalFile(filePath);
+        const auto providerRegistrations =
+                SoundSourceProxy::allProviderRegistrationsForUrl(fileUrl);
+        for (const auto& providerRegistration : providerRegistrations) {
+            mixxx::AudioSourcePointer pContReadSource = openAudioSource(
+                    filePath,
+                    providerRegistration.getProvider());
+            if (!pContReadSource) {
+                // skip test file
+                continue;
+            }
+            mixxx::SampleBuffer contReadData(
+                    pContReadSource->getSignalInfo().frames2samples(
+                            pContReadSource->frameLength()));
+            mixxx::SampleBuffer seekReadData(
+                    pContReadSource->getSignalInfo().frames2samples(kReadFrameCount));
+
+            // Decode the whole file sequentially, which stores the
+            // seek index when closing the source
+            const auto contSampleFrames = pContReadSource->readSampleFrames(
+                    mixxx::WritableSampleFrames(pContReadSource->frameIndexRange(),
+                            mixxx::SampleBuffer::WritableSlice(contReadData)));
+            ASSERT_EQ(pContReadSource->frameIndexRange(), contSampleFrames.frameIndexRange());
+            pContReadSource.reset();
+            if (providerRegistration.getProvider()->getDisplayName() ==
+                            mixxx::SoundSourceProviderFFmpeg::kDisplayName &&
+                    filePath.endsWith(QStringLiteral(".mp3"))) {
+                // The MP3 demuxer builds a generic index while reading
+                EXPECT_TRUE(QFile::exists(mixxx::SoundSourceFFmpeg::seekIndexFilePath(
+                        fileUrl.toLocalFile())));
+                // The index is restored instead of reading the stream again
+                mixxx::SoundSourceFFmpeg source(fileUrl);
+                ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                        source.open(mixxx::AudioSource::OpenMode::Strict));
+                EXPECT_TRUE(source.isSeekIndexRestored());
+            }
+
+            // Seek backwards with the restored seek index
+            mixxx::AudioSourcePointer pSeekReadSource = openAudioSource(
+                    filePath,
+                    providerRegistration.getProvider());
+            ASSERT_FALSE(!pSeekReadSource);
+            for (SINT frameIndex = pSeekReadSource->frameIndexMax() - kReadFrameCount;
+                    frameIndex >= pSeekReadSource->frameIndexMin();
+                    frameIndex -= 5 * kReadFrameCount) {
+                const auto readFrameIndexRange =
+                        mixxx::IndexRange::forward(frameIndex, kReadFrameCount);
+                const auto seekSampleFrames = pSeekReadSource->readSampleFrames(
+                        mixxx::WritableSampleFrames(readFrameIndexRange,
+                                mixxx::SampleBuffer::WritableSlice(seekReadData)));
+                ASSERT_EQ(readFrameIndexRange, seekSampleFrames.frameIndexRange());
+                expectDecodedSamplesEqual(
+                        seekSampleFrames.readableLength(),
+                        &contReadData[pSeekReadSource->getSignalInfo().frames2samples(
+                                frameIndex - pSeekReadSource->frameIndexMin())],
+                        &seekReadData[0],
+                        "Decoding mismatch after seeking with seek index");
+            }
+
+            if (providerRegistration.getProvider()->getDisplayName() ==
+                            mixxx::SoundSourceProviderFFmpeg::kDisplayName &&
+                    filePath.endsWith(QStringLiteral(".mp3"))) {
+                // Seeking before reaching the end of the stream still
+                // stores the index, which is used when reopening the file
+                const QString seekIndexFilePath =
+                        mixxx::SoundSourceFFmpeg::seekIndexFilePath(fileUrl.toLocalFile());
+                ASSERT_TRUE(QFile::remove(seekIndexFilePath));
+                {
+                    mixxx::SoundSourceFFmpeg source(fileUrl);
+                    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                            source.open(mixxx::AudioSource::OpenMode::Strict));
+                    EXPECT_FALSE(source.isSeekIndexRestored());
+                    const auto seekFrameIndexRange = mixxx::IndexRange::between(
+                            source.frameIndexMin() + source.frameLength() / 2,
+                            source.frameIndexMax());
+                    mixxx::SampleBuffer seekToEndData(
+                            source.getSignalInfo().frames2samples(
+                                    seekFrameIndexRange.length()));
+                    const auto seekToEndSampleFrames = source.readSampleFrames(
+                            mixxx::WritableSampleFrames(seekFrameIndexRange,
+                                    mixxx::SampleBuffer::WritableSlice(seekToEndData)));
+                    ASSERT_EQ(seekFrameIndexRange, seekToEndSampleFrames.frameIndexRange());
+                    source.close();
+                }
+                EXPECT_TRUE(QFile::exists(seekIndexFilePath));
+                mixxx::SoundSourceFFmpeg source(fileUrl);
+                ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                        source.open(mixxx::AudioSource::OpenMode::Strict));
+                EXPECT_TRUE(source.isSeekIndexRestored());
+            }
+        }
+    }
+
+    mixxx::SoundSourceFFmpeg::setSeekIndexDirPath(QString());
+}
+#endif
+
 TEST_F(SoundSourceProxyTest, regressionTestCachingReaderChunkJumpForward) {
     // NOTE(uklotzde, 2017-12-10): Potential regression test for an infinite
     // seek/read loop in SoundSourceMediaFoundation. Unfortunately this
@@ -0,0 +1,118 @@
+#include "analyzer/trackanalysisscheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+#include <memory>
+
+#include "test/mixxxdbtest.h"
+
+namespace {
+
+TrackId trackIdFor(int id) {
+    return TrackId(QVariant(id));
+}
+
+/// Doesn't load any tracks, but records the order in which the
+/// scheduler tries to load them. The tracks are skipped, so the
+/// scheduler walks through its whole queue in a single pass.
+class RecordingEnvironment : public TrackAnalysisSchedulerEnvironment {
+  public:
+    RecordingEnvironment(QHash<TrackId, double> durations,
+            QList<TrackId>* pLoadedTrackIds)
+            : m_durations(std::move(durations)),
+              m_pLoadedTrackIds(pLoadedTrackIds) {
+    }
+
+    TrackPointer loadTrackById(TrackId trackId) const override {
+        m_pLoadedTrackIds->append(trackId);
+        return TrackPointer();
+    }
+
+    QHash<TrackId, double> loadTrackDurationsSeconds(
+            const QSet<TrackId>& trackIds) const override {
+        QHash<TrackId, double> durations;
+        for (const auto& trackId : trackIds) {
+            if (m_durations.contains(trackId)) {
+                durations.insert(trackId, m_durations.value(trackId));
+            }
+        }
+        return durations;
+    }
+
+  private:
+    const QHash<TrackId, double> m_durations;
+    QList<TrackId>* const m_pLoadedTrackIds;
+};
+
+} // namespace
+
+class TrackAnalysisSchedulerTest : public MixxxDbTest {
+  protected:
+    /// Schedules the tracks 1..numTracks in this order and returns the
+    /// order in which they have been dequeued.
+    QList<TrackId> dequeueOrder(int numTracks, QHash<TrackId, double> durations) {
+        QList<TrackId> loadedTrackIds;
+        auto pScheduler = TrackAnalysisScheduler::createInstance(
+                std::make_unique<RecordingEnvironment>(
+                        std::move(durations), &loadedTrackIds),
+                1,
+                dbConnectionPooler(),
+                config(),
+                AnalyzerModeFlags::None);
+        QSignalSpy finishedSpy(pScheduler.get(), &TrackAnalysisScheduler::finished);
+        QList<AnalyzerScheduledTrack> tracks;
+        for (int id = 1; id <= numTracks; ++id) {
+            tracks.append(AnalyzerScheduledTrack(trackIdFor(id)));
+        }
+        EXPECT_EQ(numTracks, pScheduler->scheduleTracks(tracks));
+        pScheduler->resume();
+        EXPECT_TRUE(finishedSpy.wait(5000));
+        // The worker thread reports its exit with another finished()
+        // signal and must not outlive the database.
+        finishedSpy.clear();
+        pScheduler->stop();
+        EXPECT_TRUE(finishedSpy.wait(5000));
+        return loadedTrackIds;
+    }
+};
+
+TEST_F(TrackAnalysisSchedulerTest, LongestTracksFirst) {
+    QHash<TrackId, double> durations;
+    durations.insert(trackIdFor(1), 180.0);
+    durations.insert(trackIdFor(2), 3600.0);
+    durations.insert(trackIdFor(3), 60.0);
+    durations.insert(trackIdFor(4), 600.0);
+
+    const QList<TrackId> expectedOrder = {
+            trackIdFor(2),
+            trackIdFor(4),
+            trackIdFor(1),
+            trackIdFor(3),
+    };
+    EXPECT_EQ(expectedOrder, dequeueOrder(4, durations));
+}
+
+TEST_F(TrackAnalysisSchedulerTest, UnknownDurationsAreAverage) {
+    // The average of the known durations is 300 s
+    QHash<TrackId, double> durations;
+    durations.insert(trackIdFor(1), 60.0);
+    durations.insert(trackIdFor(3), 540.0);
+
+    const QList<TrackId> expectedOrder = {
+            trackIdFor(3),
+            trackIdFor(2),
+            trackIdFor(4),
+            trackIdFor(1),
+    };
+    EXPECT_EQ(expectedOrder, dequeueOrder(4, durations));
+}
+
+TEST_F(TrackAnalysisSchedulerTest, KeepsOrderWithoutDurations) {
+    const QList<TrackId> expectedOrder = {
+            trackIdFor(1),
+            trackIdFor(2),
+            trackIdFor(3),
+    };
+    EXPECT_EQ(expectedOrder, dequeueOrder(3, QHash<TrackId, double>()));
+}
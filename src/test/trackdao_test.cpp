@@ -56,3 +56,26 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, getTrackDurationsSecondsOfManyTracks) {
+    // More tracks than fit into a single query
+    constexpr int kTrackCount = 450;
+    QSet<TrackId> trackIds;
+    QHash<TrackId, double> expectedDurations;
+    for (int i = 0; i < kTrackCount; ++i) {
+        mixxx::FileInfo fileInfo(QDir(QDir::tempPath() + QStringLiteral("/durations")),
+                QStringLiteral("file%1.mp3").arg(i));
+        TrackPointer pTrack = Track::newTemporary(mixxx::FileAccess(fileInfo));
+        // The duration of the first track is unknown
+        pTrack->setDuration(i);
+        const TrackId trackId = internalCollection()->addTrack(pTrack, false);
+        ASSERT_TRUE(trackId.isValid());
+        trackIds.insert(trackId);
+        if (i > 0) {
+            expectedDurations.insert(trackId, i);
+        }
+    }
+
+    EXPECT_EQ(expectedDurations,
+            internalCollection()->getTrackDAO().getTrackDurationsSeconds(trackIds));
+}
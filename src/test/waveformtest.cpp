@@ -0,0 +1,114 @@
+#include "waveform/waveform.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+#include "util/math.h"
+
+namespace {
+
+class WaveformTest : public testing::Test {
+  protected:
+    WaveformTest()
+            // Odd number of visual frames
+            : m_waveform(44100, 44100 * 3 + 1100, 441, -1, 2) {
+        std::mt19937 gen; // explicitly don't seed for reproducibility
+        std::uniform_int_distribution<int> dis(0, 255);
+        WaveformData* pData = m_waveform.data();
+        for (int i = 0; i < m_waveform.getDataSize(); ++i) {
+            pData[i].filtered.low = static_cast<unsigned char>(dis(gen));
+            pData[i].filtered.mid = static_cast<unsigned char>(dis(gen));
+            pData[i].filtered.high = static_cast<unsigned char>(dis(gen));
+            pData[i].filtered.all = static_cast<unsigned char>(dis(gen));
+            pData[i].stems[0] = static_cast<unsigned char>(dis(gen));
+            pData[i].stems[1] = static_cast<unsigned char>(dis(gen));
+        }
+    }
+
+    /// The loop of the renderers
+    WaveformData scanMax(int visualIndexStart, int visualIndexStop, int channel) const {
+        WaveformData max{};
+        const WaveformData* pData = m_waveform.data();
+        for (int i = visualIndexStart + channel; i < visualIndexStop + channel; i += 2) {
+            max.filtered.low = math_max(max.filtered.low, pData[i].filtered.low);
+            max.filtered.mid = math_max(max.filtered.mid, pData[i].filtered.mid);
+            max.filtered.high = math_max(max.filtered.high, pData[i].filtered.high);
+            max.filtered.all = math_max(max.filtered.all, pData[i].filtered.all);
+            max.stems[0] = math_max(max.stems[0], pData[i].stems[0]);
+            max.stems[1] = math_max(max.stems[1], pData[i].stems[1]);
+        }
+        return max;
+    }
+
+    void expectMaxEqualsScan(int visualIndexStart, int visualIndexStop) const {
+        for (int chn = 0; chn < ChannelCount; ++chn) {
+            const WaveformData expected = scanMax(visualIndexStart, visualIndexStop, chn);
+            const WaveformData actual = m_waveform.getMax(visualIndexStart, visualIndexStop, chn);
+            EXPECT_EQ(expected.filtered.low, actual.filtered.low);
+            EXPECT_EQ(expected.filtered.mid, actual.filtered.mid);
+            EXPECT_EQ(expected.filtered.high, actual.filtered.high);
+            EXPECT_EQ(expected.filtered.all, actual.filtered.all);
+            EXPECT_EQ(expected.stems[0], actual.stems[0]);
+            EXPECT_EQ(expected.stems[1], actual.stems[1]);
+        }
+    }
+
+    Waveform m_waveform;
+};
+
+TEST_F(WaveformTest, GetMaxWithoutDecimatedLevels) {
+    expectMaxEqualsScan(0, 2);
+    expectMaxEqualsScan(10, 1000);
+    expectMaxEqualsScan(0, m_waveform.getDataSize() - 1);
+}
+
+TEST_F(WaveformTest, GetMaxWithDecimatedLevels) {
+    m_waveform.buildDecimatedLevels();
+    const int dataSize = m_waveform.getDataSize();
+    ASSERT_EQ(1, (dataSize / 2) % 2);
+
+    // Like the renderers
+    expectMaxEqualsScan(0, 2);
+    expectMaxEqualsScan(0, dataSize - 1);
+    expectMaxEqualsScan(dataSize - 4, dataSize - 1);
+    expectMaxEqualsScan(6, 6);
+
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> dis(0, dataSize / 2);
+    for (int i = 0; i < 1000; ++i) {
+        const int frameStart = dis(gen);
+        const int frameStop = std::min(frameStart + dis(gen) / (1 + i % 100), dataSize / 2);
+        expectMaxEqualsScan(frameStart * 2, std::min(frameStop * 2, dataSize - 1));
+    }
+}
+
+TEST_F(WaveformTest, RawByteArrayRoundTrip) {
+    const QByteArray data = m_waveform.toRawByteArray();
+    const Waveform waveform(data, Waveform::ByteArrayFormat::Raw);
+    ASSERT_EQ(m_waveform.getDataSize(), waveform.getDataSize());
+    EXPECT_EQ(waveform.getDataSize(), waveform.getCompletion());
+    EXPECT_EQ(m_waveform.getAudioVisualRatio(), waveform.getAudioVisualRatio());
+    EXPECT_TRUE(waveform.hasStem());
+    EXPECT_EQ(0,
+            std::memcmp(m_waveform.data(),
+                    waveform.data(),
+                    m_waveform.getDataSize() * sizeof(WaveformData)));
+    // The decimated levels are built when reading
+    EXPECT_EQ(m_waveform.getMax(0, m_waveform.getDataSize() - 1, Left).filtered.all,
+            waveform.getMax(0, waveform.getDataSize() - 1, Left).filtered.all);
+}
+
+TEST_F(WaveformTest, RawByteArrayRejectsCorruptData) {
+    const QByteArray data = m_waveform.toRawByteArray();
+    EXPECT_EQ(0,
+            Waveform(data.left(data.size() - 1), Waveform::ByteArrayFormat::Raw)
+                    .getDataSize());
+    // A protobuf is not a raw waveform
+    EXPECT_EQ(0,
+            Waveform(m_waveform.toByteArray(), Waveform::ByteArrayFormat::Raw)
+                    .getDataSize());
+}
+
+} // namespace
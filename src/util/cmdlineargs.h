@@ -72,6 +72,9 @@ class CmdlineArgs final {
         return m_logMaxFileSize;
     }
     bool getTimelineEnabled() const { return !m_timelinePath.isEmpty(); }
+    bool getRealtimeTraceEnabled() const {
+        return !m_realtimeTracePath.isEmpty();
+    }
     const QString& getLocale() const { return m_locale; }
     const QString& getSettingsPath() const { return m_settingsPath; }
     void setSettingsPath(const QString& newSettingsPath) {
@@ -79,6 +82,9 @@ class CmdlineArgs final {
     }
     const QString& getResourcePath() const { return m_resourcePath; }
     const QString& getTimelinePath() const { return m_timelinePath; }
+    const QString& getRealtimeTracePath() const {
+        return m_realtimeTracePath;
+    }
 
     const QString& getStyle() const {
         return m_styleName;
@@ -126,5 +132,6 @@ class CmdlineArgs final {
     QString m_settingsPath;
     QString m_resourcePath;
     QString m_timelinePath;
+    QString m_realtimeTracePath;
     QString m_styleName;
 };
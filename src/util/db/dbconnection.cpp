@@ -230,6 +230,30 @@ void sqliteLikeUtf8(sqlite3_context* context,
     return;
 }
 
+// This implements the latinlow() SQL function that folds a string like
+// the custom LIKE operator above, e.g. for storing it in an index.
+//static
+void sqliteLatinLowUtf16(sqlite3_context* context,
+        int aArgc,
+        sqlite3_value** aArgv) {
+    VERIFY_OR_DEBUG_ASSERT(aArgc == 1) {
+        return;
+    }
+
+    const void* data = sqlite3_value_text16(aArgv[0]);
+    if (!data) {
+        sqlite3_result_null(context);
+        return;
+    }
+    QString string(static_cast<const QChar*>(data),
+            sqlite3_value_bytes16(aArgv[0]) / static_cast<int>(sizeof(QChar)));
+    DbConnection::makeStringLatinLow(&string);
+    sqlite3_result_text16(context,
+            string.constData(),
+            static_cast<int>(string.size() * sizeof(QChar)),
+            SQLITE_TRANSIENT);
+}
+
 #endif // __SQLITE3__
 
 bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator) {
@@ -304,6 +328,21 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    result = sqlite3_create_function(
+            handle,
+            "latinlow",
+            1,
+            SQLITE_UTF16 | SQLITE_DETERMINISTIC,
+            nullptr,
+            sqliteLatinLowUtf16,
+            nullptr,
+            nullptr);
+    VERIFY_OR_DEBUG_ASSERT(result == SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to install custom LATINLOW function for SQLite3:"
+                << result;
+    }
 #else
     Q_UNUSED(database);
     Q_UNUSED(pCollator);
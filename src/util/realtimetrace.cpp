@@ -0,0 +1,405 @@
+#include "util/realtimetrace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("RealtimeTrace");
+
+using mixxx::RealtimeTrace;
+using mixxx::RealtimeTraceEvent;
+
+// 16 bytes per record, i.e. 1 MiB per thread. At 3 records per stage and
+// about 40 stages per callback this covers several seconds of audio even
+// with the smallest buffer sizes.
+constexpr std::size_t kCapacity = 1 << 16;
+static_assert((kCapacity & (kCapacity - 1)) == 0, "must be a power of 2");
+
+const auto kEpoch = std::chrono::steady_clock::now();
+
+struct Record {
+    std::int64_t timestampNanos;
+    RealtimeTraceEvent event;
+    RealtimeTrace::Phase phase;
+    int arg;
+};
+
+std::uint64_t packPayload(RealtimeTraceEvent event, RealtimeTrace::Phase phase, int arg) {
+    return static_cast<std::uint64_t>(event) |
+            (static_cast<std::uint64_t>(phase) << 8) |
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(arg)) << 32);
+}
+
+Record unpackRecord(std::int64_t timestampNanos, std::uint64_t payload) {
+    return Record{
+            timestampNanos,
+            static_cast<RealtimeTraceEvent>(payload & 0xFF),
+            static_cast<RealtimeTrace::Phase>((payload >> 8) & 0xFF),
+            static_cast<int>(static_cast<std::uint32_t>(payload >> 32)),
+    };
+}
+
+/// A single producer ring buffer that overwrites the oldest records.
+/// The slots are atomics, so the exporting thread may read them while the
+/// owning thread keeps on writing. The reader detects the records that
+/// might have been overwritten in the meantime with the reserve index,
+/// like a sequence lock.
+///
+/// The buffer is assigned to a single thread at a time. Releasing it starts
+/// a new lease, which invalidates the assignment to the previous thread.
+class ThreadTraceBuffer {
+  public:
+    explicit ThreadTraceBuffer(int threadId)
+            : m_threadId(threadId),
+              m_threadName(nullptr),
+              m_assigned(false),
+              m_pOwner(nullptr),
+              m_lease(0),
+              m_reserveIndex(0),
+              m_writeIndex(0) {
+    }
+
+    int threadId() const {
+        return m_threadId;
+    }
+
+    QString threadName() const {
+        const char* threadName = m_threadName.load(std::memory_order_acquire);
+        if (!threadName) {
+            return QStringLiteral("Thread %1").arg(m_threadId);
+        }
+        return QString::fromUtf8(threadName);
+    }
+
+    /// Whether the buffer has ever been assigned to a thread
+    bool hasThreadName() const {
+        return m_threadName.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// Returns false if the buffer is assigned to another thread
+    bool tryAssign(const char* threadName, const void* pOwner) {
+        bool assigned = false;
+        if (!m_assigned.compare_exchange_strong(
+                    assigned, true, std::memory_order_acquire)) {
+            return false;
+        }
+        m_pOwner.store(pOwner, std::memory_order_relaxed);
+        m_threadName.store(threadName, std::memory_order_release);
+        return true;
+    }
+
+    bool isAssigned() const {
+        return m_assigned.load(std::memory_order_acquire);
+    }
+
+    bool isAssignedTo(const void* pOwner) const {
+        return isAssigned() &&
+                m_pOwner.load(std::memory_order_relaxed) == pOwner;
+    }
+
+    void release() {
+        m_lease.fetch_add(1, std::memory_order_relaxed);
+        m_pOwner.store(nullptr, std::memory_order_relaxed);
+        m_assigned.store(false, std::memory_order_release);
+    }
+
+    std::uint32_t lease() const {
+        return m_lease.load(std::memory_order_relaxed);
+    }
+
+    void push(std::int64_t timestampNanos, std::uint64_t payload) {
+        const std::uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+        m_reserveIndex.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = m_slots[index & (kCapacity - 1)];
+        slot.timestampNanos.store(timestampNanos, std::memory_order_relaxed);
+        slot.payload.store(payload, std::memory_order_relaxed);
+        m_writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<Record> snapshot() const {
+        const std::uint64_t end = m_writeIndex.load(std::memory_order_acquire);
+        std::uint64_t begin = end > kCapacity ? end - kCapacity : 0;
+        std::vector<Record> records;
+        records.reserve(end - begin);
+        for (std::uint64_t index = begin; index < end; ++index) {
+            const Slot& slot = m_slots[index & (kCapacity - 1)];
+            records.push_back(unpackRecord(
+                    slot.timestampNanos.load(std::memory_order_relaxed),
+                    slot.payload.load(std::memory_order_relaxed)));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Discard the records that have been overwritten while copying
+        const std::uint64_t reserved = m_reserveIndex.load(std::memory_order_relaxed);
+        if (reserved > kCapacity && reserved - kCapacity > begin) {
+            const auto overwritten = std::min(reserved - kCapacity, end) - begin;
+            records.erase(records.begin(), records.begin() + overwritten);
+        }
+        return records;
+    }
+
+  private:
+    struct Slot {
+        std::atomic<std::int64_t> timestampNanos{0};
+        std::atomic<std::uint64_t> payload{0};
+    };
+
+    const int m_threadId;
+    std::atomic<const char*> m_threadName;
+    std::atomic<bool> m_assigned;
+    std::atomic<const void*> m_pOwner;
+    std::atomic<std::uint32_t> m_lease;
+    std::atomic<std::uint64_t> m_reserveIndex;
+    std::atomic<std::uint64_t> m_writeIndex;
+    std::array<Slot, kCapacity> m_slots;
+};
+
+constexpr int kMaxThreads = 256;
+
+// The number of unassigned buffers that are available after enabling,
+// enough for the engine thread, the engine channel workers and the
+// callbacks of additional sound devices.
+int numSpareThreadTraceBuffers() {
+    return QThread::idealThreadCount() + 4;
+}
+
+/// The buffers are never freed while Mixxx is running, so the events of
+/// threads that have finished in the meantime can still be exported.
+/// Allocated buffers are only appended, the counter is published after the
+/// corresponding buffers have been created. Released buffers are assigned
+/// to the next registered threads.
+struct ThreadTraceBufferRegistry {
+    // Serializes allocating, releasing and exporting the buffers
+    QMutex mutex;
+    std::array<std::unique_ptr<ThreadTraceBuffer>, kMaxThreads> buffers;
+    std::atomic<int> numAllocated{0};
+};
+
+ThreadTraceBufferRegistry& registry() {
+    static ThreadTraceBufferRegistry s_registry;
+    return s_registry;
+}
+
+thread_local ThreadTraceBuffer* t_pBuffer = nullptr;
+// The lease of t_pBuffer, which ends when the buffer is released
+thread_local std::uint32_t t_bufferLease = 0;
+
+bool isCurrentThreadRegistered() {
+    return t_pBuffer && t_pBuffer->lease() == t_bufferLease;
+}
+
+void allocateSpareThreadTraceBuffers() {
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const int numAllocated = reg.numAllocated.load(std::memory_order_relaxed);
+    int numAssigned = 0;
+    for (int i = 0; i < numAllocated; ++i) {
+        if (reg.buffers[i]->isAssigned()) {
+            ++numAssigned;
+        }
+    }
+    const int numRequired = std::min(kMaxThreads,
+            numAssigned + numSpareThreadTraceBuffers());
+    for (int i = numAllocated; i < numRequired; ++i) {
+        reg.buffers[i] = std::make_unique<ThreadTraceBuffer>(i + 1);
+    }
+    if (numRequired > numAllocated) {
+        reg.numAllocated.store(numRequired, std::memory_order_release);
+    }
+}
+
+QString jsonEscaped(QString str) {
+    return str.replace(QChar('\\'), QStringLiteral("\\\\"))
+            .replace(QChar('"'), QStringLiteral("\\\""));
+}
+
+} // anonymous namespace
+
+namespace mixxx {
+
+std::atomic<bool> RealtimeTrace::s_enabled{false};
+
+const char* realtimeTraceEventName(RealtimeTraceEvent event) {
+    switch (event) {
+    case RealtimeTraceEvent::EngineProcess:
+        return "EngineMixer::process";
+    case RealtimeTraceEvent::ProcessChannels:
+        return "EngineMixer::processChannels";
+    case RealtimeTraceEvent::ChannelProcess:
+        return "EngineChannel::process";
+    case RealtimeTraceEvent::HeadphoneMix:
+        return "HeadphoneMix";
+    case RealtimeTraceEvent::TalkoverMix:
+        return "TalkoverMix";
+    case RealtimeTraceEvent::BusMix:
+        return "BusMix";
+    case RealtimeTraceEvent::BusEffects:
+        return "BusEffects";
+    case RealtimeTraceEvent::MainEffects:
+        return "MainEffects";
+    case RealtimeTraceEvent::Sidechain:
+        return "Sidechain";
+    case RealtimeTraceEvent::VuMeters:
+        return "VuMeters";
+    case RealtimeTraceEvent::Underflow:
+        return "Underflow";
+    }
+    DEBUG_ASSERT(!"unknown RealtimeTraceEvent");
+    return "Unknown";
+}
+
+// static
+void RealtimeTrace::setEnabled(bool enabled) {
+    if (enabled) {
+        allocateSpareThreadTraceBuffers();
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// static
+bool RealtimeTrace::registerCurrentThread(const char* threadName, const void* pOwner) {
+    DEBUG_ASSERT(pOwner);
+    if (isCurrentThreadRegistered()) {
+        return true;
+    }
+    t_pBuffer = nullptr;
+    auto& reg = registry();
+    const int numAllocated = reg.numAllocated.load(std::memory_order_acquire);
+    for (int i = 0; i < numAllocated; ++i) {
+        ThreadTraceBuffer* pBuffer = reg.buffers[i].get();
+        if (pBuffer->tryAssign(threadName, pOwner)) {
+            t_pBuffer = pBuffer;
+            t_bufferLease = pBuffer->lease();
+            return true;
+        }
+    }
+    return false;
+}
+
+// static
+void RealtimeTrace::releaseThreads(const void* pOwner) {
+    VERIFY_OR_DEBUG_ASSERT(pOwner) {
+        return;
+    }
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const int numAllocated = reg.numAllocated.load(std::memory_order_relaxed);
+    for (int i = 0; i < numAllocated; ++i) {
+        ThreadTraceBuffer* pBuffer = reg.buffers[i].get();
+        if (pBuffer->isAssignedTo(pOwner)) {
+            pBuffer->release();
+        }
+    }
+}
+
+// static
+void RealtimeTrace::record(RealtimeTraceEvent event, Phase phase, int arg) {
+    if (!isCurrentThreadRegistered()) {
+        // The thread has not been registered or its buffer has been
+        // released, see registerCurrentThread()
+        return;
+    }
+    const auto timestampNanos =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - kEpoch)
+                    .count();
+    t_pBuffer->push(timestampNanos, packPayload(event, phase, arg));
+}
+
+// static
+bool RealtimeTrace::writeChromeTrace(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        kLogger.warning() << "Could not open trace file for writing:" << fileName;
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&out, &first]() {
+        if (!first) {
+            out << ",";
+        }
+        out << "\n";
+        first = false;
+    };
+
+    int numRecords = 0;
+    auto& reg = registry();
+    const auto locker = lockMutex(&reg.mutex);
+    const int numAllocated = reg.numAllocated.load(std::memory_order_relaxed);
+    int numThreads = 0;
+    for (int i = 0; i < numAllocated; ++i) {
+        const ThreadTraceBuffer* pBuffer = reg.buffers[i].get();
+        if (!pBuffer->hasThreadName()) {
+            // Has never been assigned to a thread
+            continue;
+        }
+        ++numThreads;
+        const int tid = pBuffer->threadId();
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << tid << ",\"args\":{\"name\":\""
+            << jsonEscaped(pBuffer->threadName()) << "\"}}";
+
+        // The oldest records may be end events of spans whose begin event has
+        // already been overwritten. Skip them to keep the nesting valid.
+        int depth = 0;
+        for (const auto& record : pBuffer->snapshot()) {
+            const char* phase = "i";
+            switch (record.phase) {
+            case Phase::Begin:
+                phase = "B";
+                ++depth;
+                break;
+            case Phase::End:
+                if (depth == 0) {
+                    continue;
+                }
+                phase = "E";
+                --depth;
+                break;
+            case Phase::Instant:
+                break;
+            }
+            separator();
+            out << "{\"name\":\"" << realtimeTraceEventName(record.event)
+                << "\",\"cat\":\"engine\",\"ph\":\"" << phase
+                << "\",\"ts\":"
+                << QString::number(record.timestampNanos / 1000.0, 'f', 3)
+                << ",\"pid\":" << pid << ",\"tid\":" << tid;
+            if (record.phase == Phase::Instant) {
+                // Show instant events like underflows across all threads
+                out << ",\"s\":\"g\"";
+            }
+            if (record.arg >= 0) {
+                out << ",\"args\":{\"arg\":" << record.arg << "}";
+            }
+            out << "}";
+            ++numRecords;
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    kLogger.info()
+            << "Wrote" << numRecords << "events of" << numThreads
+            << "threads to" << fileName;
+    return file.error() == QFileDevice::NoError;
+}
+
+} // namespace mixxx
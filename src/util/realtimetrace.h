@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstdint>
+
+namespace mixxx {
+
+/// The events that can be recorded by RealtimeTrace. Only these IDs are
+/// stored in the trace buffers, the names are looked up when exporting,
+/// so recording an event never touches a string.
+enum class RealtimeTraceEvent : std::uint8_t {
+    EngineProcess,
+    ProcessChannels,
+    ChannelProcess,
+    HeadphoneMix,
+    TalkoverMix,
+    BusMix,
+    BusEffects,
+    MainEffects,
+    Sidechain,
+    VuMeters,
+    Underflow,
+};
+
+const char* realtimeTraceEventName(RealtimeTraceEvent event);
+
+/// RealtimeTrace is a flight recorder for the audio threads, meant to find
+/// out which stage of the engine made a callback miss its deadline.
+///
+/// Each thread records into its own fixed size ring buffer, overwriting the
+/// oldest records when full. The buffers are allocated when tracing is
+/// enabled and assigned to the threads by registerCurrentThread() until
+/// their owner returns them with releaseThreads(). Events of threads that
+/// have not been registered are dropped. Recording is
+/// wait-free and does not allocate. When tracing is disabled (the default)
+/// recording an event is a single relaxed atomic load.
+///
+/// The recorded events can be written in the Chrome trace event format at any
+/// time, which can be opened in https://ui.perfetto.dev or chrome://tracing.
+class RealtimeTrace final {
+  public:
+    enum class Phase : std::uint8_t {
+        Begin,
+        End,
+        Instant,
+    };
+
+    /// Enabling allocates the buffers for the threads that register
+    /// afterwards, so it must not be called from a realtime thread.
+    static void setEnabled(bool enabled);
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Assigns one of the buffers that have been allocated by setEnabled()
+    /// to the calling thread, if it hasn't got one yet. This neither locks
+    /// nor allocates, so realtime threads can register themselves before
+    /// recording their first event. Returns false if all buffers are in use.
+    ///
+    /// @param threadName must be a string literal, it is referenced until
+    /// the events are exported.
+    /// @param pOwner identifies the threads that are released together by
+    /// releaseThreads(), e.g. the sound device.
+    static bool registerCurrentThread(const char* threadName, const void* pOwner);
+
+    /// Returns the buffers of all threads that have been registered with
+    /// the owner, so they can be assigned to other threads. Must be called
+    /// when these threads have stopped recording, e.g. after the stream of
+    /// a sound device has been closed. The events recorded so far are kept
+    /// and exported together with those of the next thread that is assigned
+    /// the buffer. A released thread that is still running drops its events
+    /// until it registers again.
+    static void releaseThreads(const void* pOwner);
+
+    /// @param arg an optional event specific value, e.g. the channel handle.
+    /// Negative values are omitted from the export.
+    static void begin(RealtimeTraceEvent event, int arg = -1) {
+        if (isEnabled()) {
+            record(event, Phase::Begin, arg);
+        }
+    }
+    static void end(RealtimeTraceEvent event, int arg = -1) {
+        if (isEnabled()) {
+            record(event, Phase::End, arg);
+        }
+    }
+    static void instant(RealtimeTraceEvent event, int arg = -1) {
+        if (isEnabled()) {
+            record(event, Phase::Instant, arg);
+        }
+    }
+
+    /// Writes the events recorded by all threads so far. This must not be
+    /// called from a realtime thread, but may be called while recording.
+    static bool writeChromeTrace(const QString& fileName);
+
+  private:
+    static void record(RealtimeTraceEvent event, Phase phase, int arg);
+
+    static std::atomic<bool> s_enabled;
+};
+
+/// Records a begin event when constructed and the matching end event when
+/// destroyed.
+class ScopedRealtimeTrace final {
+  public:
+    explicit ScopedRealtimeTrace(RealtimeTraceEvent event, int arg = -1)
+            : m_event(event),
+              m_arg(arg) {
+        RealtimeTrace::begin(m_event, m_arg);
+    }
+    ~ScopedRealtimeTrace() {
+        RealtimeTrace::end(m_event, m_arg);
+    }
+
+    ScopedRealtimeTrace(const ScopedRealtimeTrace&) = delete;
+    ScopedRealtimeTrace& operator=(const ScopedRealtimeTrace&) = delete;
+
+  private:
+    const RealtimeTraceEvent m_event;
+    const int m_arg;
+};
+
+} // namespace mixxx
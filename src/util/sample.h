@@ -9,6 +9,10 @@
 #include "util/types.h"
 
 // A group of utilities for working with samples.
+//
+// The inner loops of the most frequently used functions are dispatched
+// at runtime to explicitly vectorized kernels for the instruction set
+// of the CPU, see util/samplekernels.h.
 class SampleUtil {
   public:
     // If more audio channels are added in the future, this can be used
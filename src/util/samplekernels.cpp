@@ -0,0 +1,133 @@
+#include "util/samplekernels.h"
+
+#include "util/logger.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MIXXX_SAMPLEKERNELS_X86
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+namespace {
+
+const mixxx::Logger kLogger("SampleKernels");
+
+#if defined(MIXXX_SAMPLEKERNELS_X86)
+
+struct X86Features {
+    bool sse2 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+X86Features detectX86Features() {
+    X86Features features;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    features.sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // The OS must save and restore the extended registers on context
+    // switches: XMM and YMM (bits 1, 2) plus opmask and ZMM (bits 5, 6, 7)
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool osAvx = (xcr0 & 0x06) == 0x06;
+    const bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = avx && osAvx && (info[1] & (1 << 5)) != 0;
+        features.avx512f = osAvx512 && (info[1] & (1 << 16)) != 0;
+    }
+#elif defined(__GNUC__)
+    // Also checks if the OS supports the extended registers
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+    return features;
+}
+
+const X86Features& x86Features() {
+    static const X86Features features = detectX86Features();
+    return features;
+}
+
+#endif
+
+const mixxx::SampleKernels& selectKernels() {
+    const mixxx::SimdLevel levels[] = {
+            mixxx::SimdLevel::Avx512,
+            mixxx::SimdLevel::Avx2,
+            mixxx::SimdLevel::Sse2,
+            mixxx::SimdLevel::Neon,
+    };
+    for (const auto level : levels) {
+        const auto* pKernels = mixxx::samplekernels::forSimdLevel(level);
+        if (pKernels) {
+            kLogger.info()
+                    << "Using"
+                    << mixxx::simdLevelName(level)
+                    << "sample kernels";
+            return *pKernels;
+        }
+    }
+    kLogger.info() << "Using scalar sample kernels";
+    return mixxx::samplekernels::scalar();
+}
+
+} // anonymous namespace
+
+namespace mixxx {
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "Scalar";
+    case SimdLevel::Sse2:
+        return "SSE2";
+    case SimdLevel::Avx2:
+        return "AVX2";
+    case SimdLevel::Avx512:
+        return "AVX-512";
+    case SimdLevel::Neon:
+        return "NEON";
+    }
+    return "Unknown";
+}
+
+namespace samplekernels {
+
+const SampleKernels* forSimdLevel(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return &scalar();
+#if defined(MIXXX_SAMPLEKERNELS_X86)
+    case SimdLevel::Sse2:
+        return x86Features().sse2 ? sse2() : nullptr;
+    case SimdLevel::Avx2:
+        return x86Features().avx2 ? avx2() : nullptr;
+    case SimdLevel::Avx512:
+        return x86Features().avx512f ? avx512() : nullptr;
+#endif
+    case SimdLevel::Neon:
+        // NEON is part of the baseline of all ARM builds that enable it,
+        // no need for a runtime check.
+        return neon();
+    default:
+        return nullptr;
+    }
+}
+
+const SampleKernels& active() {
+    static const SampleKernels& kernels = selectKernels();
+    return kernels;
+}
+
+} // namespace samplekernels
+
+} // namespace mixxx
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "util/types.h"
+
+namespace mixxx {
+
+/// The instruction sets with explicitly vectorized sample kernels.
+/// The values are stable and used as benchmark arguments.
+enum class SimdLevel {
+    Scalar = 0,
+    Sse2 = 1,
+    Avx2 = 2,
+    Avx512 = 3,
+    Neon = 4,
+};
+
+const char* simdLevelName(SimdLevel level);
+
+/// The inner loops of the performance critical SampleUtil functions.
+///
+/// SampleUtil handles all special cases like unity or zero gains and then
+/// dispatches to the kernels of the best instruction set that is supported
+/// by both the build and the CPU at runtime. The kernels of all instruction
+/// sets must produce the same results as the scalar kernels, except for
+/// rounding differences caused by a different order of summation.
+///
+/// Ramping gains are applied per stereo frame, i.e. the gain for frame i
+/// is startGain + gainDelta * i.
+struct SampleKernels {
+    SimdLevel level;
+
+    void (*applyGain)(CSAMPLE* pBuffer,
+            CSAMPLE_GAIN gain,
+            SINT numSamples);
+    void (*applyRampingGain)(CSAMPLE* pBuffer,
+            CSAMPLE_GAIN startGain,
+            CSAMPLE_GAIN gainDelta,
+            SINT numFrames);
+    void (*copyWithGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN gain,
+            SINT numSamples);
+    void (*copyWithRampingGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN startGain,
+            CSAMPLE_GAIN gainDelta,
+            SINT numFrames);
+    void (*addWithGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN gain,
+            SINT numSamples);
+    void (*addWithRampingGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            CSAMPLE_GAIN startGain,
+            CSAMPLE_GAIN gainDelta,
+            SINT numFrames);
+    void (*add2WithGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc1,
+            CSAMPLE_GAIN gain1,
+            const CSAMPLE* pSrc2,
+            CSAMPLE_GAIN gain2,
+            SINT numSamples);
+    void (*add3WithGain)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc1,
+            CSAMPLE_GAIN gain1,
+            const CSAMPLE* pSrc2,
+            CSAMPLE_GAIN gain2,
+            const CSAMPLE* pSrc3,
+            CSAMPLE_GAIN gain3,
+            SINT numSamples);
+    /// A channel is clipping if any of its samples exceeds CSAMPLE_PEAK.
+    void (*sumAbsPerChannel)(CSAMPLE* pSumAbsL,
+            CSAMPLE* pSumAbsR,
+            bool* pClippingL,
+            bool* pClippingR,
+            const CSAMPLE* pBuffer,
+            SINT numFrames);
+    void (*interleaveStereo)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc1,
+            const CSAMPLE* pSrc2,
+            SINT numFrames);
+    void (*deinterleaveStereo)(CSAMPLE* pDest1,
+            CSAMPLE* pDest2,
+            const CSAMPLE* pSrc,
+            SINT numFrames);
+    /// Overwrites pDest with the sum of the 4 stereo channels of an
+    /// 8 channel (stem) buffer.
+    void (*mixStemsToStereo)(CSAMPLE* pDest,
+            const CSAMPLE* pSrc,
+            SINT numFrames);
+};
+
+namespace samplekernels {
+
+const SampleKernels& scalar();
+
+// The kernels of the following instruction sets are only available
+// if enabled for the build, otherwise nullptr is returned. The caller
+// is responsible for checking the CPU features before invoking them.
+const SampleKernels* sse2();
+const SampleKernels* avx2();
+const SampleKernels* avx512();
+const SampleKernels* neon();
+
+/// Returns nullptr if the kernels are either not available in this build
+/// or not supported by the CPU.
+const SampleKernels* forSimdLevel(SimdLevel level);
+
+/// The kernels that are used by SampleUtil. They are selected once
+/// when first accessed.
+const SampleKernels& active();
+
+} // namespace samplekernels
+
+} // namespace mixxx
@@ -0,0 +1,102 @@
+// This file is compiled with AVX2 enabled, see CMakeLists.txt. The kernels
+// must only be invoked after checking the CPU features at runtime.
+#include "util/samplekernels.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#include "util/samplekernelsimpl.h"
+
+namespace {
+
+struct Avx2 {
+    using Reg = __m256;
+    static constexpr SINT kWidth = 8;
+
+    static Reg load(const CSAMPLE* p) {
+        return _mm256_loadu_ps(p);
+    }
+    static void store(CSAMPLE* p, Reg r) {
+        _mm256_storeu_ps(p, r);
+    }
+    static Reg set1(CSAMPLE value) {
+        return _mm256_set1_ps(value);
+    }
+    static Reg zero() {
+        return _mm256_setzero_ps();
+    }
+    static Reg add(Reg a, Reg b) {
+        return _mm256_add_ps(a, b);
+    }
+    static Reg mul(Reg a, Reg b) {
+        return _mm256_mul_ps(a, b);
+    }
+    static Reg abs(Reg a) {
+        // Clear the sign bit
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+    }
+    static Reg max(Reg a, Reg b) {
+        return _mm256_max_ps(a, b);
+    }
+    static Reg frameOffsets() {
+        return _mm256_setr_ps(0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f);
+    }
+    static void interleave(Reg a, Reg b, Reg* pLo, Reg* pHi) {
+        // The unpack instructions operate on each 128-bit lane separately:
+        // {a0, b0, a1, b1 | a4, b4, a5, b5} and {a2, b2, a3, b3 | a6, b6, a7, b7}
+        const Reg lo = _mm256_unpacklo_ps(a, b);
+        const Reg hi = _mm256_unpackhi_ps(a, b);
+        *pLo = _mm256_permute2f128_ps(lo, hi, 0x20);
+        *pHi = _mm256_permute2f128_ps(lo, hi, 0x31);
+    }
+    static void deinterleave(Reg lo, Reg hi, Reg* pA, Reg* pB) {
+        // {a0, b0, a1, b1 | a4, b4, a5, b5} and {a2, b2, a3, b3 | a6, b6, a7, b7}
+        const Reg t0 = _mm256_permute2f128_ps(lo, hi, 0x20);
+        const Reg t1 = _mm256_permute2f128_ps(lo, hi, 0x31);
+        *pA = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0));
+        *pB = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+    static Reg mixStemFrames(const CSAMPLE* pSrc) {
+        // Each register contains a whole frame with 8 channels
+        const Reg f0 = _mm256_loadu_ps(pSrc);
+        const Reg f1 = _mm256_loadu_ps(pSrc + 8);
+        const Reg f2 = _mm256_loadu_ps(pSrc + 16);
+        const Reg f3 = _mm256_loadu_ps(pSrc + 24);
+        // {f0: L0 + L2, R0 + R2, L1 + L3, R1 + R3 | f2: ...}
+        const Reg t02 = _mm256_add_ps(
+                _mm256_permute2f128_ps(f0, f2, 0x20),
+                _mm256_permute2f128_ps(f0, f2, 0x31));
+        // {f1: L0 + L2, R0 + R2, L1 + L3, R1 + R3 | f3: ...}
+        const Reg t13 = _mm256_add_ps(
+                _mm256_permute2f128_ps(f1, f3, 0x20),
+                _mm256_permute2f128_ps(f1, f3, 0x31));
+        // {f0 L, f0 R, f1 L, f1 R | f2 L, f2 R, f3 L, f3 R}
+        return _mm256_add_ps(
+                _mm256_shuffle_ps(t02, t13, _MM_SHUFFLE(1, 0, 1, 0)),
+                _mm256_shuffle_ps(t02, t13, _MM_SHUFFLE(3, 2, 3, 2)));
+    }
+};
+
+constexpr mixxx::SampleKernels kAvx2Kernels =
+        mixxx::samplekernels::impl::makeKernels<Avx2>(mixxx::SimdLevel::Avx2);
+
+} // anonymous namespace
+
+#endif
+
+namespace mixxx {
+
+namespace samplekernels {
+
+const SampleKernels* avx2() {
+#if defined(__AVX2__)
+    return &kAvx2Kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace samplekernels
+
+} // namespace mixxx
@@ -0,0 +1,136 @@
+// This file is compiled with AVX-512F enabled, see CMakeLists.txt. The kernels
+// must only be invoked after checking the CPU features at runtime.
+#include "util/samplekernels.h"
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+#include "util/samplekernelsimpl.h"
+
+namespace {
+
+struct Avx512 {
+    using Reg = __m512;
+    static constexpr SINT kWidth = 16;
+
+    static Reg load(const CSAMPLE* p) {
+        return _mm512_loadu_ps(p);
+    }
+    static void store(CSAMPLE* p, Reg r) {
+        _mm512_storeu_ps(p, r);
+    }
+    static Reg set1(CSAMPLE value) {
+        return _mm512_set1_ps(value);
+    }
+    static Reg zero() {
+        return _mm512_setzero_ps();
+    }
+    static Reg add(Reg a, Reg b) {
+        return _mm512_add_ps(a, b);
+    }
+    static Reg mul(Reg a, Reg b) {
+        return _mm512_mul_ps(a, b);
+    }
+    // The unmasked _mm512_abs_ps() and _mm512_max_ps() of GCC pass an
+    // undefined register to the masked builtins, which triggers
+    // -Wmaybe-uninitialized. The zero masking variants with all lanes
+    // selected are equivalent.
+    static Reg abs(Reg a) {
+        // Clear the sign bit
+        return _mm512_castsi512_ps(_mm512_maskz_and_epi32(0xFFFF,
+                _mm512_castps_si512(a),
+                _mm512_set1_epi32(0x7FFFFFFF)));
+    }
+    static Reg max(Reg a, Reg b) {
+        return _mm512_maskz_max_ps(0xFFFF, a, b);
+    }
+    static Reg frameOffsets() {
+        return _mm512_setr_ps(0.0f,
+                0.0f,
+                1.0f,
+                1.0f,
+                2.0f,
+                2.0f,
+                3.0f,
+                3.0f,
+                4.0f,
+                4.0f,
+                5.0f,
+                5.0f,
+                6.0f,
+                6.0f,
+                7.0f,
+                7.0f);
+    }
+    static void interleave(Reg a, Reg b, Reg* pLo, Reg* pHi) {
+        // Indices >= 16 select from b
+        const __m512i loIndices = _mm512_setr_epi32(
+                0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        const __m512i hiIndices = _mm512_setr_epi32(
+                8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+        *pLo = _mm512_permutex2var_ps(a, loIndices, b);
+        *pHi = _mm512_permutex2var_ps(a, hiIndices, b);
+    }
+    static void deinterleave(Reg lo, Reg hi, Reg* pA, Reg* pB) {
+        // Indices >= 16 select from hi
+        const __m512i evenIndices = _mm512_setr_epi32(
+                0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        const __m512i oddIndices = _mm512_setr_epi32(
+                1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+        *pA = _mm512_permutex2var_ps(lo, evenIndices, hi);
+        *pB = _mm512_permutex2var_ps(lo, oddIndices, hi);
+    }
+    static Reg mixStemFrames(const CSAMPLE* pSrc) {
+        // Each register contains two whole frames with 8 channels:
+        // {L0, R0, L1, R1, L2, R2, L3, R3 | L0, R0, L1, R1, L2, R2, L3, R3}
+        const Reg f01 = _mm512_loadu_ps(pSrc);
+        const Reg f23 = _mm512_loadu_ps(pSrc + 16);
+        const Reg f45 = _mm512_loadu_ps(pSrc + 32);
+        const Reg f67 = _mm512_loadu_ps(pSrc + 48);
+        // Sum up the first and the second half of each frame.
+        // Indices >= 16 select from the second register.
+        const __m512i firstHalves = _mm512_setr_epi32(
+                0, 1, 2, 3, 8, 9, 10, 11, 16, 17, 18, 19, 24, 25, 26, 27);
+        const __m512i secondHalves = _mm512_setr_epi32(
+                4, 5, 6, 7, 12, 13, 14, 15, 20, 21, 22, 23, 28, 29, 30, 31);
+        // {f0: L0 + L2, R0 + R2, L1 + L3, R1 + R3, f1: ..., f2: ..., f3: ...}
+        const Reg t0123 = _mm512_add_ps(
+                _mm512_permutex2var_ps(f01, firstHalves, f23),
+                _mm512_permutex2var_ps(f01, secondHalves, f23));
+        const Reg t4567 = _mm512_add_ps(
+                _mm512_permutex2var_ps(f45, firstHalves, f67),
+                _mm512_permutex2var_ps(f45, secondHalves, f67));
+        // Finally sum up the pairs of stereo channels
+        const __m512i firstPairs = _mm512_setr_epi32(
+                0, 1, 4, 5, 8, 9, 12, 13, 16, 17, 20, 21, 24, 25, 28, 29);
+        const __m512i secondPairs = _mm512_setr_epi32(
+                2, 3, 6, 7, 10, 11, 14, 15, 18, 19, 22, 23, 26, 27, 30, 31);
+        return _mm512_add_ps(
+                _mm512_permutex2var_ps(t0123, firstPairs, t4567),
+                _mm512_permutex2var_ps(t0123, secondPairs, t4567));
+    }
+};
+
+constexpr mixxx::SampleKernels kAvx512Kernels =
+        mixxx::samplekernels::impl::makeKernels<Avx512>(mixxx::SimdLevel::Avx512);
+
+} // anonymous namespace
+
+#endif
+
+namespace mixxx {
+
+namespace samplekernels {
+
+const SampleKernels* avx512() {
+#if defined(__AVX512F__)
+    return &kAvx512Kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace samplekernels
+
+} // namespace mixxx
@@ -0,0 +1,85 @@
+#include "util/samplekernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#include "util/samplekernelsimpl.h"
+
+namespace {
+
+struct Neon {
+    using Reg = float32x4_t;
+    static constexpr SINT kWidth = 4;
+
+    static Reg load(const CSAMPLE* p) {
+        return vld1q_f32(p);
+    }
+    static void store(CSAMPLE* p, Reg r) {
+        vst1q_f32(p, r);
+    }
+    static Reg set1(CSAMPLE value) {
+        return vdupq_n_f32(value);
+    }
+    static Reg zero() {
+        return vdupq_n_f32(0.0f);
+    }
+    static Reg add(Reg a, Reg b) {
+        return vaddq_f32(a, b);
+    }
+    static Reg mul(Reg a, Reg b) {
+        return vmulq_f32(a, b);
+    }
+    static Reg abs(Reg a) {
+        return vabsq_f32(a);
+    }
+    static Reg max(Reg a, Reg b) {
+        return vmaxq_f32(a, b);
+    }
+    static Reg frameOffsets() {
+        // {0, 0, 1, 1}
+        return vcombine_f32(vdup_n_f32(0.0f), vdup_n_f32(1.0f));
+    }
+    static void interleave(Reg a, Reg b, Reg* pLo, Reg* pHi) {
+        const float32x4x2_t zipped = vzipq_f32(a, b);
+        *pLo = zipped.val[0];
+        *pHi = zipped.val[1];
+    }
+    static void deinterleave(Reg lo, Reg hi, Reg* pA, Reg* pB) {
+        const float32x4x2_t unzipped = vuzpq_f32(lo, hi);
+        *pA = unzipped.val[0];
+        *pB = unzipped.val[1];
+    }
+    static Reg mixStemFrames(const CSAMPLE* pSrc) {
+        // {L0, R0, L1, R1} + {L2, R2, L3, R3} of both frames
+        const Reg a = vaddq_f32(vld1q_f32(pSrc), vld1q_f32(pSrc + 4));
+        const Reg b = vaddq_f32(vld1q_f32(pSrc + 8), vld1q_f32(pSrc + 12));
+        // {a0 + a2, a1 + a3, b0 + b2, b1 + b3}
+        return vcombine_f32(
+                vadd_f32(vget_low_f32(a), vget_high_f32(a)),
+                vadd_f32(vget_low_f32(b), vget_high_f32(b)));
+    }
+};
+
+constexpr mixxx::SampleKernels kNeonKernels =
+        mixxx::samplekernels::impl::makeKernels<Neon>(mixxx::SimdLevel::Neon);
+
+} // anonymous namespace
+
+#endif
+
+namespace mixxx {
+
+namespace samplekernels {
+
+const SampleKernels* neon() {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return &kNeonKernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace samplekernels
+
+} // namespace mixxx
@@ -0,0 +1,81 @@
+#include "util/samplekernels.h"
+
+#if defined(__SSE2__) && !defined(__EMSCRIPTEN__)
+
+#include <emmintrin.h>
+
+#include "util/samplekernelsimpl.h"
+
+namespace {
+
+struct Sse2 {
+    using Reg = __m128;
+    static constexpr SINT kWidth = 4;
+
+    static Reg load(const CSAMPLE* p) {
+        return _mm_loadu_ps(p);
+    }
+    static void store(CSAMPLE* p, Reg r) {
+        _mm_storeu_ps(p, r);
+    }
+    static Reg set1(CSAMPLE value) {
+        return _mm_set1_ps(value);
+    }
+    static Reg zero() {
+        return _mm_setzero_ps();
+    }
+    static Reg add(Reg a, Reg b) {
+        return _mm_add_ps(a, b);
+    }
+    static Reg mul(Reg a, Reg b) {
+        return _mm_mul_ps(a, b);
+    }
+    static Reg abs(Reg a) {
+        // Clear the sign bit
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+    }
+    static Reg max(Reg a, Reg b) {
+        return _mm_max_ps(a, b);
+    }
+    static Reg frameOffsets() {
+        return _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+    }
+    static void interleave(Reg a, Reg b, Reg* pLo, Reg* pHi) {
+        *pLo = _mm_unpacklo_ps(a, b);
+        *pHi = _mm_unpackhi_ps(a, b);
+    }
+    static void deinterleave(Reg lo, Reg hi, Reg* pA, Reg* pB) {
+        *pA = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        *pB = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+    static Reg mixStemFrames(const CSAMPLE* pSrc) {
+        // {L0, R0, L1, R1} + {L2, R2, L3, R3} of both frames
+        const Reg a = _mm_add_ps(_mm_loadu_ps(pSrc), _mm_loadu_ps(pSrc + 4));
+        const Reg b = _mm_add_ps(_mm_loadu_ps(pSrc + 8), _mm_loadu_ps(pSrc + 12));
+        // {a0 + a2, a1 + a3, b0 + b2, b1 + b3}
+        return _mm_add_ps(_mm_movelh_ps(a, b), _mm_movehl_ps(b, a));
+    }
+};
+
+constexpr mixxx::SampleKernels kSse2Kernels =
+        mixxx::samplekernels::impl::makeKernels<Sse2>(mixxx::SimdLevel::Sse2);
+
+} // anonymous namespace
+
+#endif
+
+namespace mixxx {
+
+namespace samplekernels {
+
+const SampleKernels* sse2() {
+#if defined(__SSE2__) && !defined(__EMSCRIPTEN__)
+    return &kSse2Kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace samplekernels
+
+} // namespace mixxx
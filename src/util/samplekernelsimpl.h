@@ -0,0 +1,324 @@
+#pragma once
+
+// Generic implementation of the vectorized sample kernels. This header must
+// only be included by the translation units that instantiate the kernels for
+// a particular instruction set, i.e. src/util/samplekernels_*.cpp.
+//
+// The type parameter V wraps the intrinsics of an instruction set:
+//
+//     struct V {
+//         using Reg = ...;
+//         static constexpr SINT kWidth = ...; // even number of samples
+//         static Reg load(const CSAMPLE* p);  // unaligned
+//         static void store(CSAMPLE* p, Reg r); // unaligned
+//         static Reg set1(CSAMPLE value);
+//         static Reg zero();
+//         static Reg add(Reg a, Reg b);
+//         static Reg mul(Reg a, Reg b);
+//         static Reg abs(Reg a);
+//         static Reg max(Reg a, Reg b);
+//         // {0, 0, 1, 1, 2, 2, ...}
+//         static Reg frameOffsets();
+//         // {a0, b0, a1, b1, ...} in *pLo and *pHi
+//         static void interleave(Reg a, Reg b, Reg* pLo, Reg* pHi);
+//         static void deinterleave(Reg lo, Reg hi, Reg* pA, Reg* pB);
+//         // Sums the 4 stereo channels of kWidth / 2 frames with 8 channels
+//         static Reg mixStemFrames(const CSAMPLE* pSrc);
+//     };
+//
+// V must have internal linkage, i.e. be declared in an anonymous namespace.
+// Otherwise the linker might merge template instances that have been
+// compiled for different instruction sets!
+//
+// Unlike the scalar kernels in sample.cpp, these loops never rely on
+// auto-vectorization. The scalar remainder loops handle the samples that
+// do not fill a whole register.
+
+#include "util/samplekernels.h"
+
+namespace mixxx {
+
+namespace samplekernels {
+
+namespace impl {
+
+template<typename V>
+void applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain, SINT numSamples) {
+    const auto vGain = V::set1(gain);
+    SINT i = 0;
+    for (; i + V::kWidth <= numSamples; i += V::kWidth) {
+        V::store(pBuffer + i, V::mul(V::load(pBuffer + i), vGain));
+    }
+    for (; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+template<typename V>
+void applyRampingGain(CSAMPLE* pBuffer,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const auto vStartGain = V::set1(startGain);
+    const auto vGainDelta = V::set1(gainDelta);
+    const auto vFrameOffsets = V::frameOffsets();
+    SINT i = 0;
+    for (; i + V::kWidth / 2 <= numFrames; i += V::kWidth / 2) {
+        const auto vGain = V::add(vStartGain,
+                V::mul(vGainDelta,
+                        V::add(V::set1(static_cast<CSAMPLE>(i)), vFrameOffsets)));
+        V::store(pBuffer + i * 2, V::mul(V::load(pBuffer + i * 2), vGain));
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pBuffer[i * 2] *= gain;
+        pBuffer[i * 2 + 1] *= gain;
+    }
+}
+
+template<typename V>
+void copyWithGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        CSAMPLE_GAIN gain,
+        SINT numSamples) {
+    const auto vGain = V::set1(gain);
+    SINT i = 0;
+    for (; i + V::kWidth <= numSamples; i += V::kWidth) {
+        V::store(pDest + i, V::mul(V::load(pSrc + i), vGain));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] = pSrc[i] * gain;
+    }
+}
+
+template<typename V>
+void copyWithRampingGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const auto vStartGain = V::set1(startGain);
+    const auto vGainDelta = V::set1(gainDelta);
+    const auto vFrameOffsets = V::frameOffsets();
+    SINT i = 0;
+    for (; i + V::kWidth / 2 <= numFrames; i += V::kWidth / 2) {
+        const auto vGain = V::add(vStartGain,
+                V::mul(vGainDelta,
+                        V::add(V::set1(static_cast<CSAMPLE>(i)), vFrameOffsets)));
+        V::store(pDest + i * 2, V::mul(V::load(pSrc + i * 2), vGain));
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+template<typename V>
+void addWithGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        CSAMPLE_GAIN gain,
+        SINT numSamples) {
+    const auto vGain = V::set1(gain);
+    SINT i = 0;
+    for (; i + V::kWidth <= numSamples; i += V::kWidth) {
+        V::store(pDest + i,
+                V::add(V::load(pDest + i), V::mul(V::load(pSrc + i), vGain)));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] += pSrc[i] * gain;
+    }
+}
+
+template<typename V>
+void addWithRampingGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        CSAMPLE_GAIN startGain,
+        CSAMPLE_GAIN gainDelta,
+        SINT numFrames) {
+    const auto vStartGain = V::set1(startGain);
+    const auto vGainDelta = V::set1(gainDelta);
+    const auto vFrameOffsets = V::frameOffsets();
+    SINT i = 0;
+    for (; i + V::kWidth / 2 <= numFrames; i += V::kWidth / 2) {
+        const auto vGain = V::add(vStartGain,
+                V::mul(vGainDelta,
+                        V::add(V::set1(static_cast<CSAMPLE>(i)), vFrameOffsets)));
+        V::store(pDest + i * 2,
+                V::add(V::load(pDest + i * 2),
+                        V::mul(V::load(pSrc + i * 2), vGain)));
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE_GAIN gain = startGain + gainDelta * i;
+        pDest[i * 2] += pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] += pSrc[i * 2 + 1] * gain;
+    }
+}
+
+template<typename V>
+void add2WithGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc1,
+        CSAMPLE_GAIN gain1,
+        const CSAMPLE* pSrc2,
+        CSAMPLE_GAIN gain2,
+        SINT numSamples) {
+    const auto vGain1 = V::set1(gain1);
+    const auto vGain2 = V::set1(gain2);
+    SINT i = 0;
+    for (; i + V::kWidth <= numSamples; i += V::kWidth) {
+        const auto vSum = V::add(V::mul(V::load(pSrc1 + i), vGain1),
+                V::mul(V::load(pSrc2 + i), vGain2));
+        V::store(pDest + i, V::add(V::load(pDest + i), vSum));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2;
+    }
+}
+
+template<typename V>
+void add3WithGain(CSAMPLE* pDest,
+        const CSAMPLE* pSrc1,
+        CSAMPLE_GAIN gain1,
+        const CSAMPLE* pSrc2,
+        CSAMPLE_GAIN gain2,
+        const CSAMPLE* pSrc3,
+        CSAMPLE_GAIN gain3,
+        SINT numSamples) {
+    const auto vGain1 = V::set1(gain1);
+    const auto vGain2 = V::set1(gain2);
+    const auto vGain3 = V::set1(gain3);
+    SINT i = 0;
+    for (; i + V::kWidth <= numSamples; i += V::kWidth) {
+        const auto vSum = V::add(V::add(V::mul(V::load(pSrc1 + i), vGain1),
+                                         V::mul(V::load(pSrc2 + i), vGain2)),
+                V::mul(V::load(pSrc3 + i), vGain3));
+        V::store(pDest + i, V::add(V::load(pDest + i), vSum));
+    }
+    for (; i < numSamples; ++i) {
+        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2 + pSrc3[i] * gain3;
+    }
+}
+
+template<typename V>
+void sumAbsPerChannel(CSAMPLE* pSumAbsL,
+        CSAMPLE* pSumAbsR,
+        bool* pClippingL,
+        bool* pClippingR,
+        const CSAMPLE* pBuffer,
+        SINT numFrames) {
+    // The lanes alternate between the left and right channel,
+    // because kWidth is even.
+    auto vSumAbs = V::zero();
+    auto vMaxAbs = V::zero();
+    SINT i = 0;
+    for (; i + V::kWidth / 2 <= numFrames; i += V::kWidth / 2) {
+        const auto vAbs = V::abs(V::load(pBuffer + i * 2));
+        vSumAbs = V::add(vSumAbs, vAbs);
+        vMaxAbs = V::max(vMaxAbs, vAbs);
+    }
+    alignas(64) CSAMPLE sumAbs[V::kWidth];
+    alignas(64) CSAMPLE maxAbs[V::kWidth];
+    V::store(sumAbs, vSumAbs);
+    V::store(maxAbs, vMaxAbs);
+    CSAMPLE sumAbsL = CSAMPLE_ZERO;
+    CSAMPLE sumAbsR = CSAMPLE_ZERO;
+    CSAMPLE maxAbsL = CSAMPLE_ZERO;
+    CSAMPLE maxAbsR = CSAMPLE_ZERO;
+    for (SINT lane = 0; lane < V::kWidth; lane += 2) {
+        sumAbsL += sumAbs[lane];
+        sumAbsR += sumAbs[lane + 1];
+        maxAbsL = maxAbs[lane] > maxAbsL ? maxAbs[lane] : maxAbsL;
+        maxAbsR = maxAbs[lane + 1] > maxAbsR ? maxAbs[lane + 1] : maxAbsR;
+    }
+    for (; i < numFrames; ++i) {
+        const CSAMPLE absL = pBuffer[i * 2] < 0 ? -pBuffer[i * 2] : pBuffer[i * 2];
+        const CSAMPLE absR = pBuffer[i * 2 + 1] < 0 ? -pBuffer[i * 2 + 1] : pBuffer[i * 2 + 1];
+        sumAbsL += absL;
+        sumAbsR += absR;
+        maxAbsL = absL > maxAbsL ? absL : maxAbsL;
+        maxAbsR = absR > maxAbsR ? absR : maxAbsR;
+    }
+    *pSumAbsL = sumAbsL;
+    *pSumAbsR = sumAbsR;
+    *pClippingL = maxAbsL > CSAMPLE_PEAK;
+    *pClippingR = maxAbsR > CSAMPLE_PEAK;
+}
+
+template<typename V>
+void interleaveStereo(CSAMPLE* pDest,
+        const CSAMPLE* pSrc1,
+        const CSAMPLE* pSrc2,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + V::kWidth <= numFrames; i += V::kWidth) {
+        typename V::Reg lo;
+        typename V::Reg hi;
+        V::interleave(V::load(pSrc1 + i), V::load(pSrc2 + i), &lo, &hi);
+        V::store(pDest + i * 2, lo);
+        V::store(pDest + i * 2 + V::kWidth, hi);
+    }
+    for (; i < numFrames; ++i) {
+        pDest[i * 2] = pSrc1[i];
+        pDest[i * 2 + 1] = pSrc2[i];
+    }
+}
+
+template<typename V>
+void deinterleaveStereo(CSAMPLE* pDest1,
+        CSAMPLE* pDest2,
+        const CSAMPLE* pSrc,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + V::kWidth <= numFrames; i += V::kWidth) {
+        typename V::Reg a;
+        typename V::Reg b;
+        V::deinterleave(V::load(pSrc + i * 2), V::load(pSrc + i * 2 + V::kWidth), &a, &b);
+        V::store(pDest1 + i, a);
+        V::store(pDest2 + i, b);
+    }
+    for (; i < numFrames; ++i) {
+        pDest1[i] = pSrc[i * 2];
+        pDest2[i] = pSrc[i * 2 + 1];
+    }
+}
+
+template<typename V>
+void mixStemsToStereo(CSAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        SINT numFrames) {
+    SINT i = 0;
+    for (; i + V::kWidth / 2 <= numFrames; i += V::kWidth / 2) {
+        V::store(pDest + i * 2, V::mixStemFrames(pSrc + i * 8));
+    }
+    for (; i < numFrames; ++i) {
+        pDest[i * 2] = pSrc[i * 8] + pSrc[i * 8 + 2] +
+                pSrc[i * 8 + 4] + pSrc[i * 8 + 6];
+        pDest[i * 2 + 1] = pSrc[i * 8 + 1] + pSrc[i * 8 + 3] +
+                pSrc[i * 8 + 5] + pSrc[i * 8 + 7];
+    }
+}
+
+template<typename V>
+constexpr SampleKernels makeKernels(SimdLevel level) {
+    return SampleKernels{
+            level,
+            &applyGain<V>,
+            &applyRampingGain<V>,
+            &copyWithGain<V>,
+            &copyWithRampingGain<V>,
+            &addWithGain<V>,
+            &addWithRampingGain<V>,
+            &add2WithGain<V>,
+            &add3WithGain<V>,
+            &sumAbsPerChannel<V>,
+            &interleaveStereo<V>,
+            &deinterleaveStereo<V>,
+            &mixStemsToStereo<V>,
+    };
+}
+
+} // namespace impl
+
+} // namespace samplekernels
+
+} // namespace mixxx
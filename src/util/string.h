@@ -29,6 +29,11 @@ class StringCollator {
         return m_collator.compare(s1, s2);
     }
 
+    /// Sort keys are faster to compare when sorting many strings
+    QCollatorSortKey sortKey(const QString& s) const {
+        return m_collator.sortKey(s);
+    }
+
   private:
     QCollator m_collator;
 };
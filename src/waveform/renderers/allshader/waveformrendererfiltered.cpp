@@ -157,13 +157,11 @@ bool WaveformRendererFiltered::preprocessInner() {
         float max[3][2]{};
         uchar u8max[3][2]{};
         for (int chn = 0; chn < 2; chn++) {
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8max[0][chn] = math_max(u8max[0][chn], waveformData.filtered.low);
-                u8max[1][chn] = math_max(u8max[1][chn], waveformData.filtered.mid);
-                u8max[2][chn] = math_max(u8max[2][chn], waveformData.filtered.high);
-            }
+            const WaveformData waveformData =
+                    waveform->getMax(visualIndexStart, visualIndexStop, chn);
+            u8max[0][chn] = waveformData.filtered.low;
+            u8max[1][chn] = waveformData.filtered.mid;
+            u8max[2][chn] = waveformData.filtered.high;
             // Cast to float
             max[0][chn] = static_cast<float>(u8max[0][chn]);
             max[1][chn] = static_cast<float>(u8max[1][chn]);
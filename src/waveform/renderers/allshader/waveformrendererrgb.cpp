@@ -158,16 +158,14 @@ bool WaveformRendererRGB::preprocessInner() {
             // In case we don't render individual color per channel, we use only
             // the first field of the arrays to perform signal max
             int signalChn = splitLeftRight ? chn : 0;
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxLow[signalChn] = math_max(u8maxLow[signalChn], waveformData.filtered.low);
-                u8maxMid[signalChn] = math_max(u8maxMid[signalChn], waveformData.filtered.mid);
-                u8maxHigh[signalChn] = math_max(u8maxHigh[signalChn], waveformData.filtered.high);
-                u8maxAllChn[signalChn] = math_max(
-                        u8maxAllChn[signalChn], waveformData.filtered.all);
-            }
+            const WaveformData waveformData =
+                    waveform->getMax(visualIndexStart, visualIndexStop, chn);
+
+            u8maxLow[signalChn] = math_max(u8maxLow[signalChn], waveformData.filtered.low);
+            u8maxMid[signalChn] = math_max(u8maxMid[signalChn], waveformData.filtered.mid);
+            u8maxHigh[signalChn] = math_max(u8maxHigh[signalChn], waveformData.filtered.high);
+            u8maxAllChn[signalChn] = math_max(
+                    u8maxAllChn[signalChn], waveformData.filtered.all);
         }
         float maxAllChn[2]{static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
 
@@ -130,12 +130,9 @@ bool WaveformRendererSimple::preprocessInner() {
         // - Per channel
         uchar u8maxAllChn[2]{};
         for (int chn = 0; chn < 2; chn++) {
-            // data is interleaved left / right
-            for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                const WaveformData& waveformData = data[i];
-
-                u8maxAllChn[chn] = math_max(u8maxAllChn[chn], waveformData.filtered.all);
-            }
+            u8maxAllChn[chn] =
+                    waveform->getMax(visualIndexStart, visualIndexStop, chn)
+                            .filtered.all;
         }
         float maxAllChn[2]{static_cast<float>(u8maxAllChn[0]), static_cast<float>(u8maxAllChn[1])};
 
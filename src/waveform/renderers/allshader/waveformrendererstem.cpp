@@ -215,12 +215,9 @@ bool WaveformRendererStem::preprocessInner() {
                 // - Max of left and right
                 uchar u8max{};
                 for (int chn = 0; chn < 2; chn++) {
-                    // data is interleaved left / right
-                    for (int i = visualIndexStart + chn; i < visualIndexStop + chn; i += 2) {
-                        const WaveformData& waveformData = data[i];
-
-                        u8max = math_max(u8max, waveformData.stems[stemIdx]);
-                    }
+                    u8max = math_max(u8max,
+                            waveform->getMax(visualIndexStart, visualIndexStop, chn)
+                                    .stems[stemIdx]);
                 }
 
                 // Cast to float
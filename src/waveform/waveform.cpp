@@ -1,13 +1,53 @@
 #include "waveform/waveform.h"
 
 #include <QtDebug>
+#include <cstring>
+#include <type_traits>
 
 #include "analyzer/constants.h"
 #include "engine/engine.h"
 #include "proto/waveform.pb.h"
+#include "util/assert.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
+namespace {
+
+inline void storeMax(WaveformData* pMax, const WaveformData& data) {
+    pMax->filtered.low = math_max(pMax->filtered.low, data.filtered.low);
+    pMax->filtered.mid = math_max(pMax->filtered.mid, data.filtered.mid);
+    pMax->filtered.high = math_max(pMax->filtered.high, data.filtered.high);
+    pMax->filtered.all = math_max(pMax->filtered.all, data.filtered.all);
+    for (int i = 0; i < mixxx::kMaxSupportedStems; ++i) {
+        pMax->stems[i] = math_max(pMax->stems[i], data.stems[i]);
+    }
+}
+
+/// The header of the raw format. The fields are stored in native byte order,
+/// a file from a machine with a different byte order is rejected due to the
+/// mismatching version.
+struct RawWaveformHeader {
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    quint32 dataElementSize;
+    quint32 dataSize;
+    qint32 stemCount;
+    quint32 reserved;
+    double visualSampleRate;
+    double audioVisualRatio;
+};
+static_assert(sizeof(RawWaveformHeader) == 48);
+static_assert(std::is_trivially_copyable_v<WaveformData>);
+
+constexpr char kRawWaveformMagic[sizeof(RawWaveformHeader::magic)] =
+        {'M', 'X', 'W', 'A', 'V', 'E', 'R', 'W'};
+// Must be increased whenever the layout of WaveformData changes
+constexpr quint32 kRawWaveformVersion = 1;
+
+} // anonymous namespace
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -18,15 +58,24 @@ int computeTextureStride(int size) {
     return stride;
 }
 
-Waveform::Waveform(const QByteArray& data)
+Waveform::Waveform(const QByteArray& data, ByteArrayFormat format)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
-          m_completion(-1) {
-    readByteArray(data);
+          m_completion(-1),
+          m_stemCount(0),
+          m_decimatedLevelsReady(0) {
+    switch (format) {
+    case ByteArrayFormat::Protobuf:
+        readByteArray(data);
+        break;
+    case ByteArrayFormat::Raw:
+        readRawByteArray(data);
+        break;
+    }
 }
 
 Waveform::Waveform(
@@ -42,7 +91,8 @@ Waveform::Waveform(
           m_audioVisualRatio(0),
           m_textureStride(1024),
           m_completion(-1),
-          m_stemCount(stemCount) {
+          m_stemCount(stemCount),
+          m_decimatedLevelsReady(0) {
     int numberOfVisualSamples = 0;
     if (audioSampleRate > 0) {
         if (maxVisualSamples == -1) {
@@ -151,6 +201,68 @@ QByteArray Waveform::toByteArray() const {
     return QByteArray(output.data(), static_cast<int>(output.length()));
 }
 
+QByteArray Waveform::toRawByteArray() const {
+    RawWaveformHeader header{};
+    std::memcpy(header.magic, kRawWaveformMagic, sizeof(header.magic));
+    header.version = kRawWaveformVersion;
+    header.headerSize = sizeof(RawWaveformHeader);
+    header.dataElementSize = sizeof(WaveformData);
+    header.dataSize = getDataSize();
+    header.stemCount = m_stemCount;
+    header.visualSampleRate = m_visualSampleRate;
+    header.audioVisualRatio = m_audioVisualRatio;
+
+    const int dataBytes = getDataSize() * static_cast<int>(sizeof(WaveformData));
+    QByteArray output(static_cast<int>(sizeof(RawWaveformHeader)) + dataBytes,
+            Qt::Uninitialized);
+    std::memcpy(output.data(), &header, sizeof(RawWaveformHeader));
+    std::memcpy(output.data() + sizeof(RawWaveformHeader), m_data.data(), dataBytes);
+    return output;
+}
+
+void Waveform::readRawByteArray(const QByteArray& data) {
+    if (data.isNull()) {
+        return;
+    }
+
+    RawWaveformHeader header;
+    if (data.size() < static_cast<int>(sizeof(RawWaveformHeader))) {
+        qDebug() << "ERROR: Raw waveform is too short:" << data.size();
+        return;
+    }
+    std::memcpy(&header, data.constData(), sizeof(RawWaveformHeader));
+    if (std::memcmp(header.magic, kRawWaveformMagic, sizeof(header.magic)) != 0 ||
+            header.version != kRawWaveformVersion ||
+            header.headerSize != sizeof(RawWaveformHeader) ||
+            header.dataElementSize != sizeof(WaveformData)) {
+        qDebug() << "ERROR: Unsupported raw waveform version" << header.version;
+        return;
+    }
+    const qint64 expectedSize = static_cast<qint64>(header.headerSize) +
+            static_cast<qint64>(header.dataSize) * header.dataElementSize;
+    if (data.size() != expectedSize ||
+            header.stemCount < 0 ||
+            header.stemCount > mixxx::kMaxSupportedStems) {
+        qDebug() << "ERROR: Raw waveform is corrupt:"
+                 << "size" << data.size()
+                 << "dataSize" << header.dataSize
+                 << "stemCount" << header.stemCount;
+        return;
+    }
+
+    const int dataSize = static_cast<int>(header.dataSize);
+    resize(dataSize);
+    std::memcpy(m_data.data(),
+            data.constData() + header.headerSize,
+            dataSize * sizeof(WaveformData));
+    m_visualSampleRate = header.visualSampleRate;
+    m_audioVisualRatio = header.audioVisualRatio;
+    m_stemCount = header.stemCount;
+    m_completion = dataSize;
+    m_saveState = SaveState::Saved;
+    buildDecimatedLevels();
+}
+
 void Waveform::readByteArray(const QByteArray& data) {
     if (data.isNull()) {
         return;
@@ -236,6 +348,62 @@ void Waveform::readByteArray(const QByteArray& data) {
 
     m_completion = dataSize;
     m_saveState = SaveState::Saved;
+    buildDecimatedLevels();
+}
+
+void Waveform::buildDecimatedLevels() {
+    VERIFY_OR_DEBUG_ASSERT(!m_decimatedLevelsReady.loadAcquire()) {
+        return;
+    }
+    const WaveformData* pLevel = m_data.data();
+    int levelFrames = m_dataSize / ChannelCount;
+    while (levelFrames > 1) {
+        const int nextLevelFrames = (levelFrames + 1) / 2;
+        std::vector<WaveformData> nextLevel(nextLevelFrames * ChannelCount);
+        for (int frame = 0; frame < levelFrames; ++frame) {
+            for (int chn = 0; chn < ChannelCount; ++chn) {
+                storeMax(&nextLevel[(frame / 2) * ChannelCount + chn],
+                        pLevel[frame * ChannelCount + chn]);
+            }
+        }
+        m_decimatedLevels.push_back(std::move(nextLevel));
+        pLevel = m_decimatedLevels.back().data();
+        levelFrames = nextLevelFrames;
+    }
+    m_decimatedLevelsReady.storeRelease(1);
+}
+
+WaveformData Waveform::getMax(int visualIndexStart, int visualIndexStop, int channel) const {
+    WaveformData max{};
+    // The frames of the index range, see the loop in the header
+    int frameStart = std::max(visualIndexStart, 0) / ChannelCount;
+    int frameStop = std::min((visualIndexStop + 1) / ChannelCount,
+            m_dataSize / ChannelCount);
+    const WaveformData* pLevel = m_data.data();
+    if (m_decimatedLevelsReady.loadAcquire()) {
+        // Merge the unaligned frames at the borders and continue with the
+        // remaining range at the next level.
+        for (const auto& nextLevel : m_decimatedLevels) {
+            if (frameStart >= frameStop) {
+                break;
+            }
+            if (frameStart % 2 != 0) {
+                storeMax(&max, pLevel[frameStart * ChannelCount + channel]);
+                ++frameStart;
+            }
+            if (frameStop % 2 != 0) {
+                --frameStop;
+                storeMax(&max, pLevel[frameStop * ChannelCount + channel]);
+            }
+            frameStart /= 2;
+            frameStop /= 2;
+            pLevel = nextLevel.data();
+        }
+    }
+    for (int frame = frameStart; frame < frameStop; ++frame) {
+        storeMax(&max, pLevel[frame * ChannelCount + channel]);
+    }
+    return max;
 }
 
 void Waveform::resize(int size) {
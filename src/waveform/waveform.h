@@ -39,7 +39,17 @@ class Waveform {
         Saved
     };
 
-    explicit Waveform(const QByteArray& pData = QByteArray());
+    /// The formats of serialized waveforms
+    enum class ByteArrayFormat {
+        /// Protocol buffer defined in proto/waveform.proto
+        Protobuf,
+        /// A versioned header followed by the data laid out exactly like
+        /// WaveformData in memory, which can be read without decoding.
+        Raw,
+    };
+
+    explicit Waveform(const QByteArray& pData = QByteArray(),
+            ByteArrayFormat format = ByteArrayFormat::Protobuf);
     Waveform(
             int audioSampleRate,
             SINT frameLength,
@@ -80,6 +90,7 @@ class Waveform {
     }
 
     QByteArray toByteArray() const;
+    QByteArray toRawByteArray() const;
 
     SaveState saveState() const {
         return m_saveState;
@@ -137,10 +148,24 @@ class Waveform {
         return m_stemCount > 0;
     }
 
+    /// Builds the levels of 2x decimated maxima of the complete waveform
+    /// data. Must only be invoked once when the waveform is complete and
+    /// before the data is modified ever again.
+    void buildDecimatedLevels();
+
+    /// Returns the maxima of all fields for the given channel over the same
+    /// range of the interleaved data as the loop
+    /// `for (int i = visualIndexStart + channel; i < visualIndexStop + channel; i += 2)`.
+    ///
+    /// Uses the decimated levels if available, which bounds the costs by the
+    /// logarithm of the range size. Otherwise all samples are scanned.
+    WaveformData getMax(int visualIndexStart, int visualIndexStop, int channel) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readRawByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size);
 
@@ -185,6 +210,12 @@ class Waveform {
     // The number of stem contained in waveform samples. 0 if not a stem waveform
     int m_stemCount;
 
+    // Level n contains the maxima of 2^n subsequent visual frames of m_data,
+    // interleaved left / right like m_data. Level 0 is m_data and not
+    // included. Not allowed to change after m_decimatedLevelsReady is set.
+    std::vector<std::vector<WaveformData>> m_decimatedLevels;
+    QAtomicInt m_decimatedLevelsReady;
+
     mutable QMutex m_mutex;
 
     DISALLOW_COPY_AND_ASSIGN(Waveform);
@@ -1,10 +1,18 @@
 #include "waveform/waveformfactory.h"
+
+#include <QFile>
+
 #include "waveform/waveform.h"
 
 // static
 Waveform* WaveformFactory::loadWaveformFromAnalysis(
         const AnalysisDao::AnalysisInfo& analysis) {
-    Waveform* pWaveform = new Waveform(analysis.data);
+    // The waveform copies the data before the file is closed again
+    QFile file;
+    Waveform* pWaveform = new Waveform(AnalysisDao::readData(analysis, &file),
+            analysis.dataFormat == AnalysisDao::DataFormat::Raw
+                    ? Waveform::ByteArrayFormat::Raw
+                    : Waveform::ByteArrayFormat::Protobuf);
     pWaveform->setId(analysis.analysisId);
     pWaveform->setVersion(analysis.version);
     pWaveform->setDescription(analysis.description);
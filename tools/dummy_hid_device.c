@@ -1,4 +1,4 @@
-#define _DEFAULT_SOURCE
+#define _GNU_SOURCE
 
 #include <errno.h>
 #include <fcntl.h>
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <time.h>
 #include <unistd.h>
 
 #ifndef VENDOR_ID
@@ -21,6 +22,10 @@
 #define DEVICE_NAME "test-uhid-device"
 #endif
 
+/* Report ID + 136 + 16 + 24 bits of the input report in rdesc */
+#define INPUT_REPORT_SIZE 23
+#define NANOS_PER_SECOND 1000000000L
+
 static volatile u_int32_t done;
 
 static unsigned char rdesc[] = {
@@ -161,6 +166,35 @@ static void handle_report(struct uhid_event* ev, int fd) {
     return;
 }
 
+/* Every input report differs from the previous one, so that Mixxx can't skip
+ * them as duplicates */
+static int send_input_report(int fd, unsigned long long counter) {
+    struct uhid_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.type = UHID_INPUT2;
+    ev.u.input2.size = INPUT_REPORT_SIZE;
+    ev.u.input2.data[0] = 1; /* Report ID */
+    memcpy(&ev.u.input2.data[1], &counter, sizeof(counter));
+
+    return uhid_write(fd, &ev);
+}
+
+static void add_nanos(struct timespec* ts, long nanos) {
+    ts->tv_nsec += nanos;
+    while (ts->tv_nsec >= NANOS_PER_SECOND) {
+        ts->tv_nsec -= NANOS_PER_SECOND;
+        ts->tv_sec++;
+    }
+}
+
+static long nanos_until(const struct timespec* deadline) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (deadline->tv_sec - now.tv_sec) * NANOS_PER_SECOND +
+            (deadline->tv_nsec - now.tv_nsec);
+}
+
 static int event(int fd) {
     struct uhid_event ev;
     ssize_t ret;
@@ -209,6 +243,18 @@ static int event(int fd) {
 }
 
 int main(int argc, char** argv) {
+    /* Optionally send input reports at a fixed rate, like the jog wheels of a
+     * DJ controller do, to benchmark the HID input path of Mixxx. Run multiple
+     * instances with different PRODUCT_IDs to simulate multiple controllers. */
+    long rate = 0;
+    if (argc > 1) {
+        rate = strtol(argv[1], NULL, 10);
+        if (rate <= 0 || rate > 100000) {
+            fprintf(stderr, "Usage: %s [input reports per second]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
     signal(SIGINT, sighndlr);
 
     // UHID
@@ -228,8 +274,36 @@ int main(int argc, char** argv) {
     pfds.fd = fd;
     pfds.events = POLLIN;
 
+    struct timespec next_report;
+    clock_gettime(CLOCK_MONOTONIC, &next_report);
+    struct timespec next_stats = next_report;
+    next_stats.tv_sec++;
+    unsigned long long counter = 0;
+    unsigned long long last_counter = 0;
+
     while (!done) {
-        int ret = poll(&pfds, 1, 10);
+        struct timespec timeout = {0, 10000000L};
+        if (rate > 0) {
+            long nanos = nanos_until(&next_report);
+            if (nanos <= 0) {
+                if (send_input_report(fd, counter)) {
+                    break;
+                }
+                counter++;
+                add_nanos(&next_report, NANOS_PER_SECOND / rate);
+                if (nanos_until(&next_stats) <= 0) {
+                    fprintf(stderr, "Sent %llu input reports/s\n", counter - last_counter);
+                    last_counter = counter;
+                    next_stats.tv_sec++;
+                }
+                /* Only handle pending uhid events before the next report */
+                nanos = 0;
+            }
+            if (nanos < timeout.tv_nsec) {
+                timeout.tv_nsec = nanos;
+            }
+        }
+        int ret = ppoll(&pfds, 1, &timeout, NULL);
         if (ret < 0) {
             fprintf(stderr, "Cannot poll for fds: %m\n");
             break;